@@ -0,0 +1,59 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/affine.h"
+
+#include <vector>
+
+#include "glm_plus/matrix.h"
+
+#include "benchmark/benchmark.h"
+#include "inputs.h"
+
+namespace glmp = glm_plus;
+
+static void transform_mat3(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 1);
+	const auto& p = in.points[0];
+	glm::fmat3 mat = glmp::screen_project_mat(glm::fvec2(1920.0f, 1080.0f)) * glmp::scale_move_mat(glm::fvec2(2.0f, 3.0f), glm::fvec2(5.0f, 7.0f));
+	std::vector<glm::fvec2> result(p.size());
+	for (auto _ : state) {
+		for (std::size_t i = 0; i < p.size(); ++i) {
+			glm::fvec3 r = mat * glm::fvec3(p[i].x, p[i].y, 1.0f);
+			result[i] = glm::fvec2(r.x, r.y);
+		}
+		benchmark::DoNotOptimize(result.data());
+		benchmark::ClobberMemory();
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(transform_mat3);
+
+static void transform_affine_scale_move(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 1);
+	const auto& p = in.points[0];
+	glmp::affine2 t = glmp::affine2(glmp::screen_project_mat(glm::fvec2(1920.0f, 1080.0f))) * glmp::affine2(glmp::scale_move_mat(glm::fvec2(2.0f, 3.0f), glm::fvec2(5.0f, 7.0f)));
+	std::vector<glm::fvec2> result(p.size());
+	for (auto _ : state) {
+		glmp::transform(t, p.data(), p.size(), result.data());
+		benchmark::DoNotOptimize(result.data());
+		benchmark::ClobberMemory();
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(transform_affine_scale_move);
+
+static void transform_affine_general(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 1);
+	const auto& p = in.points[0];
+	glmp::affine2 t({0.8f, 0.6f}, {-0.6f, 0.8f}, {5.0f, 7.0f});
+	std::vector<glm::fvec2> result(p.size());
+	for (auto _ : state) {
+		glmp::transform(t, p.data(), p.size(), result.data());
+		benchmark::DoNotOptimize(result.data());
+		benchmark::ClobberMemory();
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(transform_affine_general);
@@ -0,0 +1,40 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/clip.h"
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "inputs.h"
+
+namespace glmp = glm_plus;
+
+// Input points are clipped as a single, self-intersecting polygon, which crosses the clipping region many times.
+
+static void clip_rectangle(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 1);
+	glmp::farea bounds(glmp::fpos(-50.0f, -50.0f), glmp::fpos(50.0f, 50.0f));
+	glmp::clip_workspace workspace;
+	std::vector<glm::fvec2> result;
+	for (auto _ : state) {
+		glmp::clip(in.points[0].data(), in.points[0].size(), bounds, &result, &workspace);
+		benchmark::DoNotOptimize(result.data());
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(clip_rectangle);
+
+static void clip_convex(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 1);
+	std::vector<glm::fvec2> octagon = {{-50, -20}, {-20, -50}, {20, -50}, {50, -20}, {50, 20}, {20, 50}, {-20, 50}, {-50, 20}};
+	glmp::clip_workspace workspace;
+	std::vector<glm::fvec2> result;
+	for (auto _ : state) {
+		glmp::clip_convex(in.points[0].data(), in.points[0].size(), octagon.data(), octagon.size(), &result, &workspace);
+		benchmark::DoNotOptimize(result.data());
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(clip_convex);
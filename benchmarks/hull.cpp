@@ -0,0 +1,45 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/hull.h"
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "inputs.h"
+
+namespace glmp = glm_plus;
+
+static void convex_hull(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 1);
+	std::vector<glm::fvec2> hull;
+	for (auto _ : state) {
+		glmp::convex_hull(in.points[0].data(), in.points[0].size(), &hull);
+		benchmark::DoNotOptimize(hull.data());
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(convex_hull);
+
+static void convex_hull_parallel(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 1);
+	std::vector<glm::fvec2> hull;
+	for (auto _ : state) {
+		glmp::convex_hull(glmp::executor::get_default(), in.points[0].data(), in.points[0].size(), &hull);
+		benchmark::DoNotOptimize(hull.data());
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(convex_hull_parallel)->UseRealTime();
+
+static void incremental_hull(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 1);
+	for (auto _ : state) {
+		glmp::incremental_hull hull;
+		hull.insert(in.points[0].data(), in.points[0].size());
+		benchmark::DoNotOptimize(hull.get_vertices().data());
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(incremental_hull);
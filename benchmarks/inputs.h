@@ -0,0 +1,102 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "glm/glm.hpp"
+
+namespace bench {
+
+/**
+ * Kind of generated benchmark input.
+ */
+enum input_kind {
+	/** Uniformly distributed points, small enough to stay in cache. */
+	random_input = 0,
+	/** Collinear and repeated points, which hit edge cases like zero-length and parallel lines. */
+	degenerate_input = 1,
+	/** Uniformly distributed points, much larger than the cache and visited in random order. */
+	cold_input = 2
+};
+
+/**
+ * Benchmark input: @c arity arrays of points, visited in @c order.
+ * Element @c i of each array together forms the arguments of a single call.
+ */
+struct inputs {
+	std::vector<std::vector<glm::fvec2>> points;
+	std::vector<float> scalars;
+	std::vector<std::uint32_t> order;
+};
+
+inline inputs make_inputs(input_kind kind, std::size_t arity) {
+	std::size_t count = kind == cold_input ? (std::size_t(1) << 21) : 4096;
+	std::mt19937 rng(static_cast<std::uint32_t>(kind * 31 + arity));
+	std::uniform_real_distribution<float> coord(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> scalar(0.0f, 10.0f);
+	std::uniform_int_distribution<int> grid(-2, 2);
+
+	inputs in;
+	in.points.resize(arity);
+	for (std::vector<glm::fvec2>& p : in.points) {
+		p.resize(count);
+		for (glm::fvec2& v : p) {
+			if (kind == degenerate_input) {
+				float t = static_cast<float>(grid(rng));
+				v = glm::fvec2(t, t * 0.5f);
+			}
+			else {
+				v = glm::fvec2(coord(rng), coord(rng));
+			}
+		}
+	}
+	in.scalars.resize(count);
+	for (float& s : in.scalars)
+		s = kind == degenerate_input ? 0.0f : scalar(rng);
+
+	in.order.resize(count);
+	for (std::size_t i = 0; i < count; ++i)
+		in.order[i] = static_cast<std::uint32_t>(i);
+	if (kind == cold_input)
+		std::shuffle(in.order.begin(), in.order.end(), rng);
+	return in;
+}
+
+/**
+ * Returns cached inputs for the input kind selected by the first benchmark argument.
+ */
+inline const inputs& get_inputs(const benchmark::State& state, std::size_t arity) {
+	static std::map<std::pair<long, std::size_t>, inputs> cache;
+	auto kind = static_cast<input_kind>(state.range(0));
+	auto key = std::make_pair(static_cast<long>(kind), arity);
+	auto it = cache.find(key);
+	if (it == cache.end())
+		it = cache.emplace(key, make_inputs(kind, arity)).first;
+	return it->second;
+}
+
+/**
+ * Reports throughput (items/s) and time per call (time_per_op, in seconds).
+ */
+inline void set_counters(benchmark::State& state, const inputs& in) {
+	auto items = static_cast<std::int64_t>(in.order.size());
+	state.SetItemsProcessed(state.iterations() * items);
+	state.counters["time_per_op"] = benchmark::Counter(
+		static_cast<double>(items),
+		benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+}
+
+/** Registers a benchmark, which runs once for every input kind. */
+#define GLM_PLUS_BENCHMARK(fn) BENCHMARK(fn)->ArgName("input")->Arg(bench::random_input)->Arg(bench::degenerate_input)->Arg(bench::cold_input)
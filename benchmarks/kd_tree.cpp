@@ -0,0 +1,76 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/kd_tree.h"
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "inputs.h"
+
+namespace glmp = glm_plus;
+
+static void kd_tree_build(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 1);
+	glmp::kd_tree tree;
+	for (auto _ : state) {
+		tree.build(in.points[0].data(), in.points[0].size());
+		benchmark::DoNotOptimize(&tree);
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(kd_tree_build);
+
+static void kd_tree_build_parallel(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 1);
+	glmp::kd_tree tree;
+	for (auto _ : state) {
+		tree.build(glmp::executor::get_default(), in.points[0].data(), in.points[0].size());
+		benchmark::DoNotOptimize(&tree);
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(kd_tree_build_parallel);
+
+// Queries points of the second array in the tree of the first one.
+static void kd_tree_nearest(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 2);
+	glmp::kd_tree tree;
+	tree.build(in.points[0].data(), in.points[0].size());
+	std::vector<glmp::kd_neighbor> result(in.points[1].size());
+	for (auto _ : state) {
+		tree.nearest(in.points[1].data(), in.points[1].size(), result.data());
+		benchmark::DoNotOptimize(result.data());
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(kd_tree_nearest);
+
+static void kd_tree_k_nearest(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 2);
+	glmp::kd_tree tree;
+	tree.build(in.points[0].data(), in.points[0].size());
+	constexpr std::size_t k = 8;
+	std::vector<glmp::kd_neighbor> result(in.points[1].size() * k);
+	for (auto _ : state) {
+		tree.k_nearest(in.points[1].data(), in.points[1].size(), k, result.data());
+		benchmark::DoNotOptimize(result.data());
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(kd_tree_k_nearest);
+
+static void kd_tree_radius_search(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 2);
+	glmp::kd_tree tree;
+	tree.build(in.points[0].data(), in.points[0].size());
+	std::vector<std::uint32_t> offsets;
+	std::vector<std::uint32_t> found;
+	for (auto _ : state) {
+		tree.radius_search(in.points[1].data(), in.points[1].size(), 1.0f, &offsets, &found);
+		benchmark::DoNotOptimize(found.data());
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(kd_tree_radius_search);
@@ -0,0 +1,217 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/line.h"
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "inputs.h"
+
+namespace glmp = glm_plus;
+
+static void dist_to_line_signed(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 3);
+	const auto& p = in.points;
+	for (auto _ : state) {
+		for (std::uint32_t i : in.order)
+			benchmark::DoNotOptimize(glmp::dist_to_line_signed(p[0][i], p[1][i], p[2][i]));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(dist_to_line_signed);
+
+static void closest_point_on_line(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 3);
+	const auto& p = in.points;
+	for (auto _ : state) {
+		for (std::uint32_t i : in.order)
+			benchmark::DoNotOptimize(glmp::closest_point_on_line(p[0][i], p[1][i], p[2][i]));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(closest_point_on_line);
+
+namespace {
+
+std::vector<glmp::fline2> make_lines(const bench::inputs& in) {
+	std::vector<glmp::fline2> lines;
+	for (std::size_t i = 0; i < in.points[1].size(); ++i)
+		lines.emplace_back(in.points[1][i], in.points[2][i]);
+	return lines;
+}
+
+}
+
+// Same as dist_to_line_signed, with lines precomputed outside the loop.
+static void dist_to_line_signed_precomputed(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 3);
+	std::vector<glmp::fline2> lines = make_lines(in);
+	for (auto _ : state) {
+		for (std::uint32_t i : in.order)
+			benchmark::DoNotOptimize(glmp::dist_to_line_signed(in.points[0][i], lines[i]));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(dist_to_line_signed_precomputed);
+
+static void closest_point_on_line_precomputed(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 3);
+	std::vector<glmp::fline2> lines = make_lines(in);
+	for (auto _ : state) {
+		for (std::uint32_t i : in.order)
+			benchmark::DoNotOptimize(glmp::closest_point_on_line(in.points[0][i], lines[i]));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(closest_point_on_line_precomputed);
+
+static void is_between_two_points(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 3);
+	const auto& p = in.points;
+	for (auto _ : state) {
+		for (std::uint32_t i : in.order)
+			benchmark::DoNotOptimize(glmp::is_between_two_points(p[0][i], p[1][i], p[2][i]));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(is_between_two_points);
+
+static void is_right_of_line(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 3);
+	const auto& p = in.points;
+	for (auto _ : state) {
+		for (std::uint32_t i : in.order)
+			benchmark::DoNotOptimize(glmp::is_right_of_line(p[0][i], p[1][i], p[2][i]));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(is_right_of_line);
+
+static void is_right_of_line_with_margin(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 3);
+	const auto& p = in.points;
+	for (auto _ : state) {
+		for (std::uint32_t i : in.order)
+			benchmark::DoNotOptimize(glmp::is_right_of_line_with_margin(p[0][i], p[1][i], p[2][i]));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(is_right_of_line_with_margin);
+
+static void is_inside_section(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 4);
+	const auto& p = in.points;
+	for (auto _ : state) {
+		for (std::uint32_t i : in.order)
+			benchmark::DoNotOptimize(glmp::is_inside_section(p[0][i], p[1][i], p[2][i], p[3][i]));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(is_inside_section);
+
+static void is_inside_section_with_margin(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 4);
+	const auto& p = in.points;
+	for (auto _ : state) {
+		for (std::uint32_t i : in.order)
+			benchmark::DoNotOptimize(glmp::is_inside_section_with_margin(p[0][i], p[1][i], p[2][i], p[3][i]));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(is_inside_section_with_margin);
+
+static void lines_intersect(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 4);
+	const auto& p = in.points;
+	glm::fvec2 r;
+	for (auto _ : state) {
+		for (std::uint32_t i : in.order)
+			benchmark::DoNotOptimize(glmp::lines_intersect(p[0][i], p[1][i], p[2][i], p[3][i], &r));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(lines_intersect);
+
+static void line_segments_intersect(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 4);
+	const auto& p = in.points;
+	glm::fvec2 r;
+	for (auto _ : state) {
+		for (std::uint32_t i : in.order)
+			benchmark::DoNotOptimize(glmp::line_segments_intersect(p[0][i], p[1][i], p[2][i], p[3][i], &r));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(line_segments_intersect);
+
+static void line_segments_intersect_parametric(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 4);
+	const auto& p = in.points;
+	float t;
+	float u;
+	for (auto _ : state) {
+		for (std::uint32_t i : in.order)
+			benchmark::DoNotOptimize(glmp::line_segments_intersect_parametric(p[0][i], p[1][i], p[2][i], p[3][i], &t, &u));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(line_segments_intersect_parametric);
+
+static void horizontal_ray_line_segment_intersect(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 3);
+	const auto& p = in.points;
+	for (auto _ : state) {
+		for (std::uint32_t i : in.order)
+			benchmark::DoNotOptimize(glmp::horizontal_ray_line_segment_intersect(p[0][i], p[1][i], p[2][i]));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(horizontal_ray_line_segment_intersect);
+
+static void lines_coincide(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 4);
+	const auto& p = in.points;
+	for (auto _ : state) {
+		for (std::uint32_t i : in.order)
+			benchmark::DoNotOptimize(glmp::lines_coincide(p[0][i], p[1][i], p[2][i], p[3][i]));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(lines_coincide);
+
+static void line_segments_coincide(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 4);
+	const auto& p = in.points;
+	for (auto _ : state) {
+		for (std::uint32_t i : in.order)
+			benchmark::DoNotOptimize(glmp::line_segments_coincide(p[0][i], p[1][i], p[2][i], p[3][i]));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(line_segments_coincide);
+
+static void line_circle_intersect(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 3);
+	const auto& p = in.points;
+	glm::fvec2 r;
+	for (auto _ : state) {
+		for (std::uint32_t i : in.order)
+			benchmark::DoNotOptimize(glmp::line_circle_intersect(p[0][i], in.scalars[i], p[1][i], p[2][i], &r));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(line_circle_intersect);
+
+static void line_segment_circle_intersect(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 3);
+	const auto& p = in.points;
+	glm::fvec2 r;
+	for (auto _ : state) {
+		for (std::uint32_t i : in.order)
+			benchmark::DoNotOptimize(glmp::line_segment_circle_intersect(p[0][i], in.scalars[i], p[1][i], p[2][i], &r));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(line_segment_circle_intersect);
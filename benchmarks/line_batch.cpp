@@ -0,0 +1,222 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/line_batch.h"
+#include "glm_plus/line.h"
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "inputs.h"
+
+namespace glmp = glm_plus;
+
+namespace {
+
+struct segment_soa {
+	std::vector<float> x1s;
+	std::vector<float> y1s;
+	std::vector<float> x2s;
+	std::vector<float> y2s;
+};
+
+segment_soa make_segments(const bench::inputs& in) {
+	segment_soa s;
+	for (std::size_t i = 0; i < in.points[0].size(); ++i) {
+		s.x1s.push_back(in.points[0][i].x);
+		s.y1s.push_back(in.points[0][i].y);
+		s.x2s.push_back(in.points[1][i].x);
+		s.y2s.push_back(in.points[1][i].y);
+	}
+	return s;
+}
+
+}
+
+// Casts one ray against all segments with the scalar function, as a baseline for the batched version.
+static void line_segments_intersect_one_vs_many_scalar(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 2);
+	const auto& p = in.points;
+	glm::fvec2 a1(-100.0f, -30.0f);
+	glm::fvec2 a2(100.0f, 40.0f);
+	std::vector<std::uint32_t> hits(p[0].size());
+	std::vector<float> ts(p[0].size());
+	for (auto _ : state) {
+		std::size_t n = 0;
+		for (std::size_t i = 0; i < p[0].size(); ++i) {
+			float t;
+			float u;
+			if (glmp::line_segments_intersect_parametric(a1, a2, p[0][i], p[1][i], &t, &u)) {
+				hits[n] = static_cast<std::uint32_t>(i);
+				ts[n++] = t;
+			}
+		}
+		benchmark::DoNotOptimize(n);
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(line_segments_intersect_one_vs_many_scalar);
+
+static void line_segments_intersect_one_vs_many(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 2);
+	segment_soa s = make_segments(in);
+	glm::fvec2 a1(-100.0f, -30.0f);
+	glm::fvec2 a2(100.0f, 40.0f);
+	std::vector<std::uint32_t> hits(s.x1s.size());
+	std::vector<float> ts(s.x1s.size());
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(glmp::line_segments_intersect(a1, a2, s.x1s.data(), s.y1s.data(), s.x2s.data(), s.y2s.data(), s.x1s.size(), hits.data(), ts.data()));
+		benchmark::ClobberMemory();
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(line_segments_intersect_one_vs_many);
+
+// Tests one segment against all circles with the scalar function, as a baseline for the batched version.
+static void line_segment_circle_intersect_one_vs_many_scalar(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 1);
+	const auto& p = in.points[0];
+	glm::fvec2 a1(-100.0f, -30.0f);
+	glm::fvec2 a2(100.0f, 40.0f);
+	for (auto _ : state) {
+		bool found = false;
+		float best = 0.0f;
+		for (std::size_t i = 0; i < p.size(); ++i) {
+			glm::fvec2 hit;
+			if (glmp::line_segment_circle_intersect(p[i], in.scalars[i] * 0.1f, a1, a2, &hit)) {
+				float t = glm::length(hit - a1);
+				if (!found || t < best) {
+					found = true;
+					best = t;
+				}
+			}
+		}
+		benchmark::DoNotOptimize(best);
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(line_segment_circle_intersect_one_vs_many_scalar);
+
+static void line_segment_circle_intersect_one_vs_many(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 1);
+	std::vector<float> cxs;
+	std::vector<float> cys;
+	std::vector<float> rs;
+	for (std::size_t i = 0; i < in.points[0].size(); ++i) {
+		cxs.push_back(in.points[0][i].x);
+		cys.push_back(in.points[0][i].y);
+		rs.push_back(in.scalars[i] * 0.1f);
+	}
+	glm::fvec2 a1(-100.0f, -30.0f);
+	glm::fvec2 a2(100.0f, 40.0f);
+	for (auto _ : state) {
+		std::uint32_t index;
+		float t;
+		benchmark::DoNotOptimize(glmp::line_segment_circle_intersect(cxs.data(), cys.data(), rs.data(), cxs.size(), a1, a2, &index, &t));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(line_segment_circle_intersect_one_vs_many);
+
+namespace {
+
+// Short walls around the input points, so that only walls near the motion are hit.
+segment_soa make_walls(const bench::inputs& in) {
+	segment_soa s;
+	for (std::size_t i = 0; i < in.points[0].size(); ++i) {
+		glm::fvec2 p = in.points[0][i];
+		glm::fvec2 q = p + (in.points[1][i] - p) * 0.01f;
+		s.x1s.push_back(p.x);
+		s.y1s.push_back(p.y);
+		s.x2s.push_back(q.x);
+		s.y2s.push_back(q.y);
+	}
+	return s;
+}
+
+}
+
+// Sweeps one circle against all walls with the scalar function, as a baseline for the batched version.
+static void moving_circle_line_segment_impact_one_vs_many_scalar(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 2);
+	segment_soa s = make_walls(in);
+	glm::fvec2 center(-100.0f, -30.0f);
+	glm::fvec2 velocity(200.0f, 70.0f);
+	for (auto _ : state) {
+		bool found = false;
+		float best = 0.0f;
+		for (std::size_t i = 0; i < s.x1s.size(); ++i) {
+			float t;
+			glm::fvec2 n;
+			if (glmp::moving_circle_line_segment_impact(center, 0.5f, velocity, glm::fvec2(s.x1s[i], s.y1s[i]), glm::fvec2(s.x2s[i], s.y2s[i]), &t, &n)
+					&& (!found || t < best)) {
+				found = true;
+				best = t;
+			}
+		}
+		benchmark::DoNotOptimize(best);
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(moving_circle_line_segment_impact_one_vs_many_scalar);
+
+static void moving_circle_line_segment_impact_one_vs_many(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 2);
+	segment_soa s = make_walls(in);
+	glm::fvec2 center(-100.0f, -30.0f);
+	glm::fvec2 velocity(200.0f, 70.0f);
+	for (auto _ : state) {
+		std::uint32_t index;
+		float t;
+		glm::fvec2 n;
+		benchmark::DoNotOptimize(glmp::moving_circle_line_segment_impact(center, 0.5f, velocity, s.x1s.data(), s.y1s.data(), s.x2s.data(), s.y2s.data(),
+			s.x1s.size(), &index, &t, &n));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(moving_circle_line_segment_impact_one_vs_many);
+
+static void moving_circles_impact_one_vs_many(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 2);
+	std::vector<float> cxs;
+	std::vector<float> cys;
+	std::vector<float> rs;
+	std::vector<float> vxs;
+	std::vector<float> vys;
+	for (std::size_t i = 0; i < in.points[0].size(); ++i) {
+		cxs.push_back(in.points[0][i].x);
+		cys.push_back(in.points[0][i].y);
+		rs.push_back(in.scalars[i] * 0.1f);
+		vxs.push_back(in.points[1][i].x * 0.01f);
+		vys.push_back(in.points[1][i].y * 0.01f);
+	}
+	glm::fvec2 center(-100.0f, -30.0f);
+	glm::fvec2 velocity(200.0f, 70.0f);
+	for (auto _ : state) {
+		std::uint32_t index;
+		float t;
+		glm::fvec2 n;
+		benchmark::DoNotOptimize(glmp::moving_circles_impact(center, 0.5f, velocity, cxs.data(), cys.data(), rs.data(), vxs.data(), vys.data(),
+			cxs.size(), &index, &t, &n));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(moving_circles_impact_one_vs_many);
+
+static void moving_line_segment_impact_one_vs_many(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 2);
+	segment_soa s = make_walls(in);
+	glm::fvec2 a1(-100.0f, -30.0f);
+	glm::fvec2 a2(-99.0f, -31.0f);
+	glm::fvec2 velocity(200.0f, 70.0f);
+	for (auto _ : state) {
+		std::uint32_t index;
+		float t;
+		glm::fvec2 n;
+		benchmark::DoNotOptimize(glmp::moving_line_segment_impact(a1, a2, velocity, s.x1s.data(), s.y1s.data(), s.x2s.data(), s.y2s.data(),
+			s.x1s.size(), &index, &t, &n));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(moving_line_segment_impact_one_vs_many);
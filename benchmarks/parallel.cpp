@@ -0,0 +1,59 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/parallel.h"
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "inputs.h"
+
+namespace glmp = glm_plus;
+
+// Compare with line_segments_intersect_one_vs_many in line_batch.cpp for the single-threaded time.
+static void line_segments_intersect_one_vs_many_parallel(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 2);
+	std::vector<float> x1s;
+	std::vector<float> y1s;
+	std::vector<float> x2s;
+	std::vector<float> y2s;
+	for (std::size_t i = 0; i < in.points[0].size(); ++i) {
+		x1s.push_back(in.points[0][i].x);
+		y1s.push_back(in.points[0][i].y);
+		x2s.push_back(in.points[1][i].x);
+		y2s.push_back(in.points[1][i].y);
+	}
+	glm::fvec2 a1(-100.0f, -30.0f);
+	glm::fvec2 a2(100.0f, 40.0f);
+	std::vector<std::uint32_t> hits(x1s.size());
+	std::vector<float> ts(x1s.size());
+	glmp::executor& pool = glmp::executor::get_default();
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(glmp::line_segments_intersect(pool, a1, a2, x1s.data(), y1s.data(), x2s.data(), y2s.data(), x1s.size(), hits.data(), ts.data()));
+		benchmark::ClobberMemory();
+	}
+	bench::set_counters(state, in);
+	state.counters["threads"] = pool.get_thread_count();
+}
+GLM_PLUS_BENCHMARK(line_segments_intersect_one_vs_many_parallel);
+
+static void inside_rect_parallel(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 1);
+	std::vector<float> xs;
+	std::vector<float> ys;
+	for (glm::fvec2 p : in.points[0]) {
+		xs.push_back(p.x);
+		ys.push_back(p.y);
+	}
+	glmp::farea area(glmp::fpos(-50.0f, -50.0f), glmp::fpos(50.0f, 50.0f));
+	std::vector<std::uint32_t> mask(glmp::mask_words(xs.size()));
+	glmp::executor& pool = glmp::executor::get_default();
+	for (auto _ : state) {
+		glmp::inside_rect(pool, xs.data(), ys.data(), xs.size(), area, mask.data());
+		benchmark::ClobberMemory();
+	}
+	bench::set_counters(state, in);
+	state.counters["threads"] = pool.get_thread_count();
+}
+GLM_PLUS_BENCHMARK(inside_rect_parallel);
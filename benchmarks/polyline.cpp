@@ -0,0 +1,102 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/polyline.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "inputs.h"
+
+namespace glmp = glm_plus;
+
+namespace {
+
+// Random walk with steps taken from the input points, like a recorded track.
+// Linear searches are limited to 1024 vertices and 4096 query points, so that cold inputs finish in reasonable time.
+constexpr std::size_t linear_vertices = 1024;
+constexpr std::size_t linear_queries = 4096;
+
+std::vector<glm::fvec2> make_track(const std::vector<glm::fvec2>& steps, std::size_t count) {
+	std::vector<glm::fvec2> track(count);
+	glm::fvec2 p(0.0f);
+	for (std::size_t i = 0; i < count; ++i) {
+		p += steps[i] * 0.01f;
+		track[i] = p;
+	}
+	return track;
+}
+
+}
+
+// Queries points of the second array against a track built from the first one.
+static void closest_point_on_polyline(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 2);
+	std::vector<glm::fvec2> track = make_track(in.points[0], std::min(in.points[0].size(), linear_vertices));
+	std::size_t count = std::min(in.points[1].size(), linear_queries);
+	std::vector<glmp::segment_point> result(count);
+	for (auto _ : state) {
+		glmp::closest_point_on_polyline(in.points[1].data(), count, track.data(), track.size(), result.data());
+		benchmark::DoNotOptimize(result.data());
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(count));
+}
+GLM_PLUS_BENCHMARK(closest_point_on_polyline);
+
+// Same as closest_point_on_polyline, for comparing the index with the linear search on short polylines.
+static void polyline_index_closest_short(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 2);
+	std::vector<glm::fvec2> track = make_track(in.points[0], std::min(in.points[0].size(), linear_vertices));
+	std::size_t count = std::min(in.points[1].size(), linear_queries);
+	glmp::polyline_index index;
+	index.build(track.data(), track.size());
+	std::vector<glmp::segment_point> result(count);
+	for (auto _ : state) {
+		index.closest(in.points[1].data(), count, result.data());
+		benchmark::DoNotOptimize(result.data());
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(count));
+}
+GLM_PLUS_BENCHMARK(polyline_index_closest_short);
+
+static void polyline_index_build(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 1);
+	std::vector<glm::fvec2> track = make_track(in.points[0], in.points[0].size());
+	glmp::polyline_index index;
+	for (auto _ : state) {
+		index.build(track.data(), track.size());
+		benchmark::DoNotOptimize(&index);
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(polyline_index_build);
+
+static void polyline_index_closest(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 2);
+	std::vector<glm::fvec2> track = make_track(in.points[0], in.points[0].size());
+	glmp::polyline_index index;
+	index.build(track.data(), track.size());
+	std::vector<glmp::segment_point> result(in.points[1].size());
+	for (auto _ : state) {
+		index.closest(in.points[1].data(), in.points[1].size(), result.data());
+		benchmark::DoNotOptimize(result.data());
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(polyline_index_closest);
+
+static void polyline_index_closest_parallel(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 2);
+	std::vector<glm::fvec2> track = make_track(in.points[0], in.points[0].size());
+	glmp::polyline_index index;
+	index.build(track.data(), track.size());
+	std::vector<glmp::segment_point> result(in.points[1].size());
+	for (auto _ : state) {
+		index.closest(glmp::executor::get_default(), in.points[1].data(), in.points[1].size(), result.data());
+		benchmark::DoNotOptimize(result.data());
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(polyline_index_closest_parallel);
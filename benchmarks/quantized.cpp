@@ -0,0 +1,31 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/quantized.h"
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "inputs.h"
+
+namespace glmp = glm_plus;
+
+// Same ray and segments as line_segments_intersect_one_vs_many in line_batch.cpp, but read from quantized storage.
+static void line_segments_intersect_one_vs_many_quantized(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 2);
+	std::vector<glmp::fsegment> segments;
+	for (std::size_t i = 0; i < in.points[0].size(); ++i)
+		segments.emplace_back(in.points[0][i], in.points[1][i]);
+	glmp::quantized_segments storage(segments.data(), segments.size(), glmp::farea(glmp::fpos(-100.0f, -100.0f), glmp::fpos(100.0f, 100.0f)));
+	glm::fvec2 a1(-100.0f, -30.0f);
+	glm::fvec2 a2(100.0f, 40.0f);
+	std::vector<std::uint32_t> hits(segments.size());
+	std::vector<float> ts(segments.size());
+	for (auto _ : state) {
+		std::size_t n = glmp::line_segments_intersect(a1, a2, storage.view(), hits.data(), ts.data());
+		benchmark::DoNotOptimize(n);
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(line_segments_intersect_one_vs_many_quantized);
@@ -0,0 +1,71 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/segment_index.h"
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "inputs.h"
+
+namespace glmp = glm_plus;
+
+namespace {
+
+std::vector<glmp::fsegment> make_segments(const bench::inputs& in) {
+	// Short segments, like walls of a map.
+	std::vector<glmp::fsegment> segments;
+	for (std::size_t i = 0; i < in.points[0].size(); ++i)
+		segments.emplace_back(in.points[0][i], in.points[0][i] + in.points[1][i] * 0.01f);
+	return segments;
+}
+
+}
+
+static void build_segment_index(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 2);
+	std::vector<glmp::fsegment> segments = make_segments(in);
+	std::vector<std::uint8_t> data;
+	for (auto _ : state) {
+		glmp::build_segment_index(segments.data(), segments.size(), &data);
+		benchmark::DoNotOptimize(data.data());
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(build_segment_index);
+
+// Opens the index with verification, which is what every process pays at startup.
+static void open_segment_index(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 2);
+	std::vector<glmp::fsegment> segments = make_segments(in);
+	std::vector<std::uint8_t> data;
+	glmp::build_segment_index(segments.data(), segments.size(), &data);
+	glmp::segment_index index;
+	for (auto _ : state) {
+		bool ok = glmp::segment_index::open(data.data(), data.size(), &index);
+		benchmark::DoNotOptimize(ok);
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(open_segment_index);
+
+// Casts one ray per input point, time per op is per ray.
+static void segment_index_intersect(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 2);
+	std::vector<glmp::fsegment> segments = make_segments(in);
+	std::vector<std::uint8_t> data;
+	glmp::build_segment_index(segments.data(), segments.size(), &data);
+	glmp::segment_index index;
+	glmp::segment_index::open(data.data(), data.size(), &index);
+	std::vector<glmp::segment_hit> hits;
+	for (auto _ : state) {
+		for (std::uint32_t i : in.order) {
+			hits.clear();
+			index.intersect(in.points[0][i], in.points[0][i] + in.points[1][i] * 0.02f, &hits);
+			benchmark::DoNotOptimize(hits.data());
+		}
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(segment_index_intersect);
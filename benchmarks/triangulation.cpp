@@ -0,0 +1,93 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/triangulation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "inputs.h"
+
+namespace glmp = glm_plus;
+
+namespace {
+
+// Star-shaped polygon through the input points, sorted by angle around their center.
+// Polygons are limited to 100k vertices, and small polygons are built from consecutive groups of points.
+constexpr std::size_t max_vertices = 100000;
+constexpr std::size_t small_size = 32;
+
+void add_star(const glm::fvec2* points, std::size_t count, glmp::polygon_list* result) {
+	std::vector<glm::fvec2> ring(points, points + count);
+	glm::fvec2 center(0.0f);
+	for (glm::fvec2 p : ring)
+		center += p;
+	center /= static_cast<float>(count);
+	std::sort(ring.begin(), ring.end(), [center](glm::fvec2 a, glm::fvec2 b) {
+		float angle_a = std::atan2(a.y - center.y, a.x - center.x);
+		float angle_b = std::atan2(b.y - center.y, b.x - center.x);
+		return angle_a < angle_b || (angle_a == angle_b && glm::length(a - center) < glm::length(b - center));
+	});
+	result->vertices.insert(result->vertices.end(), ring.begin(), ring.end());
+	result->offsets.push_back(result->vertices.size());
+}
+
+glmp::polygon_list make_small_polygons(const bench::inputs& in) {
+	glmp::polygon_list list;
+	std::size_t count = std::min<std::size_t>(in.points[0].size(), 4096);
+	for (std::size_t i = 0; i + small_size <= count; i += small_size)
+		add_star(in.points[0].data() + i, small_size, &list);
+	return list;
+}
+
+}
+
+static void triangulate_delaunay(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 1);
+	glmp::polygon_list shape;
+	add_star(in.points[0].data(), std::min(in.points[0].size(), max_vertices), &shape);
+	std::vector<std::uint32_t> result;
+	glmp::arena scratch(shape.vertices.size() * 128);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(glmp::triangulate_delaunay(shape, &result, &scratch));
+		benchmark::DoNotOptimize(result.data());
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(shape.vertices.size()));
+}
+GLM_PLUS_BENCHMARK(triangulate_delaunay);
+
+// Compare with triangulate_delaunay_small to choose the size limit for ear clipping in triangulate.
+static void triangulate_ear_clipping_small(benchmark::State& state) {
+	glmp::polygon_list list = make_small_polygons(bench::get_inputs(state, 1));
+	std::vector<std::uint32_t> result;
+	glmp::arena scratch(1 << 16);
+	for (auto _ : state) {
+		for (std::size_t i = 0; i < list.size(); ++i) {
+			benchmark::DoNotOptimize(glmp::triangulate_ear_clipping(list.vertices.data() + list.offsets[i], small_size, &result, &scratch));
+			benchmark::DoNotOptimize(result.data());
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(list.vertices.size()));
+}
+GLM_PLUS_BENCHMARK(triangulate_ear_clipping_small);
+
+static void triangulate_delaunay_small(benchmark::State& state) {
+	glmp::polygon_list list = make_small_polygons(bench::get_inputs(state, 1));
+	glmp::polygon_list single;
+	std::vector<std::uint32_t> result;
+	glmp::arena scratch(1 << 16);
+	for (auto _ : state) {
+		for (std::size_t i = 0; i < list.size(); ++i) {
+			single.vertices.assign(list.vertices.begin() + static_cast<std::ptrdiff_t>(list.offsets[i]),
+				list.vertices.begin() + static_cast<std::ptrdiff_t>(list.offsets[i + 1]));
+			single.offsets = {0, small_size};
+			benchmark::DoNotOptimize(glmp::triangulate_delaunay(single, &result, &scratch));
+			benchmark::DoNotOptimize(result.data());
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(list.vertices.size()));
+}
+GLM_PLUS_BENCHMARK(triangulate_delaunay_small);
@@ -0,0 +1,32 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/types.h"
+
+#include "benchmark/benchmark.h"
+#include "inputs.h"
+
+namespace glmp = glm_plus;
+
+static void inside_rect(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 3);
+	const auto& p = in.points;
+	for (auto _ : state) {
+		for (std::uint32_t i : in.order)
+			benchmark::DoNotOptimize(glmp::inside_rect(p[0][i], p[1][i], p[2][i]));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(inside_rect);
+
+static void inside_rect_area(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 3);
+	const auto& p = in.points;
+	for (auto _ : state) {
+		for (std::uint32_t i : in.order)
+			benchmark::DoNotOptimize(glmp::inside_rect(p[0][i], glmp::farea(glmp::fpos(p[1][i]), glmp::fpos(p[2][i]))));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(inside_rect_area);
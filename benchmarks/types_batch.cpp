@@ -0,0 +1,92 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/types_batch.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "inputs.h"
+
+namespace glmp = glm_plus;
+
+namespace {
+
+// Areas spanned by pairs of input points.
+glmp::fbox_soa make_areas(const bench::inputs& in) {
+	glmp::fbox_soa s;
+	s.reserve(in.points[0].size());
+	for (std::size_t i = 0; i < in.points[0].size(); ++i)
+		s.push_back(glmp::faabb(glmp::fpos(glm::min(in.points[0][i], in.points[1][i])), glmp::fpos(glm::max(in.points[0][i], in.points[1][i]))));
+	return s;
+}
+
+const glmp::farea query(glmp::fpos(-20.0f, -30.0f), glmp::fpos(40.0f, 10.0f));
+
+}
+
+// Tests all areas against one area with the scalar function, as a baseline for the batched version.
+static void overlaps_one_vs_many_scalar(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 2);
+	glmp::fbox_soa s = make_areas(in);
+	std::vector<std::uint32_t> mask(glmp::mask_words(s.size()));
+	for (auto _ : state) {
+		std::uint32_t bits = 0;
+		for (std::size_t i = 0; i < s.size(); ++i) {
+			bits |= static_cast<std::uint32_t>(glmp::overlaps(glmp::farea(s[i]), query)) << (i % 32);
+			if (i % 32 == 31 || i + 1 == s.size()) {
+				mask[i / 32] = bits;
+				bits = 0;
+			}
+		}
+		benchmark::DoNotOptimize(mask.data());
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(overlaps_one_vs_many_scalar);
+
+static void overlaps_one_vs_many(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 2);
+	glmp::fbox_soa s = make_areas(in);
+	std::vector<std::uint32_t> mask(glmp::mask_words(s.size()));
+	for (auto _ : state) {
+		glmp::overlaps(s, query, mask.data());
+		benchmark::DoNotOptimize(mask.data());
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(overlaps_one_vs_many);
+
+static void inside_rect_batch(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 1);
+	std::vector<float> xs;
+	std::vector<float> ys;
+	for (glm::fvec2 p : in.points[0]) {
+		xs.push_back(p.x);
+		ys.push_back(p.y);
+	}
+	std::vector<std::uint32_t> mask(glmp::mask_words(xs.size()));
+	for (auto _ : state) {
+		glmp::inside_rect(xs.data(), ys.data(), xs.size(), query, mask.data());
+		benchmark::DoNotOptimize(mask.data());
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(inside_rect_batch);
+
+// First 256 areas against each other, so the matrix stays in cache.
+static void overlaps_pairwise(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 2);
+	glmp::fbox_soa s = make_areas(in);
+	std::size_t n = std::min<std::size_t>(s.size(), 256);
+	std::vector<std::uint32_t> matrix(n * glmp::mask_words(n));
+	for (auto _ : state) {
+		glmp::overlaps(s.min_x.data(), s.min_y.data(), s.max_x.data(), s.max_y.data(), n,
+			s.min_x.data(), s.min_y.data(), s.max_x.data(), s.max_y.data(), n, matrix.data());
+		benchmark::DoNotOptimize(matrix.data());
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n * n));
+}
+GLM_PLUS_BENCHMARK(overlaps_pairwise);
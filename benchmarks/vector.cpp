@@ -0,0 +1,54 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/vector.h"
+
+#include "benchmark/benchmark.h"
+#include "inputs.h"
+
+namespace glmp = glm_plus;
+
+static void is_overlapping(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 2);
+	const auto& p = in.points;
+	for (auto _ : state) {
+		for (std::uint32_t i : in.order)
+			benchmark::DoNotOptimize(glmp::is_overlapping(p[0][i], p[1][i], in.scalars[i]));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(is_overlapping);
+
+static void calc_tangent(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 1);
+	const auto& p = in.points;
+	for (auto _ : state) {
+		for (std::uint32_t i : in.order)
+			benchmark::DoNotOptimize(glmp::calc_tangent(p[0][i]));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(calc_tangent);
+
+static void set_length(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 1);
+	const auto& p = in.points;
+	for (auto _ : state) {
+		for (std::uint32_t i : in.order)
+			benchmark::DoNotOptimize(glmp::set_length(p[0][i], in.scalars[i]));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(set_length);
+
+static void mirror(benchmark::State& state) {
+	const bench::inputs& in = bench::get_inputs(state, 2);
+	const auto& p = in.points;
+	for (auto _ : state) {
+		for (std::uint32_t i : in.order)
+			benchmark::DoNotOptimize(glmp::mirror(p[0][i], p[1][i]));
+	}
+	bench::set_counters(state, in);
+}
+GLM_PLUS_BENCHMARK(mirror);
@@ -0,0 +1,647 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+/**
+ * @file aabb_tree.h
+ * This header contains a dynamic bounding volume hierarchy of axis aligned boxes.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "arena.h"
+#include "glm/glm.hpp"
+#include "line.h"
+#include "types.h"
+
+namespace glm_plus {
+
+namespace detail {
+
+/**
+ * Tree traversal stack.
+ * Keeps the first entries in a local array and only allocates memory for very deep trees.
+ */
+class node_stack {
+public:
+	void push(std::uint32_t node) {
+		if (count < local_capacity)
+			local[count] = node;
+		else
+			overflow.push_back(node);
+		++count;
+	}
+
+	std::uint32_t pop() {
+		--count;
+		if (count < local_capacity)
+			return local[count];
+		std::uint32_t node = overflow.back();
+		overflow.pop_back();
+		return node;
+	}
+
+	[[nodiscard]] bool empty() const { return count == 0; }
+
+private:
+	static constexpr std::size_t local_capacity = 128;
+	std::uint32_t local[local_capacity];
+	std::vector<std::uint32_t> overflow;
+	std::size_t count = 0;
+};
+
+}
+
+/**
+ * Dynamic bounding volume hierarchy (AABB tree) for broadphase collision detection.
+ * Each object is stored in a leaf with a fattened box, which is its box expanded by a margin,
+ * so objects can move a little without updating the tree.
+ * New leaves are placed using the surface area heuristic (perimeter in 2D)
+ * and the tree is improved with local rotations, which reduce the total perimeter of internal nodes.
+ * All nodes live in a single array and are linked by indices. Freed nodes are reused.
+ * Objects are identified by proxies, which are returned by @ref insert and stay valid until @ref remove.
+ * @tparam T Coordinate type.
+ */
+template<typename T>
+class aabb_tree {
+public:
+	static constexpr std::uint32_t null_proxy = 0xffffffffu;
+
+	/**
+	 * @param margin Distance by which leaf boxes are fattened.
+	 */
+	explicit aabb_tree(T margin = T(0)) :
+			margin(margin) {}
+
+	/**
+	 * Inserts an object.
+	 * @param bounds Object bounds.
+	 * @param user_id User value stored with the object.
+	 * @return Object proxy.
+	 */
+	std::uint32_t insert(const area<T>& bounds, std::uint32_t user_id = 0);
+
+	/**
+	 * Removes an object.
+	 * @param proxy Object proxy.
+	 */
+	void remove(std::uint32_t proxy);
+
+	/**
+	 * Moves an object. The tree is only updated if new bounds are not inside the fattened box.
+	 * @param proxy Object proxy.
+	 * @param bounds New object bounds.
+	 * @return @c True if the object was reinserted, @c false otherwise.
+	 */
+	bool move(std::uint32_t proxy, const area<T>& bounds);
+
+	/** Returns the object bounds, as given to @ref insert or @ref move. */
+	[[nodiscard]] area<T> get_bounds(std::uint32_t proxy) const { return tight[proxy]; }
+	/** Returns the fattened box stored in the tree, which contains the object bounds. */
+	[[nodiscard]] area<T> get_fat_bounds(std::uint32_t proxy) const { return nodes[proxy].bounds; }
+	/** Returns the user value stored with the object. */
+	[[nodiscard]] std::uint32_t get_user_id(std::uint32_t proxy) const { return nodes[proxy].user_id; }
+	/** Returns the number of objects in the tree. */
+	[[nodiscard]] std::size_t get_size() const { return leaf_count; }
+
+	/**
+	 * Returns the height of the tree. A tree with a single object has height 0.
+	 * @return Tree height, or -1 for an empty tree.
+	 */
+	[[nodiscard]] int get_height() const { return root == null_proxy ? -1 : nodes[root].height; }
+
+	/**
+	 * Calls @p callback for every object whose fattened box overlaps @p range.
+	 * @param range Area to search.
+	 * @param callback Function called as <tt>bool callback(std::uint32_t proxy)</tt>. Returning @c false stops the search.
+	 */
+	template<typename F>
+	void query(const area<T>& range, F&& callback) const;
+
+	/**
+	 * Finds objects whose fattened boxes overlap @p range.
+	 * @param range Area to search.
+	 * @param result Proxies of found objects are appended to this vector.
+	 */
+	void query(const area<T>& range, std::vector<std::uint32_t>* result) const;
+
+	/**
+	 * Finds all pairs of objects whose fattened boxes overlap.
+	 * @param result Pairs of proxies are appended to this vector. The first proxy of each pair is the smaller one.
+	 * @param scratch Arena for the traversal stack. Heap is used if @c nullptr.
+	 */
+	void find_overlapping_pairs(std::vector<std::pair<std::uint32_t, std::uint32_t>>* result, arena* scratch = nullptr) const;
+
+	/**
+	 * Casts a ray segment from @p p1 to @p p2 through the tree.
+	 * The ray is described by a fraction, where 0 is at @p p1 and 1 at @p p2.
+	 * @param p1 Ray start.
+	 * @param p2 Ray end.
+	 * @param callback Function called as <tt>T callback(std::uint32_t proxy, T max_fraction)</tt>
+	 * for every object whose fattened box is hit closer than @p max_fraction.
+	 * Returns the fraction of the hit on the object, which clips the ray, or a negative value if the object was not hit.
+	 * Returning 0 stops the search.
+	 */
+	template<typename F>
+	void raycast(glm::vec<2, T> p1, glm::vec<2, T> p2, F&& callback) const;
+
+	/**
+	 * Casts a ray segment through objects, which are treated as circles inscribed in their bounds.
+	 * Hits are calculated the same way as with @ref line_segment_circle_intersect.
+	 * @param p1 Ray start.
+	 * @param p2 Ray end.
+	 * @param proxy Proxy of the first object hit.
+	 * @param result First intersection point.
+	 * @return @c True if any object was hit, @c false otherwise.
+	 */
+	bool raycast_circles(glm::fvec2 p1, glm::fvec2 p2, std::uint32_t* proxy, glm::fvec2* result) const;
+
+	/**
+	 * Finds the object nearest to a point.
+	 * Distance to an object is the distance to the closest point of its bounds, which is 0 if the point is inside.
+	 * @param x Point.
+	 * @param proxy Proxy of the nearest object.
+	 * @param distance2 Squared distance to the nearest object.
+	 * @return @c True if the tree is not empty, @c false otherwise.
+	 */
+	bool nearest(glm::vec<2, T> x, std::uint32_t* proxy, T* distance2) const;
+
+private:
+	struct node {
+		area<T> bounds;
+		std::uint32_t parent;  // Next free node, for nodes in the free list.
+		std::uint32_t child1;
+		std::uint32_t child2;
+		std::int32_t height;   // 0 for leaves, -1 for free nodes.
+		std::uint32_t user_id;
+	};
+
+	[[nodiscard]] bool is_leaf(std::uint32_t n) const { return nodes[n].child1 == null_proxy; }
+	std::uint32_t allocate_node();
+	void free_node(std::uint32_t n);
+	void insert_leaf(std::uint32_t leaf);
+	void remove_leaf(std::uint32_t leaf);
+	void refit(std::uint32_t n);
+	void rotate(std::uint32_t n);
+
+	static area<T> unite(const area<T>& a, const area<T>& b);
+	static T perimeter(const area<T>& a);
+	static bool overlaps(const area<T>& a, const area<T>& b);
+	static bool contains(const area<T>& outer, const area<T>& inner);
+	static T distance2_to(const area<T>& a, glm::vec<2, T> x);
+
+	T margin;
+	std::vector<node> nodes;
+	std::vector<area<T>> tight;
+	std::uint32_t root = null_proxy;
+	std::uint32_t free_list = null_proxy;
+	std::size_t leaf_count = 0;
+};
+
+typedef aabb_tree<float> faabb_tree;
+
+template<typename T>
+constexpr std::uint32_t aabb_tree<T>::null_proxy;
+
+template<typename T>
+std::uint32_t aabb_tree<T>::insert(const area<T>& bounds, std::uint32_t user_id) {
+	std::uint32_t leaf = allocate_node();
+	node& n = nodes[leaf];
+	glm::vec<2, T> m(margin);
+	n.bounds = area<T>(pos<T>(bounds.topleft - m), pos<T>(bounds.bottomright + m));
+	n.user_id = user_id;
+	n.height = 0;
+	tight[leaf] = bounds;
+	insert_leaf(leaf);
+	++leaf_count;
+	return leaf;
+}
+
+template<typename T>
+void aabb_tree<T>::remove(std::uint32_t proxy) {
+	remove_leaf(proxy);
+	free_node(proxy);
+	--leaf_count;
+}
+
+template<typename T>
+bool aabb_tree<T>::move(std::uint32_t proxy, const area<T>& bounds) {
+	tight[proxy] = bounds;
+	if (contains(nodes[proxy].bounds, bounds))
+		return false;
+
+	remove_leaf(proxy);
+	glm::vec<2, T> m(margin);
+	nodes[proxy].bounds = area<T>(pos<T>(bounds.topleft - m), pos<T>(bounds.bottomright + m));
+	insert_leaf(proxy);
+	return true;
+}
+
+template<typename T>
+template<typename F>
+void aabb_tree<T>::query(const area<T>& range, F&& callback) const {
+	if (root == null_proxy)
+		return;
+
+	detail::node_stack stack;
+	stack.push(root);
+	while (!stack.empty()) {
+		std::uint32_t n = stack.pop();
+		if (!overlaps(nodes[n].bounds, range))
+			continue;
+		if (is_leaf(n)) {
+			if (!callback(n))
+				return;
+		}
+		else {
+			stack.push(nodes[n].child1);
+			stack.push(nodes[n].child2);
+		}
+	}
+}
+
+template<typename T>
+void aabb_tree<T>::query(const area<T>& range, std::vector<std::uint32_t>* result) const {
+	query(range, [result](std::uint32_t proxy) {
+		result->push_back(proxy);
+		return true;
+	});
+}
+
+template<typename T>
+void aabb_tree<T>::find_overlapping_pairs(std::vector<std::pair<std::uint32_t, std::uint32_t>>* result, arena* scratch) const {
+	if (root == null_proxy)
+		return;
+
+	// Traverse the tree against itself. A pair with equal nodes stands for pairs within that subtree.
+	arena_scope scope(scratch);
+	arena_allocator<std::pair<std::uint32_t, std::uint32_t>> alloc(scratch);
+	arena_vector<std::pair<std::uint32_t, std::uint32_t>> stack(alloc);
+	stack.emplace_back(root, root);
+	while (!stack.empty()) {
+		std::uint32_t a = stack.back().first;
+		std::uint32_t b = stack.back().second;
+		stack.pop_back();
+
+		if (a == b) {
+			if (!is_leaf(a)) {
+				stack.emplace_back(nodes[a].child1, nodes[a].child1);
+				stack.emplace_back(nodes[a].child2, nodes[a].child2);
+				stack.emplace_back(nodes[a].child1, nodes[a].child2);
+			}
+			continue;
+		}
+
+		if (!overlaps(nodes[a].bounds, nodes[b].bounds))
+			continue;
+
+		bool leaf_a = is_leaf(a);
+		bool leaf_b = is_leaf(b);
+		if (leaf_a && leaf_b) {
+			result->emplace_back(std::min(a, b), std::max(a, b));
+		}
+		else if (leaf_b || (!leaf_a && perimeter(nodes[a].bounds) >= perimeter(nodes[b].bounds))) {
+			stack.emplace_back(nodes[a].child1, b);
+			stack.emplace_back(nodes[a].child2, b);
+		}
+		else {
+			stack.emplace_back(a, nodes[b].child1);
+			stack.emplace_back(a, nodes[b].child2);
+		}
+	}
+}
+
+template<typename T>
+template<typename F>
+void aabb_tree<T>::raycast(glm::vec<2, T> p1, glm::vec<2, T> p2, F&& callback) const {
+	if (root == null_proxy)
+		return;
+
+	glm::vec<2, T> d = p2 - p1;
+	T max_fraction = T(1);
+	detail::node_stack stack;
+	stack.push(root);
+	while (!stack.empty()) {
+		std::uint32_t n = stack.pop();
+
+		// Slab test of the segment [0, max_fraction] against the node box.
+		const area<T>& b = nodes[n].bounds;
+		T t0 = T(0);
+		T t1 = max_fraction;
+		bool hit = true;
+		for (int axis = 0; axis < 2 && hit; ++axis) {
+			T lo = b.topleft[axis];
+			T hi = b.bottomright[axis];
+			if (d[axis] == T(0)) {
+				hit = p1[axis] >= lo && p1[axis] <= hi;
+				continue;
+			}
+			T ta = (lo - p1[axis]) / d[axis];
+			T tb = (hi - p1[axis]) / d[axis];
+			t0 = std::max(t0, std::min(ta, tb));
+			t1 = std::min(t1, std::max(ta, tb));
+			hit = t0 <= t1;
+		}
+		if (!hit)
+			continue;
+
+		if (is_leaf(n)) {
+			T fraction = callback(n, max_fraction);
+			if (fraction == T(0))
+				return;
+			if (fraction > T(0) && fraction < max_fraction)
+				max_fraction = fraction;
+		}
+		else {
+			stack.push(nodes[n].child1);
+			stack.push(nodes[n].child2);
+		}
+	}
+}
+
+template<typename T>
+bool aabb_tree<T>::raycast_circles(glm::fvec2 p1, glm::fvec2 p2, std::uint32_t* proxy, glm::fvec2* result) const {
+	glm::fvec2 d = p2 - p1;
+	float length2 = d.x * d.x + d.y * d.y;
+	bool found = false;
+	raycast(glm::vec<2, T>(p1), glm::vec<2, T>(p2), [&](std::uint32_t leaf, T max_fraction) {
+		const area<T>& b = tight[leaf];
+		glm::fvec2 center((b.topleft.x + b.bottomright.x) * 0.5f, (b.topleft.y + b.bottomright.y) * 0.5f);
+		float r = std::min(b.bottomright.x - b.topleft.x, b.bottomright.y - b.topleft.y) * 0.5f;
+		glm::fvec2 hit;
+		if (!line_segment_circle_intersect(center, r, p1, p2, &hit))
+			return T(-1);
+
+		float fraction = ((hit.x - p1.x) * d.x + (hit.y - p1.y) * d.y) / length2;
+		if (fraction > static_cast<float>(max_fraction))
+			return T(-1);
+		*proxy = leaf;
+		*result = hit;
+		found = true;
+		return static_cast<T>(fraction);
+	});
+	return found;
+}
+
+template<typename T>
+bool aabb_tree<T>::nearest(glm::vec<2, T> x, std::uint32_t* proxy, T* distance2) const {
+	if (root == null_proxy)
+		return false;
+
+	T best = std::numeric_limits<T>::max();
+	detail::node_stack stack;
+	stack.push(root);
+	while (!stack.empty()) {
+		std::uint32_t n = stack.pop();
+		if (distance2_to(nodes[n].bounds, x) > best)
+			continue;
+
+		if (is_leaf(n)) {
+			T d = distance2_to(tight[n], x);
+			if (d <= best) {
+				best = d;
+				*proxy = n;
+			}
+			continue;
+		}
+
+		// Push the farther child first, so the nearer one is searched first.
+		std::uint32_t c1 = nodes[n].child1;
+		std::uint32_t c2 = nodes[n].child2;
+		if (distance2_to(nodes[c1].bounds, x) < distance2_to(nodes[c2].bounds, x))
+			std::swap(c1, c2);
+		stack.push(c1);
+		stack.push(c2);
+	}
+	*distance2 = best;
+	return true;
+}
+
+template<typename T>
+std::uint32_t aabb_tree<T>::allocate_node() {
+	std::uint32_t n;
+	if (free_list != null_proxy) {
+		n = free_list;
+		free_list = nodes[n].parent;
+	}
+	else {
+		n = static_cast<std::uint32_t>(nodes.size());
+		nodes.emplace_back();
+		tight.emplace_back();
+	}
+	nodes[n].parent = null_proxy;
+	nodes[n].child1 = null_proxy;
+	nodes[n].child2 = null_proxy;
+	nodes[n].height = 0;
+	nodes[n].user_id = 0;
+	return n;
+}
+
+template<typename T>
+void aabb_tree<T>::free_node(std::uint32_t n) {
+	nodes[n].parent = free_list;
+	nodes[n].height = -1;
+	free_list = n;
+}
+
+template<typename T>
+void aabb_tree<T>::insert_leaf(std::uint32_t leaf) {
+	if (root == null_proxy) {
+		root = leaf;
+		nodes[leaf].parent = null_proxy;
+		return;
+	}
+
+	// Descend towards the sibling with the lowest cost according to the surface area heuristic.
+	area<T> leaf_bounds = nodes[leaf].bounds;
+	std::uint32_t index = root;
+	while (!is_leaf(index)) {
+		std::uint32_t c1 = nodes[index].child1;
+		std::uint32_t c2 = nodes[index].child2;
+
+		T p = perimeter(nodes[index].bounds);
+		T combined = perimeter(unite(nodes[index].bounds, leaf_bounds));
+		T cost = T(2) * combined;
+		T inheritance = T(2) * (combined - p);
+
+		T cost1 = perimeter(unite(leaf_bounds, nodes[c1].bounds)) + inheritance;
+		if (!is_leaf(c1))
+			cost1 -= perimeter(nodes[c1].bounds);
+		T cost2 = perimeter(unite(leaf_bounds, nodes[c2].bounds)) + inheritance;
+		if (!is_leaf(c2))
+			cost2 -= perimeter(nodes[c2].bounds);
+
+		if (cost < cost1 && cost < cost2)
+			break;
+		index = cost1 < cost2 ? c1 : c2;
+	}
+	std::uint32_t sibling = index;
+
+	std::uint32_t old_parent = nodes[sibling].parent;
+	std::uint32_t new_parent = allocate_node();
+	nodes[new_parent].parent = old_parent;
+	nodes[new_parent].child1 = sibling;
+	nodes[new_parent].child2 = leaf;
+	nodes[new_parent].bounds = unite(leaf_bounds, nodes[sibling].bounds);
+	nodes[new_parent].height = nodes[sibling].height + 1;
+	nodes[sibling].parent = new_parent;
+	nodes[leaf].parent = new_parent;
+
+	if (old_parent == null_proxy)
+		root = new_parent;
+	else if (nodes[old_parent].child1 == sibling)
+		nodes[old_parent].child1 = new_parent;
+	else
+		nodes[old_parent].child2 = new_parent;
+
+	refit(nodes[leaf].parent);
+}
+
+template<typename T>
+void aabb_tree<T>::remove_leaf(std::uint32_t leaf) {
+	if (leaf == root) {
+		root = null_proxy;
+		return;
+	}
+
+	std::uint32_t parent = nodes[leaf].parent;
+	std::uint32_t grand_parent = nodes[parent].parent;
+	std::uint32_t sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+	free_node(parent);
+
+	nodes[sibling].parent = grand_parent;
+	if (grand_parent == null_proxy) {
+		root = sibling;
+		return;
+	}
+
+	if (nodes[grand_parent].child1 == parent)
+		nodes[grand_parent].child1 = sibling;
+	else
+		nodes[grand_parent].child2 = sibling;
+	refit(grand_parent);
+}
+
+template<typename T>
+void aabb_tree<T>::refit(std::uint32_t n) {
+	while (n != null_proxy) {
+		node& nd = nodes[n];
+		nd.bounds = unite(nodes[nd.child1].bounds, nodes[nd.child2].bounds);
+		nd.height = 1 + std::max(nodes[nd.child1].height, nodes[nd.child2].height);
+		rotate(n);
+		n = nodes[n].parent;
+	}
+}
+
+template<typename T>
+void aabb_tree<T>::rotate(std::uint32_t a) {
+	// Node a has children b and c. Swapping b with a child of c (or c with a child of b)
+	// changes only the box of the node that receives the swapped child.
+	// Pick the swap, which reduces that node's perimeter the most.
+	std::uint32_t b = nodes[a].child1;
+	std::uint32_t c = nodes[a].child2;
+
+	enum { none, b_f, b_g, c_d, c_e } best = none;
+	T best_delta = T(0);
+
+	if (!is_leaf(c)) {
+		std::uint32_t f = nodes[c].child1;
+		std::uint32_t g = nodes[c].child2;
+		T pc = perimeter(nodes[c].bounds);
+		T delta = perimeter(unite(nodes[b].bounds, nodes[g].bounds)) - pc;
+		if (delta < best_delta) {
+			best = b_f;
+			best_delta = delta;
+		}
+		delta = perimeter(unite(nodes[b].bounds, nodes[f].bounds)) - pc;
+		if (delta < best_delta) {
+			best = b_g;
+			best_delta = delta;
+		}
+	}
+	if (!is_leaf(b)) {
+		std::uint32_t d = nodes[b].child1;
+		std::uint32_t e = nodes[b].child2;
+		T pb = perimeter(nodes[b].bounds);
+		T delta = perimeter(unite(nodes[c].bounds, nodes[e].bounds)) - pb;
+		if (delta < best_delta) {
+			best = c_d;
+			best_delta = delta;
+		}
+		delta = perimeter(unite(nodes[c].bounds, nodes[d].bounds)) - pb;
+		if (delta < best_delta) {
+			best = c_e;
+			best_delta = delta;
+		}
+	}
+	if (best == none)
+		return;
+
+	// Swap child x of node a with child y of node z, which is the other child of a.
+	auto swap_children = [this, a](std::uint32_t x, std::uint32_t z, std::uint32_t y) {
+		if (nodes[a].child1 == x)
+			nodes[a].child1 = y;
+		else
+			nodes[a].child2 = y;
+		if (nodes[z].child1 == y)
+			nodes[z].child1 = x;
+		else
+			nodes[z].child2 = x;
+		nodes[x].parent = z;
+		nodes[y].parent = a;
+
+		node& nz = nodes[z];
+		nz.bounds = unite(nodes[nz.child1].bounds, nodes[nz.child2].bounds);
+		nz.height = 1 + std::max(nodes[nz.child1].height, nodes[nz.child2].height);
+		nodes[a].height = 1 + std::max(nodes[nodes[a].child1].height, nodes[nodes[a].child2].height);
+	};
+
+	switch (best) {
+		case b_f: swap_children(b, c, nodes[c].child1); break;
+		case b_g: swap_children(b, c, nodes[c].child2); break;
+		case c_d: swap_children(c, b, nodes[b].child1); break;
+		case c_e: swap_children(c, b, nodes[b].child2); break;
+		default: break;
+	}
+}
+
+template<typename T>
+area<T> aabb_tree<T>::unite(const area<T>& a, const area<T>& b) {
+	return area<T>(
+		pos<T>(std::min(a.topleft.x, b.topleft.x), std::min(a.topleft.y, b.topleft.y)),
+		pos<T>(std::max(a.bottomright.x, b.bottomright.x), std::max(a.bottomright.y, b.bottomright.y)));
+}
+
+template<typename T>
+T aabb_tree<T>::perimeter(const area<T>& a) {
+	return T(2) * ((a.bottomright.x - a.topleft.x) + (a.bottomright.y - a.topleft.y));
+}
+
+template<typename T>
+bool aabb_tree<T>::overlaps(const area<T>& a, const area<T>& b) {
+	return a.topleft.x <= b.bottomright.x && a.bottomright.x >= b.topleft.x
+		&& a.topleft.y <= b.bottomright.y && a.bottomright.y >= b.topleft.y;
+}
+
+template<typename T>
+bool aabb_tree<T>::contains(const area<T>& outer, const area<T>& inner) {
+	return outer.topleft.x <= inner.topleft.x && outer.topleft.y <= inner.topleft.y
+		&& outer.bottomright.x >= inner.bottomright.x && outer.bottomright.y >= inner.bottomright.y;
+}
+
+template<typename T>
+T aabb_tree<T>::distance2_to(const area<T>& a, glm::vec<2, T> x) {
+	T dx = std::max(std::max(a.topleft.x - x.x, x.x - a.bottomright.x), T(0));
+	T dy = std::max(std::max(a.topleft.y - x.y, x.y - a.bottomright.y), T(0));
+	return dx * dx + dy * dy;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "affine.h"
+
+using namespace glm_plus;
+using namespace glm;
+
+// Points are processed two per iteration, through their members, so no fvec2 layout is assumed.
+// Both points are loaded before either is stored, so the compiler can use one 4-wide vector
+// without checking whether the input and output arrays alias.
+void glm_plus::transform(const affine2& t, const fvec2* points, std::size_t count, fvec2* result) {
+	if (t.x_axis.y == 0.0f && t.y_axis.x == 0.0f) {
+		const float sx = t.x_axis.x;
+		const float sy = t.y_axis.y;
+		const float tx = t.translation.x;
+		const float ty = t.translation.y;
+		std::size_t i = 0;
+		for (; i + 2 <= count; i += 2) {
+			fvec2 p0 = points[i];
+			fvec2 p1 = points[i + 1];
+			result[i].x = p0.x * sx + tx;
+			result[i].y = p0.y * sy + ty;
+			result[i + 1].x = p1.x * sx + tx;
+			result[i + 1].y = p1.y * sy + ty;
+		}
+		if (i < count) {
+			fvec2 p = points[i];
+			result[i].x = p.x * sx + tx;
+			result[i].y = p.y * sy + ty;
+		}
+		return;
+	}
+
+	const float a = t.x_axis.x;
+	const float b = t.x_axis.y;
+	const float c = t.y_axis.x;
+	const float d = t.y_axis.y;
+	const float tx = t.translation.x;
+	const float ty = t.translation.y;
+	std::size_t i = 0;
+	for (; i + 2 <= count; i += 2) {
+		fvec2 p0 = points[i];
+		fvec2 p1 = points[i + 1];
+		result[i].x = a * p0.x + c * p0.y + tx;
+		result[i].y = b * p0.x + d * p0.y + ty;
+		result[i + 1].x = a * p1.x + c * p1.y + tx;
+		result[i + 1].y = b * p1.x + d * p1.y + ty;
+	}
+	if (i < count) {
+		fvec2 p = points[i];
+		result[i].x = a * p.x + c * p.y + tx;
+		result[i].y = b * p.x + d * p.y + ty;
+	}
+}
+
+void glm_plus::transform(const affine2& t, fvec2* points, std::size_t count) {
+	transform(t, points, count, points);
+}
@@ -0,0 +1,67 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "arena.h"
+
+#include <cassert>
+
+using namespace glm_plus;
+
+namespace {
+
+// Overflow blocks form a list, newest first, so resetting frees them from the front.
+struct overflow_block {
+	overflow_block* next;
+	std::size_t bytes;
+};
+
+}
+
+arena::arena(std::size_t capacity) :
+		data(static_cast<char*>(::operator new(capacity))),
+		capacity(capacity),
+		owned(true) {}
+
+arena::arena(void* buffer, std::size_t capacity) :
+		data(static_cast<char*>(buffer)),
+		capacity(capacity),
+		owned(false) {}
+
+arena::~arena() {
+	reset();
+	if (owned)
+		::operator delete(data);
+}
+
+void arena::reset(marker position) {
+#ifndef NDEBUG
+	// A marker from another arena, or from before a reset to an earlier position, would walk past the end of the overflow list.
+	assert(position.offset <= offset);
+	const auto* block = static_cast<const overflow_block*>(overflow);
+	while (block && block != position.overflow)
+		block = block->next;
+	assert(block == position.overflow);
+#endif
+	while (overflow != position.overflow) {
+		auto* block = static_cast<overflow_block*>(overflow);
+		overflow = block->next;
+		overflow_bytes -= block->bytes;
+		::operator delete(block);
+	}
+	offset = position.offset;
+}
+
+void* arena::allocate_overflow(std::size_t bytes, std::size_t alignment) {
+	std::size_t header = sizeof(overflow_block) + alignment - 1;
+	auto* block = static_cast<overflow_block*>(::operator new(header + bytes));
+	block->next = static_cast<overflow_block*>(overflow);
+	block->bytes = bytes;
+	overflow = block;
+	overflow_bytes += bytes;
+	++overflow_count;
+	peak_used = std::max(peak_used, offset + overflow_bytes);
+
+	auto begin = reinterpret_cast<std::uintptr_t>(block + 1);
+	return reinterpret_cast<void*>((begin + alignment - 1) & ~(alignment - 1));
+}
\ No newline at end of file
@@ -0,0 +1,205 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+/**
+ * @file arena.h
+ * This header contains a bump allocator for temporary buffers of bulk algorithms.
+ * Functions, which need scratch memory, accept an optional @ref arena pointer.
+ * When it is given, their temporary buffers come from the arena, otherwise from the heap.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace glm_plus {
+
+/**
+ * Bump allocator over a single memory block.
+ * Allocation only moves an offset forward, and memory is released all at once with @ref reset,
+ * or back to an earlier @ref mark. Typically, an arena is reset once per frame.
+ * When the block is full, allocations fall back to the heap, so they never fail.
+ * Such overflow blocks are freed on reset, and they are counted, so the arena can be sized to avoid them.
+ * An arena must not be used by multiple threads at once.
+ */
+class arena {
+public:
+	/** Position in the arena, which can be restored with @ref reset. */
+	struct marker {
+		std::size_t offset;
+		void* overflow;
+	};
+
+	/**
+	 * Creates an arena with its own memory block.
+	 * @param capacity Block size in bytes.
+	 */
+	explicit arena(std::size_t capacity);
+
+	/**
+	 * Creates an arena over memory owned by the caller, which must outlive the arena.
+	 * @param buffer Memory block.
+	 * @param capacity Block size in bytes.
+	 */
+	arena(void* buffer, std::size_t capacity);
+
+	arena(const arena&) = delete;
+	arena& operator=(const arena&) = delete;
+	~arena();
+
+	/**
+	 * Allocates memory. Never returns @c nullptr.
+	 * @param bytes Size in bytes.
+	 * @param alignment Alignment, must be a power of two.
+	 * @return Allocated memory, valid until the arena is reset to a position before it.
+	 */
+	[[nodiscard]] void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+		auto base = reinterpret_cast<std::uintptr_t>(data);
+		std::size_t begin = ((base + offset + alignment - 1) & ~(alignment - 1)) - base;
+		if (begin + bytes > capacity)
+			return allocate_overflow(bytes, alignment);
+		offset = begin + bytes;
+		peak_used = std::max(peak_used, offset + overflow_bytes);
+		return data + begin;
+	}
+
+	/**
+	 * Allocates an uninitialized array.
+	 * @param count Number of elements.
+	 */
+	template<typename T>
+	[[nodiscard]] T* allocate(std::size_t count) {
+		return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+	}
+
+	/**
+	 * Releases memory if it is the last allocation, otherwise does nothing.
+	 * @param p Allocated memory.
+	 * @param bytes Size passed to @ref allocate.
+	 */
+	void deallocate(void* p, std::size_t bytes) noexcept {
+		auto begin = reinterpret_cast<std::uintptr_t>(p);
+		auto base = reinterpret_cast<std::uintptr_t>(data);
+		if (begin >= base && begin + bytes == base + offset)
+			offset = begin - base;
+	}
+
+	/**
+	 * Returns the current position, for a later @ref reset.
+	 */
+	[[nodiscard]] marker mark() const { return {offset, overflow}; }
+
+	/**
+	 * Releases all memory allocated after the position.
+	 * @param position Position returned by @ref mark of this arena. Resetting to an earlier position, or releasing all memory,
+	 * invalidates markers taken after it. Debug builds assert this.
+	 */
+	void reset(marker position);
+
+	/**
+	 * Releases all memory.
+	 */
+	void reset() { reset(marker{0, nullptr}); }
+
+	/** Size of the memory block in bytes. */
+	[[nodiscard]] std::size_t get_capacity() const { return capacity; }
+
+	/** Bytes currently allocated, including alignment padding and overflow blocks. */
+	[[nodiscard]] std::size_t get_used() const { return offset + overflow_bytes; }
+
+	/** Largest value of @ref get_used since creation or @ref reset_peak. A capacity of at least this much avoids overflow. */
+	[[nodiscard]] std::size_t get_peak() const { return peak_used; }
+
+	/** Number of allocations, which did not fit into the memory block, since creation or @ref reset_peak. */
+	[[nodiscard]] std::size_t get_overflow_count() const { return overflow_count; }
+
+	/**
+	 * Restarts peak usage and overflow counters from the current usage.
+	 */
+	void reset_peak() {
+		peak_used = get_used();
+		overflow_count = 0;
+	}
+
+private:
+	void* allocate_overflow(std::size_t bytes, std::size_t alignment);
+
+	char* data;
+	std::size_t capacity;
+	std::size_t offset = 0;
+	bool owned;
+	void* overflow = nullptr;
+	std::size_t overflow_bytes = 0;
+	std::size_t overflow_count = 0;
+	std::size_t peak_used = 0;
+};
+
+/**
+ * Resets an arena to its position at construction, when going out of scope.
+ * A @c nullptr arena is allowed, in which case nothing happens.
+ */
+class arena_scope {
+public:
+	explicit arena_scope(arena* source) :
+			source(source),
+			position(source ? source->mark() : arena::marker{0, nullptr}) {}
+	arena_scope(const arena_scope&) = delete;
+	arena_scope& operator=(const arena_scope&) = delete;
+	~arena_scope() {
+		if (source)
+			source->reset(position);
+	}
+
+private:
+	arena* source;
+	arena::marker position;
+};
+
+/**
+ * Standard allocator, which allocates from an arena, or from the heap if the arena is @c nullptr.
+ * Containers using it must be destroyed before the arena is reset to a position before their allocations.
+ */
+template<typename T>
+class arena_allocator {
+public:
+	typedef T value_type;
+
+	arena_allocator() noexcept = default;
+	explicit arena_allocator(arena* source) noexcept :
+			source(source) {}
+	template<typename U>
+	arena_allocator(const arena_allocator<U>& other) noexcept :
+			source(other.get_arena()) {}
+
+	[[nodiscard]] T* allocate(std::size_t n) {
+		return source ? source->allocate<T>(n) : static_cast<T*>(::operator new(n * sizeof(T)));
+	}
+
+	void deallocate(T* p, std::size_t n) noexcept {
+		if (source)
+			source->deallocate(p, n * sizeof(T));
+		else
+			::operator delete(p);
+	}
+
+	[[nodiscard]] arena* get_arena() const noexcept { return source; }
+
+	template<typename U>
+	bool operator==(const arena_allocator<U>& other) const noexcept { return source == other.get_arena(); }
+	template<typename U>
+	bool operator!=(const arena_allocator<U>& other) const noexcept { return source != other.get_arena(); }
+
+private:
+	arena* source = nullptr;
+};
+
+/** Vector, which allocates from an arena. */
+template<typename T>
+using arena_vector = std::vector<T, arena_allocator<T>>;
+
+}
\ No newline at end of file
@@ -0,0 +1,459 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "clip.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+#include "predicates.h"
+
+using namespace glm_plus;
+using namespace glm;
+using detail::clip_node;
+
+namespace {
+
+constexpr std::uint32_t none = 0xffffffffu;
+
+// Clips a polygon against a single half-plane.
+template<typename Inside, typename Intersect>
+void clip_plane(const fvec2* in, std::size_t n, std::vector<fvec2>& out, Inside inside, Intersect intersect) {
+	out.clear();
+	if (n == 0)
+		return;
+	
+	std::size_t prev = n - 1;
+	bool prev_inside = inside(prev);
+	for (std::size_t i = 0; i < n; ++i) {
+		bool cur_inside = inside(i);
+		if (cur_inside != prev_inside)
+			out.push_back(intersect(prev, i));
+		if (cur_inside)
+			out.push_back(in[i]);
+		prev = i;
+		prev_inside = cur_inside;
+	}
+}
+
+// Point on the segment from a to b, where the coordinate selected by axis equals c.
+fvec2 axis_intersect(fvec2 a, fvec2 b, int axis, float c) {
+	// Interpolate from the smaller point, so both directions of an edge give the same result.
+	if (a[axis] > b[axis])
+		std::swap(a, b);
+	float t = (c - a[axis]) / (b[axis] - a[axis]);
+	fvec2 p = a + (b - a) * t;
+	p[axis] = c;
+	return p;
+}
+
+double cross(dvec2 a, dvec2 b) {
+	return a.x * b.y - a.y * b.x;
+}
+
+double signed_area(const fvec2* v, std::size_t count) {
+	double area = 0.0;
+	for (std::size_t i = 0, j = count - 1; i < count; j = i++)
+		area += static_cast<double>(v[j].x) * v[i].y - static_cast<double>(v[i].x) * v[j].y;
+	return area * 0.5;
+}
+
+// Reverses rings, so outer rings run in the given orientation and holes in the opposite one.
+// With single_outer, the ring with the largest area is the outer one and others are its holes. Otherwise all rings are outer.
+void orient_rings(polygon_list* result, double orientation, bool single_outer) {
+	std::size_t outer = 0;
+	double outer_area = 0.0;
+	for (std::size_t i = 0; i < result->size(); ++i) {
+		double area = std::abs(signed_area(result->vertices.data() + result->offsets[i], result->offsets[i + 1] - result->offsets[i]));
+		if (area > outer_area) {
+			outer = i;
+			outer_area = area;
+		}
+	}
+	for (std::size_t i = 0; i < result->size(); ++i) {
+		auto first = result->vertices.begin() + static_cast<std::ptrdiff_t>(result->offsets[i]);
+		auto last = result->vertices.begin() + static_cast<std::ptrdiff_t>(result->offsets[i + 1]);
+		double expected = !single_outer || i == outer ? orientation : -orientation;
+		if (signed_area(&*first, static_cast<std::size_t>(last - first)) * expected < 0.0)
+			std::reverse(first, last);
+	}
+}
+
+// Degenerate configurations are resolved by treating the clip polygon as moved by (e, e * e) for an infinitesimal e.
+// An exact orientation of zero then takes the sign of the first nonzero term of the motion,
+// with the point moved in the direction of sign relative to the line from a to b.
+double perturbed(double orientation, dvec2 a, dvec2 b, double sign) {
+	if (orientation != 0.0)
+		return orientation;
+	dvec2 r = b - a;
+	return sign * (r.y != 0.0 ? -r.y : r.x);
+}
+
+bool opposite(double a, double b) {
+	return (a < 0.0 && b > 0.0) || (a > 0.0 && b < 0.0);
+}
+
+// Crossing number test, over the original vertices of a node list, for point x moved in the direction of sign.
+bool list_contains(const std::vector<clip_node>& nodes, std::uint32_t first, std::uint32_t count, dvec2 x, double sign) {
+	bool inside = false;
+	for (std::uint32_t i = 0, j = count - 1; i < count; j = i++) {
+		dvec2 a = nodes[first + j].p;
+		dvec2 b = nodes[first + i].p;
+		bool a_below = a.y < x.y || (a.y == x.y && sign > 0.0);
+		bool b_below = b.y < x.y || (b.y == x.y && sign > 0.0);
+		if (a_below != b_below && (perturbed(orient2d(a, b, x), a, b, sign) > 0.0) == a_below)
+			inside = !inside;
+	}
+	return inside;
+}
+
+class greiner_hormann {
+public:
+	greiner_hormann(const polygon& subject, const polygon& clip, std::vector<clip_node>& nodes) :
+			subject(subject),
+			clip(clip),
+			nodes(nodes),
+			n(static_cast<std::uint32_t>(subject.vertices.size())),
+			m(static_cast<std::uint32_t>(clip.vertices.size())) {}
+	
+	void run(boolean_op op, polygon_list* result);
+
+private:
+	void build();
+	void insert_intersections();
+	void insert_after(std::uint32_t node, std::uint32_t after_original, double alpha, dvec2 alpha_tie);
+	void mark_entries(std::uint32_t first, bool forwards);
+	bool trace(boolean_op op, polygon_list* result);
+	void emit_original(const polygon& poly, polygon_list* result);
+	
+	const polygon& subject;
+	const polygon& clip;
+	std::vector<clip_node>& nodes;
+	std::uint32_t n;
+	std::uint32_t m;
+};
+
+void greiner_hormann::build() {
+	nodes.clear();
+	auto add_ring = [this](const polygon& poly, std::uint32_t first) {
+		auto count = static_cast<std::uint32_t>(poly.vertices.size());
+		for (std::uint32_t i = 0; i < count; ++i) {
+			clip_node node;
+			node.p = dvec2(poly.vertices[i]);
+			node.alpha = 0.0;
+			node.alpha_tie = dvec2(0.0);
+			node.next = first + (i + 1) % count;
+			node.prev = first + (i + count - 1) % count;
+			node.neighbor = none;
+			node.intersect = false;
+			node.entry = false;
+			node.visited = false;
+			nodes.push_back(node);
+		}
+	};
+	add_ring(subject, 0);
+	add_ring(clip, n);
+}
+
+void greiner_hormann::insert_after(std::uint32_t node, std::uint32_t after_original, double alpha, dvec2 alpha_tie) {
+	// Intersections on the same edge are kept sorted by alpha. Equal ones, which meet at a vertex of the other polygon,
+	// are sorted by how alpha moves with the perturbation.
+	auto before = [&](const clip_node& other) {
+		return other.alpha < alpha || (other.alpha == alpha
+			&& (other.alpha_tie.x < alpha_tie.x || (other.alpha_tie.x == alpha_tie.x && other.alpha_tie.y < alpha_tie.y)));
+	};
+	std::uint32_t prev = after_original;
+	while (nodes[nodes[prev].next].intersect && before(nodes[nodes[prev].next]))
+		prev = nodes[prev].next;
+	std::uint32_t next = nodes[prev].next;
+	nodes[node].alpha = alpha;
+	nodes[node].alpha_tie = alpha_tie;
+	nodes[node].prev = prev;
+	nodes[node].next = next;
+	nodes[prev].next = node;
+	nodes[next].prev = node;
+}
+
+void greiner_hormann::insert_intersections() {
+	for (std::uint32_t i = 0; i < n; ++i) {
+		dvec2 a1 = nodes[i].p;
+		dvec2 a2 = nodes[(i + 1) % n].p;
+		dvec2 r = a2 - a1;
+		for (std::uint32_t j = 0; j < m; ++j) {
+			dvec2 b1 = nodes[n + j].p;
+			dvec2 b2 = nodes[n + (j + 1) % m].p;
+			double ob1 = orient2d(a1, a2, b1);
+			double ob2 = orient2d(a1, a2, b2);
+			if (!opposite(perturbed(ob1, a1, a2, 1.0), perturbed(ob2, a1, a2, 1.0)))
+				continue;
+			double oa1 = orient2d(b1, b2, a1);
+			double oa2 = orient2d(b1, b2, a2);
+			if (!opposite(perturbed(oa1, b1, b2, -1.0), perturbed(oa2, b1, b2, -1.0)))
+				continue;
+			
+			// Edges cross, possibly in a vertex lying exactly on the other edge, whose position is then used as is.
+			// Otherwise, at most one of the four orientations is zero.
+			dvec2 s = b2 - b1;
+			dvec2 d = b1 - a1;
+			double denom = cross(r, s);
+			double t;
+			double u;
+			dvec2 p;
+			if (ob1 == 0.0 || ob2 == 0.0) {
+				p = ob1 == 0.0 ? b1 : b2;
+				t = std::min(std::max(dot(p - a1, r) / dot(r, r), 0.0), 1.0);
+				u = ob1 == 0.0 ? 0.0 : 1.0;
+			}
+			else if (oa1 == 0.0 || oa2 == 0.0) {
+				p = oa1 == 0.0 ? a1 : a2;
+				t = oa1 == 0.0 ? 0.0 : 1.0;
+				u = std::min(std::max(dot(p - b1, s) / dot(s, s), 0.0), 1.0);
+			}
+			else {
+				t = std::min(std::max(cross(d, s) / denom, 0.0), 1.0);
+				u = std::min(std::max(cross(d, r) / denom, 0.0), 1.0);
+				p = a1 + r * t;
+			}
+			
+			auto sn = static_cast<std::uint32_t>(nodes.size());
+			auto cn = sn + 1;
+			clip_node node;
+			node.p = p;
+			node.neighbor = cn;
+			node.intersect = true;
+			node.entry = false;
+			node.visited = false;
+			nodes.push_back(node);
+			node.neighbor = sn;
+			nodes.push_back(node);
+			insert_after(sn, i, t, dvec2(s.y, -s.x) / denom);
+			insert_after(cn, n + j, u, dvec2(r.y, -r.x) / denom);
+		}
+	}
+}
+
+void greiner_hormann::mark_entries(std::uint32_t first, bool forwards) {
+	std::uint32_t node = first;
+	do {
+		if (nodes[node].intersect) {
+			nodes[node].entry = forwards;
+			forwards = !forwards;
+		}
+		node = nodes[node].next;
+	} while (node != first);
+}
+
+void greiner_hormann::emit_original(const polygon& poly, polygon_list* result) {
+	result->vertices.insert(result->vertices.end(), poly.vertices.begin(), poly.vertices.end());
+	result->offsets.push_back(result->vertices.size());
+}
+
+void greiner_hormann::run(boolean_op op, polygon_list* result) {
+	result->clear();
+	bool single_outer = false;
+	if (n < 3 || m < 3) {
+		if (n >= 3 && op != boolean_op::intersection)
+			emit_original(subject, result);
+		if (m >= 3 && op == boolean_op::union_)
+			emit_original(clip, result);
+	}
+	else {
+		single_outer = trace(op, result);
+	}
+	
+	// Rings are copied or traced in either direction.
+	double orientation = n >= 3 && signed_area(subject.vertices.data(), n) < 0.0 ? -1.0 : 1.0;
+	orient_rings(result, orientation, single_outer);
+}
+
+// Returns true if the result is a single outer ring with holes.
+// Holes only occur in the difference with a nested clip polygon and in the union of crossing polygons, which is connected.
+bool greiner_hormann::trace(boolean_op op, polygon_list* result) {
+	build();
+	insert_intersections();
+	
+	// Subject vertices move against the clip polygon.
+	bool subject_in_clip = list_contains(nodes, n, m, nodes[0].p, -1.0);
+	bool clip_in_subject = list_contains(nodes, 0, n, nodes[n].p, 1.0);
+	if (nodes.size() == n + m) {
+		switch (op) {
+			case boolean_op::intersection:
+				if (subject_in_clip)
+					emit_original(subject, result);
+				else if (clip_in_subject)
+					emit_original(clip, result);
+				break;
+			case boolean_op::union_:
+				if (subject_in_clip) {
+					emit_original(clip, result);
+				}
+				else if (clip_in_subject) {
+					emit_original(subject, result);
+				}
+				else {
+					emit_original(subject, result);
+					emit_original(clip, result);
+				}
+				break;
+			case boolean_op::difference:
+				if (clip_in_subject) {
+					emit_original(subject, result);
+					emit_original(clip, result);
+				}
+				else if (!subject_in_clip) {
+					emit_original(subject, result);
+				}
+				break;
+		}
+		return op == boolean_op::difference && clip_in_subject;
+	}
+	
+	// Walking forward from an entry intersection follows the subject inside the clip polygon, which gives the intersection.
+	// Other operations reverse the walking direction on one or both polygons.
+	bool subject_forwards = op == boolean_op::intersection;
+	bool clip_forwards = op != boolean_op::union_;
+	mark_entries(0, subject_forwards != subject_in_clip);
+	mark_entries(n, clip_forwards != clip_in_subject);
+	
+	for (std::uint32_t start = n + m; start < nodes.size(); ++start) {
+		if (nodes[start].visited)
+			continue;
+		
+		// Intersections at shared vertices repeat points, which are skipped.
+		std::size_t ring = result->vertices.size();
+		auto add = [result, ring](dvec2 p) {
+			if (result->vertices.size() == ring || result->vertices.back() != fvec2(p))
+				result->vertices.emplace_back(p);
+		};
+		std::uint32_t current = start;
+		add(nodes[current].p);
+		do {
+			nodes[current].visited = true;
+			nodes[nodes[current].neighbor].visited = true;
+			bool forwards = nodes[current].entry;
+			do {
+				current = forwards ? nodes[current].next : nodes[current].prev;
+				add(nodes[current].p);
+			} while (!nodes[current].intersect);
+			current = nodes[current].neighbor;
+		} while (!nodes[current].visited);
+		
+		// The last vertex closes the polygon at the starting intersection.
+		// Rings without area are left by the perturbation between edges, which overlap.
+		while (result->vertices.size() > ring + 1 && result->vertices.back() == result->vertices[ring])
+			result->vertices.pop_back();
+		std::size_t count = result->vertices.size() - ring;
+		if (count < 3 || signed_area(result->vertices.data() + ring, count) == 0.0)
+			result->vertices.resize(ring);
+		else
+			result->offsets.push_back(result->vertices.size());
+	}
+	return op == boolean_op::union_;
+}
+
+}
+
+void glm_plus::clip(const fvec2* vertices, std::size_t count, const farea& bounds, std::vector<fvec2>* result, clip_workspace* workspace) {
+	result->clear();
+	if (count == 0)
+		return;
+	
+	const float x0 = bounds.topleft.x;
+	const float y0 = bounds.topleft.y;
+	const float x1 = bounds.bottomright.x;
+	const float y1 = bounds.bottomright.y;
+	
+	// Outcodes of all vertices, calculated in a single vectorized pass over interleaved coordinates.
+	workspace->codes.resize(count);
+	std::uint8_t* codes = workspace->codes.data();
+	const auto* v = reinterpret_cast<const float*>(vertices);
+	for (std::size_t i = 0; i < count; ++i) {
+		float x = v[2 * i];
+		float y = v[2 * i + 1];
+		codes[i] = static_cast<std::uint8_t>((x < x0) | (x > x1) << 1 | (y < y0) << 2 | (y > y1) << 3);
+	}
+	std::uint8_t any = 0;
+	std::uint8_t all = 0xf;
+	for (std::size_t i = 0; i < count; ++i) {
+		any |= codes[i];
+		all &= codes[i];
+	}
+	
+	if (all != 0)
+		return;
+	if (any == 0) {
+		result->assign(vertices, vertices + count);
+		return;
+	}
+	
+	// Clip against crossed sides only, alternating between the workspace buffer and the result.
+	const fvec2* in = vertices;
+	std::size_t n = count;
+	std::vector<fvec2>* out = &workspace->buffer;
+	const float limits[4] = {x0, x1, y0, y1};
+	for (int side = 0; side < 4; ++side) {
+		if (!(any & (1 << side)))
+			continue;
+		
+		int axis = side / 2;
+		float c = limits[side];
+		bool is_min = side % 2 == 0;
+		clip_plane(in, n, *out,
+			[in, axis, c, is_min](std::size_t i) { return is_min ? in[i][axis] >= c : in[i][axis] <= c; },
+			[in, axis, c](std::size_t a, std::size_t b) { return axis_intersect(in[a], in[b], axis, c); });
+		in = out->data();
+		n = out->size();
+		out = out == result ? &workspace->buffer : result;
+	}
+	if (in != result->data())
+		result->swap(workspace->buffer);
+}
+
+void glm_plus::clip_convex(const fvec2* vertices, std::size_t count, const fvec2* convex, std::size_t convex_count,
+		std::vector<fvec2>* result, clip_workspace* workspace) {
+	result->clear();
+	if (count == 0 || convex_count < 3)
+		return;
+	
+	const fvec2* in = vertices;
+	std::size_t n = count;
+	std::vector<fvec2>* out = &workspace->buffer;
+	for (std::size_t e = 0; e < convex_count; ++e) {
+		fvec2 a = convex[e];
+		fvec2 b = convex[e + 1 == convex_count ? 0 : e + 1];
+		float dx = b.x - a.x;
+		float dy = b.y - a.y;
+		
+		// Signed distances (scaled by edge length) of all vertices, in a vectorizable loop.
+		workspace->distances.resize(n);
+		float* d = workspace->distances.data();
+		const auto* v = reinterpret_cast<const float*>(in);
+		for (std::size_t i = 0; i < n; ++i)
+			d[i] = dx * (v[2 * i + 1] - a.y) - dy * (v[2 * i] - a.x);
+		
+		clip_plane(in, n, *out,
+			[d](std::size_t i) { return d[i] >= 0.0f; },
+			[in, d](std::size_t i, std::size_t j) {
+				// Interpolate from the inside point, so both directions of an edge give the same result.
+				if (d[i] < d[j])
+					std::swap(i, j);
+				float t = d[i] / (d[i] - d[j]);
+				return in[i] + (in[j] - in[i]) * t;
+			});
+		in = out->data();
+		n = out->size();
+		out = out == result ? &workspace->buffer : result;
+		if (n == 0)
+			break;
+	}
+	if (in != result->data())
+		result->swap(workspace->buffer);
+}
+
+void glm_plus::polygon_boolean(const polygon& subject, const polygon& clip, boolean_op op, polygon_list* result, clip_workspace* workspace) {
+	greiner_hormann gh(subject, clip, workspace->nodes);
+	gh.run(op, result);
+}
@@ -0,0 +1,108 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+/**
+ * @file clip.h
+ * This header contains functions for clipping polygons against rectangles and other polygons,
+ * and for boolean operations between polygons.
+ * Results are written to caller-provided vectors, and intermediate data is kept in a @ref clip_workspace.
+ * Reusing both between calls avoids heap allocations once they have grown to the working size.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "glm/gtc/type_precision.hpp"
+#include "polygon.h"
+#include "types.h"
+
+namespace glm_plus {
+
+namespace detail {
+
+/** Vertex of a polygon, linked with intersection vertices, used by @ref polygon_boolean. */
+struct clip_node {
+	glm::dvec2 p;
+	double alpha;
+	glm::dvec2 alpha_tie;
+	std::uint32_t next;
+	std::uint32_t prev;
+	std::uint32_t neighbor;
+	bool intersect;
+	bool entry;
+	bool visited;
+};
+
+}
+
+/**
+ * Reusable intermediate buffers for clipping functions.
+ * A workspace must not be used by multiple threads at once.
+ */
+struct clip_workspace {
+	std::vector<glm::fvec2> buffer;
+	std::vector<std::uint8_t> codes;
+	std::vector<float> distances;
+	std::vector<detail::clip_node> nodes;
+};
+
+/**
+ * Boolean operation between two polygons.
+ */
+enum class boolean_op {
+	/** Area inside both polygons. */
+	intersection,
+	/** Area inside any of the polygons. */
+	union_,
+	/** Area inside the subject polygon, but outside the clip polygon. */
+	difference
+};
+
+/**
+ * Clips a polygon to an axis-aligned rectangle.
+ * Uses the Sutherland-Hodgman algorithm. Polygons entirely inside or outside the rectangle are detected
+ * with a single vectorized pass of outcodes, and only rectangle sides crossed by the polygon are clipped against.
+ * Concave polygons, which leave and re-enter the rectangle, stay connected along the rectangle border.
+ * @param vertices Polygon vertices.
+ * @param count Number of vertices.
+ * @param bounds Rectangle to clip to.
+ * @param result Clipped polygon. Empty if the polygon is outside the rectangle. Previous contents are replaced.
+ * @param workspace Intermediate buffers.
+ */
+void clip(const glm::fvec2* vertices, std::size_t count, const farea& bounds, std::vector<glm::fvec2>* result, clip_workspace* workspace);
+
+/**
+ * Clips a polygon to a convex polygon.
+ * Uses the Sutherland-Hodgman algorithm, same as @ref clip with a rectangle.
+ * @param vertices Polygon vertices.
+ * @param count Number of vertices.
+ * @param convex Vertices of the convex polygon to clip to, running counter-clockwise like the result of @ref convex_hull.
+ * @param convex_count Number of vertices of the convex polygon.
+ * @param result Clipped polygon. Previous contents are replaced.
+ * @param workspace Intermediate buffers.
+ */
+void clip_convex(const glm::fvec2* vertices, std::size_t count, const glm::fvec2* convex, std::size_t convex_count,
+		std::vector<glm::fvec2>* result, clip_workspace* workspace);
+
+/**
+ * Calculates a boolean operation between two simple polygons.
+ * Uses the Greiner-Hormann algorithm, which runs in O(n * m) for polygons with n and m vertices.
+ * Configurations where a vertex lies on an edge of the other polygon are detected with exact orientation predicates,
+ * and resolved consistently as if the clip polygon was moved by an infinitesimal amount.
+ * Rings without area, which this leaves between overlapping edges, are not returned.
+ * Outer rings run in the same direction as the subject polygon. Holes, which occur with @ref boolean_op::difference
+ * when the clip polygon is strictly inside the subject, and with @ref boolean_op::union_ when the polygons enclose an area together,
+ * are returned as separate polygons running in the opposite direction.
+ * @param subject Subject polygon.
+ * @param clip Clip polygon.
+ * @param op Operation.
+ * @param result Resulting polygons. Previous contents are replaced.
+ * @param workspace Intermediate buffers.
+ */
+void polygon_boolean(const polygon& subject, const polygon& clip, boolean_op op, polygon_list* result, clip_workspace* workspace);
+
+}
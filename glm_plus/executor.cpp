@@ -0,0 +1,136 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "executor.h"
+
+#include <algorithm>
+
+using namespace glm_plus;
+
+namespace {
+
+// Smallest automatic chunk, below which scheduling costs more than the work.
+constexpr std::size_t min_auto_chunk = 1024;
+
+// Chunks per thread with automatic chunk sizes, which leaves room for balancing.
+constexpr std::size_t chunks_per_thread = 8;
+
+// Queue of the current thread, if it is a worker of the executor.
+thread_local const void* current_executor = nullptr;
+thread_local std::size_t current_queue = 0;
+
+}
+
+executor::executor(unsigned thread_count) {
+	if (thread_count == 0)
+		thread_count = std::max(1u, std::thread::hardware_concurrency());
+	for (unsigned i = 0; i < thread_count; ++i)
+		queues.push_back(std::make_unique<queue>());
+	for (unsigned i = 1; i < thread_count; ++i)
+		threads.emplace_back(&executor::work, this, i);
+}
+
+executor::~executor() {
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (std::thread& t : threads)
+		t.join();
+}
+
+executor& executor::get_default() {
+	static executor instance;
+	return instance;
+}
+
+void executor::run(std::size_t count, std::size_t chunk_size, chunk_function fn, const void* context) {
+	if (count == 0)
+		return;
+	if (chunk_size == 0) {
+		chunk_size = std::max(min_auto_chunk, count / (get_thread_count() * chunks_per_thread));
+		chunk_size = (chunk_size + 63) & ~std::size_t(63);
+	}
+	std::size_t chunks = (count + chunk_size - 1) / chunk_size;
+	if (chunks == 1 || threads.empty()) {
+		fn(context, 0, count);
+		return;
+	}
+
+	job j;
+	j.fn = fn;
+	j.context = context;
+	j.remaining = chunks;
+
+	// Neighboring chunks go to the same queue, so each thread starts with a contiguous part of the range.
+	std::size_t own = current_executor == this ? current_queue : 0;
+	for (std::size_t q = 0; q < queues.size(); ++q) {
+		std::size_t target = (own + q) % queues.size();
+		std::size_t first = chunks * q / queues.size();
+		std::size_t last = chunks * (q + 1) / queues.size();
+		if (first == last)
+			continue;
+		std::lock_guard<std::mutex> lock(queues[target]->mutex);
+		for (std::size_t c = last; c-- > first;)
+			queues[target]->tasks.push_back({&j, c * chunk_size, std::min(count, (c + 1) * chunk_size)});
+		pending += last - first;
+	}
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+	}
+	wake.notify_all();
+
+	// Help until no work is left, then wait for chunks that are still running on other threads.
+	task t;
+	while (find_task(own, &t))
+		execute(t);
+	std::unique_lock<std::mutex> lock(j.mutex);
+	j.done.wait(lock, [&j] { return j.remaining == 0; });
+}
+
+bool executor::find_task(std::size_t own, task* result) {
+	for (std::size_t i = 0; i < queues.size(); ++i) {
+		queue& q = *queues[(own + i) % queues.size()];
+		std::lock_guard<std::mutex> lock(q.mutex);
+		if (q.tasks.empty())
+			continue;
+		if (i == 0) {
+			*result = q.tasks.back();
+			q.tasks.pop_back();
+		}
+		else {
+			*result = q.tasks.front();
+			q.tasks.pop_front();
+		}
+		--pending;
+		return true;
+	}
+	return false;
+}
+
+void executor::execute(const task& t) {
+	t.owner->fn(t.owner->context, t.begin, t.end);
+	// The job lives on the stack of the thread that started it, so it is only touched under its lock,
+	// which the starting thread takes once more before returning.
+	std::lock_guard<std::mutex> lock(t.owner->mutex);
+	if (--t.owner->remaining == 0)
+		t.owner->done.notify_all();
+}
+
+void executor::work(std::size_t index) {
+	current_executor = this;
+	current_queue = index;
+	task t;
+	while (true) {
+		if (find_task(index, &t)) {
+			execute(t);
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(sleep_mutex);
+		wake.wait(lock, [this] { return stopping || pending > 0; });
+		if (stopping && pending == 0)
+			return;
+	}
+}
@@ -0,0 +1,109 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+/**
+ * @file executor.h
+ * This header contains a thread pool, which runs index ranges in parallel.
+ * Parallel versions of batched functions, built on top of it, are in @ref parallel.h.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace glm_plus {
+
+/**
+ * Thread pool with work stealing.
+ * Each thread has its own queue of chunks. Threads take chunks from the back of their own queue,
+ * and when it is empty, steal chunks from the front of other queues, so uneven work is balanced automatically.
+ * The calling thread works on its own job too, and helps with other jobs while it waits, so nested calls do not deadlock.
+ * Functions run on the pool must not throw.
+ */
+class executor {
+public:
+	/**
+	 * Starts worker threads.
+	 * @param thread_count Number of threads working on a job, including the calling thread.
+	 * Zero uses the number of hardware threads.
+	 */
+	explicit executor(unsigned thread_count = 0);
+
+	executor(const executor&) = delete;
+	executor& operator=(const executor&) = delete;
+
+	/**
+	 * Waits for queued chunks to finish and stops worker threads.
+	 */
+	~executor();
+
+	/** Number of threads working on a job, including the calling thread. */
+	[[nodiscard]] unsigned get_thread_count() const { return static_cast<unsigned>(threads.size() + 1); }
+
+	/**
+	 * Calls a function for consecutive chunks of an index range, in parallel. Returns when all chunks are done.
+	 * Chunks are called in no particular order, so results should be written to separate places,
+	 * for example to the same indices of an output array, which makes them independent of thread timing.
+	 * @param count Size of the index range, starting at 0.
+	 * @param chunk_size Number of indices per chunk, except the last one.
+	 * Zero chooses a size that gives every thread several chunks, which is always a multiple of 64.
+	 * @param fn Function, called as <tt>fn(begin, end)</tt> for each chunk.
+	 */
+	template<typename F>
+	void parallel_for(std::size_t count, std::size_t chunk_size, F&& fn) {
+		run(count, chunk_size, [](const void* context, std::size_t begin, std::size_t end) {
+			(*static_cast<const std::remove_reference_t<F>*>(context))(begin, end);
+		}, &fn);
+	}
+
+	/**
+	 * Returns an executor shared by the whole process, which uses all hardware threads.
+	 */
+	static executor& get_default();
+
+private:
+	typedef void (*chunk_function)(const void* context, std::size_t begin, std::size_t end);
+
+	struct job {
+		chunk_function fn;
+		const void* context;
+		std::size_t remaining;
+		std::mutex mutex;
+		std::condition_variable done;
+	};
+
+	struct task {
+		job* owner;
+		std::size_t begin;
+		std::size_t end;
+	};
+
+	struct queue {
+		std::mutex mutex;
+		std::deque<task> tasks;
+	};
+
+	void run(std::size_t count, std::size_t chunk_size, chunk_function fn, const void* context);
+	bool find_task(std::size_t own, task* result);
+	static void execute(const task& t);
+	void work(std::size_t index);
+
+	// Queue 0 is used by threads outside of the pool, worker i uses queue i + 1.
+	std::vector<std::unique_ptr<queue>> queues;
+	std::vector<std::thread> threads;
+	std::atomic<std::size_t> pending{0};
+	std::mutex sleep_mutex;
+	std::condition_variable wake;
+	bool stopping = false;
+};
+
+}
@@ -0,0 +1,235 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "hull.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "predicates.h"
+
+using namespace glm_plus;
+using namespace glm;
+
+namespace {
+
+// Chunks smaller than this are not worth a separate task.
+constexpr std::size_t min_chunk_size = 1 << 15;
+
+bool point_less(fvec2 a, fvec2 b) {
+	return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+// Monotone chain over points, which are sorted and deduplicated in place.
+template<typename Vector>
+void monotone_chain(fvec2* points, std::size_t count, Vector* result) {
+	std::sort(points, points + count, point_less);
+	count = static_cast<std::size_t>(std::unique(points, points + count) - points);
+
+	result->clear();
+	if (count < 3) {
+		result->assign(points, points + count);
+		return;
+	}
+
+	Vector& h = *result;
+	h.resize(2 * count);
+	std::size_t k = 0;
+	for (std::size_t i = 0; i < count; ++i) {
+		while (k >= 2 && orient2d(h[k - 2], h[k - 1], points[i]) <= 0.0)
+			--k;
+		h[k++] = points[i];
+	}
+	std::size_t lower = k + 1;
+	for (std::size_t i = count - 1; i-- > 0;) {
+		while (k >= lower && orient2d(h[k - 2], h[k - 1], points[i]) <= 0.0)
+			--k;
+		h[k++] = points[i];
+	}
+	// Last point is the same as the first one.
+	h.resize(k - 1);
+}
+
+// Extreme points in 8 directions.
+struct extremes {
+	fvec2 points[8];
+};
+
+// Directions are ordered counter-clockwise, starting at the bottom.
+float extreme_key(fvec2 p, int direction) {
+	switch (direction) {
+		case 0: return -p.y;
+		case 1: return p.x - p.y;
+		case 2: return p.x;
+		case 3: return p.x + p.y;
+		case 4: return p.y;
+		case 5: return p.y - p.x;
+		case 6: return -p.x;
+		default: return -p.x - p.y;
+	}
+}
+
+extremes find_extremes(const fvec2* points, std::size_t count) {
+	extremes e;
+	for (fvec2& p : e.points)
+		p = points[0];
+	for (std::size_t i = 1; i < count; ++i) {
+		for (int d = 0; d < 8; ++d) {
+			if (extreme_key(points[i], d) > extreme_key(e.points[d], d))
+				e.points[d] = points[i];
+		}
+	}
+	return e;
+}
+
+// Check if the point is certainly strictly left of the line, using the error bound of the double precision determinant.
+// Uncertain points are kept, which is always safe, since the final hull is calculated with exact tests.
+bool certainly_left(fvec2 a, fvec2 b, fvec2 p) {
+	constexpr double epsilon = 1.1102230246251565e-16;
+	constexpr double error_bound = (3.0 + 16.0 * epsilon) * epsilon;
+	double left = (static_cast<double>(a.x) - p.x) * (static_cast<double>(b.y) - p.y);
+	double right = (static_cast<double>(a.y) - p.y) * (static_cast<double>(b.x) - p.x);
+	double det = left - right;
+	return det > error_bound * (std::abs(left) + std::abs(right));
+}
+
+// Both kept and result have enough capacity reserved, so they do not allocate.
+void chunk_hull(const fvec2* points, std::size_t count, const arena_vector<fvec2>& filter, arena_vector<fvec2>* kept, arena_vector<fvec2>* result) {
+	for (std::size_t i = 0; i < count; ++i) {
+		fvec2 p = points[i];
+		bool inside = filter.size() >= 3;
+		for (std::size_t j = 0, n = filter.size(); inside && j < n; ++j)
+			inside = certainly_left(filter[j], filter[j + 1 == n ? 0 : j + 1], p);
+		if (!inside)
+			kept->push_back(p);
+	}
+	monotone_chain(kept->data(), kept->size(), result);
+}
+
+}
+
+void glm_plus::convex_hull(const fvec2* points, std::size_t count, std::vector<fvec2>* result, arena* scratch) {
+	arena_scope scope(scratch);
+	arena_vector<fvec2> sorted(points, points + count, arena_allocator<fvec2>(scratch));
+	monotone_chain(sorted.data(), sorted.size(), result);
+}
+
+void glm_plus::convex_hull(executor& pool, const fvec2* points, std::size_t count, std::vector<fvec2>* result, arena* scratch) {
+	std::size_t chunks = std::max<std::size_t>(1, std::min<std::size_t>(pool.get_thread_count(), count / min_chunk_size));
+	if (count == 0) {
+		result->clear();
+		return;
+	}
+
+	auto chunk_begin = [count, chunks](std::size_t c) { return count * c / chunks; };
+	auto run = [&pool, chunks](auto&& fn) {
+		pool.parallel_for(chunks, 1, [&fn](std::size_t begin, std::size_t end) {
+			for (std::size_t c = begin; c < end; ++c)
+				fn(c);
+		});
+	};
+
+	// Every buffer is allocated up front, so tasks do not touch the arena.
+	arena_scope scope(scratch);
+	arena_allocator<fvec2> alloc(scratch);
+	arena_vector<extremes> chunk_extremes(chunks, extremes(), arena_allocator<extremes>(scratch));
+	run([&](std::size_t c) {
+		chunk_extremes[c] = find_extremes(points + chunk_begin(c), chunk_begin(c + 1) - chunk_begin(c));
+	});
+
+	arena_vector<fvec2> filter_points(alloc);
+	filter_points.reserve(8 * chunks);
+	for (const extremes& e : chunk_extremes)
+		filter_points.insert(filter_points.end(), std::begin(e.points), std::end(e.points));
+	arena_vector<fvec2> filter(alloc);
+	filter.reserve(2 * filter_points.size());
+	monotone_chain(filter_points.data(), filter_points.size(), &filter);
+
+	arena_vector<arena_vector<fvec2>> kept(chunks, arena_vector<fvec2>(alloc), arena_allocator<arena_vector<fvec2>>(scratch));
+	arena_vector<arena_vector<fvec2>> chunk_hulls(chunks, arena_vector<fvec2>(alloc), arena_allocator<arena_vector<fvec2>>(scratch));
+	for (std::size_t c = 0; c < chunks; ++c) {
+		kept[c].reserve(chunk_begin(c + 1) - chunk_begin(c));
+		chunk_hulls[c].reserve(2 * (chunk_begin(c + 1) - chunk_begin(c)));
+	}
+	run([&](std::size_t c) {
+		chunk_hull(points + chunk_begin(c), chunk_begin(c + 1) - chunk_begin(c), filter, &kept[c], &chunk_hulls[c]);
+	});
+
+	std::size_t merged_count = 0;
+	for (const arena_vector<fvec2>& h : chunk_hulls)
+		merged_count += h.size();
+	arena_vector<fvec2> merged(alloc);
+	merged.reserve(merged_count);
+	for (const arena_vector<fvec2>& h : chunk_hulls)
+		merged.insert(merged.end(), h.begin(), h.end());
+	monotone_chain(merged.data(), merged.size(), result);
+}
+
+bool incremental_hull::contains(fvec2 x) const {
+	std::size_t n = vertices.size();
+	if (n < 3) {
+		for (std::size_t i = 0; i < n; ++i) {
+			if (vertices[i] == x)
+				return true;
+		}
+		// On the segment between two vertices.
+		return n == 2 && orient2d(vertices[0], vertices[1], x) == 0.0
+			&& std::min(vertices[0].x, vertices[1].x) <= x.x && x.x <= std::max(vertices[0].x, vertices[1].x)
+			&& std::min(vertices[0].y, vertices[1].y) <= x.y && x.y <= std::max(vertices[0].y, vertices[1].y);
+	}
+
+	// Find the triangle of the fan from the first vertex, which contains the point.
+	fvec2 v0 = vertices[0];
+	if (orient2d(v0, vertices[1], x) < 0.0 || orient2d(v0, vertices[n - 1], x) > 0.0)
+		return false;
+	std::size_t lo = 1;
+	std::size_t hi = n - 1;
+	while (hi - lo > 1) {
+		std::size_t mid = (lo + hi) / 2;
+		if (orient2d(v0, vertices[mid], x) >= 0.0)
+			lo = mid;
+		else
+			hi = mid;
+	}
+	return orient2d(vertices[lo], vertices[hi], x) >= 0.0;
+}
+
+bool incremental_hull::insert(fvec2 x) {
+	if (contains(x))
+		return false;
+
+	std::size_t n = vertices.size();
+	if (n < 3) {
+		scratch.assign(vertices.begin(), vertices.end());
+		scratch.push_back(x);
+		monotone_chain(scratch.data(), scratch.size(), &vertices);
+		return true;
+	}
+
+	// Edges, which see the point, form a single chain. Edges collinear with the point are included,
+	// so vertices, which would become collinear, are removed.
+	auto visible = [this, n, x](std::size_t i) { return orient2d(vertices[i], vertices[(i + 1) % n], x) <= 0.0; };
+	std::size_t first = 0;
+	while (!(visible(first) && !visible((first + n - 1) % n)))
+		++first;
+	std::size_t last = first;
+	while (visible((last + 1) % n))
+		last = (last + 1) % n;
+
+	// Keep vertices from the end of the chain around to its start, then add the point.
+	scratch.clear();
+	for (std::size_t i = (last + 1) % n;; i = (i + 1) % n) {
+		scratch.push_back(vertices[i]);
+		if (i == first)
+			break;
+	}
+	scratch.push_back(x);
+	vertices.swap(scratch);
+	return true;
+}
+
+void incremental_hull::insert(const fvec2* points, std::size_t count) {
+	for (std::size_t i = 0; i < count; ++i)
+		insert(points[i]);
+}
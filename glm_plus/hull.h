@@ -0,0 +1,92 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+/**
+ * @file hull.h
+ * This header contains functions for calculating convex hulls of point sets.
+ * Hull vertices run counter-clockwise in a coordinate system with y pointing up,
+ * so @ref orient2d of any three consecutive vertices is positive.
+ * Collinear and duplicate points are not included in the hull.
+ * Orientation tests are exact, see @ref predicates.h.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "arena.h"
+#include "executor.h"
+#include "glm/gtc/type_precision.hpp"
+
+namespace glm_plus {
+
+/**
+ * Calculates the convex hull of a set of points.
+ * Uses Andrew's monotone chain algorithm, which runs in O(n log n).
+ * The first vertex is the point with the smallest x (and smallest y among those).
+ * @param points Points.
+ * @param count Number of points.
+ * @param result Hull vertices. Previous contents are replaced.
+ * @param scratch Arena for the sorted copy of points, 8 bytes per point. Heap is used if @c nullptr.
+ */
+void convex_hull(const glm::fvec2* points, std::size_t count, std::vector<glm::fvec2>* result, arena* scratch = nullptr);
+
+/**
+ * Calculates the convex hull of a large set of points, using multiple threads.
+ * Points are split into chunks, one per thread of the executor, processed in parallel.
+ * First, points that are certainly inside a polygon spanned by the extreme points in 8 directions are discarded,
+ * which removes most points of dense clouds. Then each chunk calculates its own hull,
+ * and the hull of those is the result.
+ * The result is the same as with the single-threaded version.
+ * @param pool Executor to run on.
+ * @param points Points.
+ * @param count Number of points.
+ * @param result Hull vertices. Previous contents are replaced.
+ * @param scratch Arena for intermediate buffers, up to 24 bytes per point. Heap is used if @c nullptr.
+ */
+void convex_hull(executor& pool, const glm::fvec2* points, std::size_t count, std::vector<glm::fvec2>* result, arena* scratch = nullptr);
+
+/**
+ * Convex hull, which is updated as points are inserted.
+ * Points inside the hull are rejected in O(log h) for a hull with h vertices,
+ * other points update the hull in O(h).
+ * Vertices run counter-clockwise, but the first vertex is not necessarily the same as with @ref convex_hull.
+ */
+class incremental_hull {
+public:
+	/**
+	 * Inserts a point.
+	 * @param x Point.
+	 * @return @c True if the hull changed, @c false if the point is inside or on the hull.
+	 */
+	bool insert(glm::fvec2 x);
+
+	/**
+	 * Inserts many points.
+	 * @param points Points.
+	 * @param count Number of points.
+	 */
+	void insert(const glm::fvec2* points, std::size_t count);
+
+	/**
+	 * Check if a point is inside or on the hull.
+	 * @param x Point.
+	 * @return @c True if the point is inside or on the hull, @c false otherwise.
+	 */
+	[[nodiscard]] bool contains(glm::fvec2 x) const;
+
+	/**
+	 * Removes all points.
+	 */
+	void clear() { vertices.clear(); }
+
+	[[nodiscard]] const std::vector<glm::fvec2>& get_vertices() const { return vertices; }
+
+private:
+	std::vector<glm::fvec2> vertices;
+	std::vector<glm::fvec2> scratch;
+};
+
+}
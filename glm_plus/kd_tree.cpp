@@ -0,0 +1,349 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "kd_tree.h"
+
+#include <algorithm>
+#include <utility>
+
+using namespace glm_plus;
+using namespace glm;
+
+namespace {
+
+constexpr std::size_t leaf_size = 8;
+
+// Ranges are halved at each level, so trees of up to 2^32 points are at most 32 levels deep.
+// The search stack holds at most one range per level.
+constexpr std::size_t max_depth = 32;
+
+struct search_range {
+	std::size_t begin;
+	std::size_t end;
+	// Squared distance from the query point to the split plane, which bounds the distance to all points in the range.
+	float bound;
+};
+
+// Orders by distance, then by index, so the point with the smallest index is preferred among equally close points.
+bool closer(const kd_neighbor& a, const kd_neighbor& b) {
+	return a.distance2 < b.distance2 || (a.distance2 == b.distance2 && a.id < b.id);
+}
+
+const kd_neighbor missing = {kd_tree::none, std::numeric_limits<float>::infinity()};
+
+// Orders build items by position, then by index, so coincident points are next to each other, with the smallest index first.
+template<typename Item>
+bool position_less(const Item& a, const Item& b) {
+	if (a.p.x != b.p.x)
+		return a.p.x < b.p.x;
+	if (a.p.y != b.p.y)
+		return a.p.y < b.p.y;
+	return a.id < b.id;
+}
+
+// Sorts build items by position. Chunks are sorted in parallel, then merged in pairs, level by level.
+// The order is total, so the result is the same as with a single sort.
+template<typename Item>
+void parallel_sort(executor& pool, arena_vector<Item>& items) {
+	std::size_t count = items.size();
+	std::size_t chunk_size = std::max<std::size_t>(1024, count / (static_cast<std::size_t>(pool.get_thread_count()) * 4) + 1);
+	pool.parallel_for(count, chunk_size, [&items](std::size_t begin, std::size_t end) {
+		std::sort(items.begin() + static_cast<std::ptrdiff_t>(begin), items.begin() + static_cast<std::ptrdiff_t>(end), position_less<Item>);
+	});
+
+	arena_vector<Item> merged(count, Item(), items.get_allocator());
+	for (std::size_t width = chunk_size; width < count; width *= 2) {
+		std::size_t pairs = (count + 2 * width - 1) / (2 * width);
+		pool.parallel_for(pairs, 1, [&items, &merged, width, count](std::size_t begin, std::size_t end) {
+			for (std::size_t i = begin; i < end; ++i) {
+				auto first = items.begin() + static_cast<std::ptrdiff_t>(i * 2 * width);
+				auto mid = items.begin() + static_cast<std::ptrdiff_t>(std::min(i * 2 * width + width, count));
+				auto last = items.begin() + static_cast<std::ptrdiff_t>(std::min(i * 2 * width + 2 * width, count));
+				std::merge(first, mid, mid, last, merged.begin() + static_cast<std::ptrdiff_t>(i * 2 * width), position_less<Item>);
+			}
+		});
+		items.swap(merged);
+	}
+}
+
+}
+
+constexpr std::uint32_t kd_tree::none;
+
+void kd_tree::build(const fvec2* points, std::size_t count, arena* scratch) {
+	arena_scope scope(scratch);
+	arena_vector<build_item> items(count, build_item(), arena_allocator<build_item>(scratch));
+	for (std::size_t i = 0; i < count; ++i)
+		items[i] = {points[i], static_cast<std::uint32_t>(i)};
+	std::sort(items.begin(), items.end(), position_less<build_item>);
+	arena_allocator<std::uint32_t> alloc(scratch);
+	arena_vector<std::uint32_t> sorted_ids(alloc);
+	arena_vector<std::uint32_t> starts(alloc);
+	merge_coincident(items, &sorted_ids, &starts);
+
+	axes.assign(items.size(), 0);
+	build_subtree(items, 0, items.size());
+	store(items, sorted_ids, starts);
+}
+
+void kd_tree::build(executor& pool, const fvec2* points, std::size_t count, arena* scratch) {
+	// Buffers are only allocated by the calling thread, so tasks do not touch the arena.
+	arena_scope scope(scratch);
+	arena_vector<build_item> items(count, build_item(), arena_allocator<build_item>(scratch));
+	pool.parallel_for(count, 0, [&items, points](std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; ++i)
+			items[i] = {points[i], static_cast<std::uint32_t>(i)};
+	});
+	parallel_sort(pool, items);
+	arena_allocator<std::uint32_t> alloc(scratch);
+	arena_vector<std::uint32_t> sorted_ids(alloc);
+	arena_vector<std::uint32_t> starts(alloc);
+	merge_coincident(items, &sorted_ids, &starts);
+	axes.assign(items.size(), 0);
+
+	// Ranges of a level are disjoint, so they can be split at the same time.
+	typedef std::pair<std::size_t, std::size_t> range;
+	std::size_t subtrees = static_cast<std::size_t>(pool.get_thread_count()) * 8;
+	arena_allocator<range> range_alloc(scratch);
+	arena_vector<range> level(range_alloc);
+	arena_vector<range> next(range_alloc);
+	// Each level at most doubles, so the last one has fewer than 2 * subtrees ranges.
+	level.reserve(2 * subtrees);
+	next.reserve(2 * subtrees);
+	level.emplace_back(0, items.size());
+	while (level.size() < subtrees) {
+		pool.parallel_for(level.size(), 1, [this, &items, &level](std::size_t begin, std::size_t end) {
+			for (std::size_t i = begin; i < end; ++i) {
+				if (level[i].second - level[i].first > leaf_size)
+					split(items, level[i].first, level[i].second);
+			}
+		});
+		next.clear();
+		for (const auto& r : level) {
+			if (r.second - r.first <= leaf_size)
+				continue;
+			std::size_t mid = r.first + (r.second - r.first) / 2;
+			next.emplace_back(r.first, mid);
+			next.emplace_back(mid + 1, r.second);
+		}
+		level.swap(next);
+		if (level.empty())
+			break;
+	}
+
+	pool.parallel_for(level.size(), 1, [this, &items, &level](std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; ++i)
+			build_subtree(items, level[i].first, level[i].second);
+	});
+	store(items, sorted_ids, starts);
+}
+
+void kd_tree::merge_coincident(arena_vector<build_item>& items, arena_vector<std::uint32_t>* sorted_ids, arena_vector<std::uint32_t>* starts) {
+	// Items are sorted by position, so coincident points are consecutive. Each group is replaced by one item,
+	// whose id is the index of the group, and the indices of its points are kept in order.
+	sorted_ids->resize(items.size());
+	starts->clear();
+	starts->reserve(items.size() + 1);
+	std::size_t groups = 0;
+	for (std::size_t i = 0; i < items.size(); ++i) {
+		(*sorted_ids)[i] = items[i].id;
+		if (i != 0 && items[i].p == items[groups - 1].p)
+			continue;
+		starts->push_back(static_cast<std::uint32_t>(i));
+		items[groups] = {items[i].p, static_cast<std::uint32_t>(groups)};
+		++groups;
+	}
+	starts->push_back(static_cast<std::uint32_t>(items.size()));
+	items.resize(groups);
+}
+
+void kd_tree::split(arena_vector<build_item>& items, std::size_t begin, std::size_t end) {
+	fvec2 lo = items[begin].p;
+	fvec2 hi = lo;
+	for (std::size_t i = begin + 1; i < end; ++i) {
+		lo = min(lo, items[i].p);
+		hi = max(hi, items[i].p);
+	}
+	int axis = hi.y - lo.y > hi.x - lo.x ? 1 : 0;
+	std::size_t mid = begin + (end - begin) / 2;
+	std::nth_element(items.begin() + static_cast<std::ptrdiff_t>(begin), items.begin() + static_cast<std::ptrdiff_t>(mid),
+		items.begin() + static_cast<std::ptrdiff_t>(end), [axis](const build_item& a, const build_item& b) {
+			return a.p[axis] < b.p[axis];
+		});
+	axes[mid] = static_cast<std::uint8_t>(axis);
+}
+
+void kd_tree::build_subtree(arena_vector<build_item>& items, std::size_t begin, std::size_t end) {
+	while (end - begin > leaf_size) {
+		split(items, begin, end);
+		std::size_t mid = begin + (end - begin) / 2;
+		build_subtree(items, begin, mid);
+		begin = mid + 1;
+	}
+}
+
+void kd_tree::store(const arena_vector<build_item>& items, const arena_vector<std::uint32_t>& sorted_ids, const arena_vector<std::uint32_t>& starts) {
+	xs.resize(items.size());
+	ys.resize(items.size());
+	ids.resize(items.size());
+	for (std::size_t i = 0; i < items.size(); ++i) {
+		xs[i] = items[i].p.x;
+		ys[i] = items[i].p.y;
+		ids[i] = sorted_ids[starts[items[i].id]];
+	}
+
+	// Without coincident points, queries skip the duplicate lists.
+	duplicate_offsets.clear();
+	duplicates.clear();
+	if (items.size() == sorted_ids.size())
+		return;
+	duplicate_offsets.resize(items.size() + 1);
+	duplicates.reserve(sorted_ids.size() - items.size());
+	for (std::size_t i = 0; i < items.size(); ++i) {
+		duplicate_offsets[i] = static_cast<std::uint32_t>(duplicates.size());
+		duplicates.insert(duplicates.end(), sorted_ids.begin() + starts[items[i].id] + 1, sorted_ids.begin() + starts[items[i].id + 1]);
+	}
+	duplicate_offsets[items.size()] = static_cast<std::uint32_t>(duplicates.size());
+}
+
+// Calls visit(position, distance2) for merged points in tree order, skipping ranges farther than the bound.
+// The function returns the new bound, which can only shrink.
+template<typename Visit>
+void kd_tree::search(fvec2 query, float bound, Visit&& visit) const {
+	if (xs.empty())
+		return;
+
+	search_range stack[max_depth + 1];
+	std::size_t top = 0;
+	stack[top++] = {0, xs.size(), 0.0f};
+	while (top != 0) {
+		search_range r = stack[--top];
+		if (r.bound > bound)
+			continue;
+
+		std::size_t begin = r.begin;
+		std::size_t end = r.end;
+		while (end - begin > leaf_size) {
+			std::size_t mid = begin + (end - begin) / 2;
+			float dx = xs[mid] - query.x;
+			float dy = ys[mid] - query.y;
+			bound = visit(mid, dx * dx + dy * dy);
+
+			// Points of the far half are at least as far from the query point as the split plane.
+			float d = axes[mid] == 0 ? dx : dy;
+			float plane_bound = d * d;
+			if (d > 0.0f) {
+				if (plane_bound <= bound)
+					stack[top++] = {mid + 1, end, plane_bound};
+				end = mid;
+			} else {
+				if (plane_bound <= bound)
+					stack[top++] = {begin, mid, plane_bound};
+				begin = mid + 1;
+			}
+		}
+		for (std::size_t i = begin; i < end; ++i) {
+			float dx = xs[i] - query.x;
+			float dy = ys[i] - query.y;
+			bound = visit(i, dx * dx + dy * dy);
+		}
+	}
+}
+
+bool kd_tree::nearest(fvec2 query, kd_neighbor* result, float max_distance) const {
+	kd_neighbor best = {none, max_distance * max_distance};
+	search(query, best.distance2, [this, &best](std::size_t i, float distance2) {
+		kd_neighbor candidate = {ids[i], distance2};
+		if (closer(candidate, best))
+			best = candidate;
+		return best.distance2;
+	});
+	if (best.id == none)
+		return false;
+	*result = best;
+	return true;
+}
+
+void kd_tree::k_nearest(fvec2 query, std::size_t k, std::vector<kd_neighbor>* result) const {
+	// Max-heap of the closest points found so far, with the farthest one on top.
+	std::vector<kd_neighbor>& heap = *result;
+	heap.clear();
+	if (k == 0)
+		return;
+	search(query, std::numeric_limits<float>::infinity(), [this, k, &heap](std::size_t i, float distance2) {
+		// Indices of merged points increase, so once one of them is not closer, the rest are not either.
+		std::uint32_t j = duplicates.empty() ? 0 : duplicate_offsets[i];
+		std::uint32_t end = duplicates.empty() ? 0 : duplicate_offsets[i + 1];
+		for (std::uint32_t id = ids[i];; id = duplicates[j++]) {
+			kd_neighbor candidate = {id, distance2};
+			if (heap.size() < k) {
+				heap.push_back(candidate);
+				std::push_heap(heap.begin(), heap.end(), closer);
+			} else if (closer(candidate, heap.front())) {
+				std::pop_heap(heap.begin(), heap.end(), closer);
+				heap.back() = candidate;
+				std::push_heap(heap.begin(), heap.end(), closer);
+			} else {
+				break;
+			}
+			if (j == end)
+				break;
+		}
+		return heap.size() < k ? std::numeric_limits<float>::infinity() : heap.front().distance2;
+	});
+	std::sort_heap(heap.begin(), heap.end(), closer);
+}
+
+void kd_tree::radius_search(fvec2 query, float radius, std::vector<std::uint32_t>* result) const {
+	float radius2 = radius * radius;
+	search(query, radius2, [this, radius2, result](std::size_t i, float distance2) {
+		if (distance2 <= radius2) {
+			result->push_back(ids[i]);
+			if (!duplicates.empty())
+				result->insert(result->end(), duplicates.begin() + duplicate_offsets[i], duplicates.begin() + duplicate_offsets[i + 1]);
+		}
+		return radius2;
+	});
+}
+
+void kd_tree::nearest(const fvec2* queries, std::size_t count, kd_neighbor* result, float max_distance) const {
+	for (std::size_t i = 0; i < count; ++i) {
+		if (!nearest(queries[i], result + i, max_distance))
+			result[i] = missing;
+	}
+}
+
+void kd_tree::nearest(executor& pool, const fvec2* queries, std::size_t count, kd_neighbor* result, float max_distance) const {
+	pool.parallel_for(count, 0, [=](std::size_t begin, std::size_t end) {
+		nearest(queries + begin, end - begin, result + begin, max_distance);
+	});
+}
+
+void kd_tree::k_nearest(const fvec2* queries, std::size_t count, std::size_t k, kd_neighbor* result) const {
+	// The heap is shared by all queries, so it is only allocated once.
+	std::vector<kd_neighbor> heap;
+	heap.reserve(k);
+	for (std::size_t i = 0; i < count; ++i) {
+		k_nearest(queries[i], k, &heap);
+		kd_neighbor* out = std::copy(heap.begin(), heap.end(), result + i * k);
+		std::fill(out, result + (i + 1) * k, missing);
+	}
+}
+
+void kd_tree::k_nearest(executor& pool, const fvec2* queries, std::size_t count, std::size_t k, kd_neighbor* result) const {
+	pool.parallel_for(count, 0, [=](std::size_t begin, std::size_t end) {
+		k_nearest(queries + begin, end - begin, k, result + begin * k);
+	});
+}
+
+void kd_tree::radius_search(const fvec2* queries, std::size_t count, float radius,
+		std::vector<std::uint32_t>* offsets, std::vector<std::uint32_t>* found) const {
+	offsets->resize(count + 1);
+	found->clear();
+	(*offsets)[0] = 0;
+	for (std::size_t i = 0; i < count; ++i) {
+		radius_search(queries[i], radius, found);
+		(*offsets)[i + 1] = static_cast<std::uint32_t>(found->size());
+	}
+}
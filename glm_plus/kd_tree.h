@@ -0,0 +1,173 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+/**
+ * @file kd_tree.h
+ * This header contains a static k-d tree for nearest neighbour and radius queries over points.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "arena.h"
+#include "executor.h"
+#include "glm/gtc/type_precision.hpp"
+#include "util.h"
+
+namespace glm_plus {
+
+/**
+ * Point found by a @ref kd_tree query.
+ */
+struct kd_neighbor {
+	/** Index of the point in the array the tree was built from, or @ref kd_tree::none. */
+	std::uint32_t id;
+	/** Squared distance from the query point. */
+	float distance2;
+};
+
+/**
+ * Static k-d tree over points.
+ * The tree has an implicit layout without pointers: points are reordered so that the node of each range of points
+ * is its middle point, which splits the rest of the range in two halves along the axis with the larger extent.
+ * Ranges of at most 8 points are leaves, which are scanned linearly.
+ * Coincident points are merged into one node when the tree is built, so inputs with many duplicates, like snapped or welded vertices,
+ * do not make queries scan them all. Queries run in O(log n) for typical inputs and use a fixed-size stack, so they do not allocate,
+ * except for their results.
+ * If several points are at the same distance from a query point, the one with the smallest index is preferred.
+ */
+class kd_tree {
+public:
+	/** Id of a missing point. */
+	static constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+
+	kd_tree() = default;
+
+	/**
+	 * Builds the tree. Previous contents are replaced.
+	 * @param points Points.
+	 * @param count Number of points.
+	 * @param scratch Arena for temporary buffers while building, about 20 bytes per point. Heap is used if @c nullptr.
+	 */
+	void build(const glm::fvec2* points, std::size_t count, arena* scratch = nullptr);
+
+	/**
+	 * Builds the tree on multiple threads. The result is the same as with the single-threaded version.
+	 * Ranges of upper levels are split in parallel, level by level, until there are enough of them
+	 * to build the rest of each as an independent subtree.
+	 * @param pool Executor to run on.
+	 * @param points Points.
+	 * @param count Number of points.
+	 * @param scratch Arena for temporary buffers while building, about 32 bytes per point. Heap is used if @c nullptr.
+	 */
+	void build(executor& pool, const glm::fvec2* points, std::size_t count, arena* scratch = nullptr);
+
+	[[nodiscard]] std::size_t size() const { return ids.size() + duplicates.size(); }
+	[[nodiscard]] bool empty() const { return ids.empty(); }
+
+	/**
+	 * Finds the point closest to a query point.
+	 * @param query Query point.
+	 * @param result Found point. Left unchanged if no point is found.
+	 * @param max_distance Only points within this distance are found.
+	 * @return @c True if a point was found, @c false otherwise.
+	 */
+	bool nearest(glm::fvec2 query, kd_neighbor* result, float max_distance = std::numeric_limits<float>::infinity()) const;
+
+	/**
+	 * Finds the points closest to a query point.
+	 * @param query Query point.
+	 * @param k Maximum number of points to find.
+	 * @param result Found points, sorted by increasing distance. Previous contents are replaced.
+	 * Contains fewer than @p k points if the tree is smaller.
+	 */
+	void k_nearest(glm::fvec2 query, std::size_t k, std::vector<kd_neighbor>* result) const;
+
+	/**
+	 * Finds all points overlapping a query point, using the same test as @ref is_overlapping.
+	 * @param query Query point.
+	 * @param radius Maximum distance. Points at exactly this distance are included.
+	 * @param result Indices of found points are appended to this vector, in no particular order.
+	 */
+	void radius_search(glm::fvec2 query, float radius, std::vector<std::uint32_t>* result) const;
+
+	/**
+	 * Finds the point closest to each of many query points.
+	 * Query points close to each other should be close in the array too, so that they visit the same nodes while they are in cache.
+	 * @param queries Query points.
+	 * @param count Number of query points.
+	 * @param result Found point for each query point. Points not found have id @ref none and infinite distance.
+	 * @param max_distance Only points within this distance are found.
+	 */
+	void nearest(const glm::fvec2* queries, std::size_t count, kd_neighbor* result, float max_distance = std::numeric_limits<float>::infinity()) const;
+
+	/**
+	 * Parallel version of the batched @ref nearest.
+	 * @param pool Executor to run on.
+	 */
+	void nearest(executor& pool, const glm::fvec2* queries, std::size_t count, kd_neighbor* result,
+		float max_distance = std::numeric_limits<float>::infinity()) const;
+
+	/**
+	 * Finds the points closest to each of many query points.
+	 * @param queries Query points.
+	 * @param count Number of query points.
+	 * @param k Number of points to find for each query point.
+	 * @param result <tt>count * k</tt> points, @p k for each query point, sorted by increasing distance.
+	 * If the tree has fewer than @p k points, the rest have id @ref none and infinite distance.
+	 */
+	void k_nearest(const glm::fvec2* queries, std::size_t count, std::size_t k, kd_neighbor* result) const;
+
+	/**
+	 * Parallel version of the batched @ref k_nearest.
+	 * @param pool Executor to run on.
+	 */
+	void k_nearest(executor& pool, const glm::fvec2* queries, std::size_t count, std::size_t k, kd_neighbor* result) const;
+
+	/**
+	 * Finds all points overlapping each of many query points.
+	 * @param queries Query points.
+	 * @param count Number of query points.
+	 * @param radius Maximum distance. Points at exactly this distance are included.
+	 * @param offsets <tt>count + 1</tt> offsets into @p found, points found for query @c i are in <tt>[offsets[i], offsets[i + 1])</tt>.
+	 * Previous contents are replaced.
+	 * @param found Indices of found points. Previous contents are replaced.
+	 */
+	void radius_search(const glm::fvec2* queries, std::size_t count, float radius,
+		std::vector<std::uint32_t>* offsets, std::vector<std::uint32_t>* found) const;
+
+private:
+	struct build_item {
+		glm::fvec2 p;
+		std::uint32_t id;
+	};
+
+	void split(arena_vector<build_item>& items, std::size_t begin, std::size_t end);
+	void build_subtree(arena_vector<build_item>& items, std::size_t begin, std::size_t end);
+	void merge_coincident(arena_vector<build_item>& items, arena_vector<std::uint32_t>* sorted_ids, arena_vector<std::uint32_t>* starts);
+	void store(const arena_vector<build_item>& items, const arena_vector<std::uint32_t>& sorted_ids, const arena_vector<std::uint32_t>& starts);
+
+	template<typename Visit>
+	void search(glm::fvec2 query, float bound, Visit&& visit) const;
+
+	/** Coordinates of merged points, in tree order. */
+	std::vector<float> xs;
+	std::vector<float> ys;
+	/** Smallest original index of the points merged at each position, in tree order. */
+	std::vector<std::uint32_t> ids;
+	/**
+	 * Other original indices of the points merged at each position are in <tt>[duplicate_offsets[i], duplicate_offsets[i + 1])</tt>
+	 * of @ref duplicates, in increasing order. Both are empty if there are no coincident points.
+	 */
+	std::vector<std::uint32_t> duplicate_offsets;
+	std::vector<std::uint32_t> duplicates;
+	/** Split axis of the node at each position, 0 for x and 1 for y. Unused for points in leaves. */
+	std::vector<std::uint8_t> axes;
+};
+
+}
@@ -6,10 +6,14 @@
  * @file line.h
  * This header contains functions for calculating relations between lines and other geometric primitives,
  * such as distances, intersections, collisions...
+ * All functions are templated on the scalar type @c T of their coordinates.
+ * The library is compiled with @c float and @c double versions,
+ * use @c double for large coordinates, where @c float loses too much precision.
+ * Default margins depend on the scalar type, see @ref tiny_margin_v.
+ * When @c GLM_PLUS_HEADER_ONLY is defined, all functions are defined inline,
+ * and those which do not depend on square roots are also @c constexpr.
  */
 
-// TODO: Most of these functions could be constexpr.
-
 #pragma once
 
 #include "glm/gtc/type_precision.hpp"
@@ -17,6 +21,48 @@
 
 namespace glm_plus {
 
+/**
+ * Line through two points, with derived values precomputed for repeated queries against a line that does not change.
+ * Functions in this header have overloads, which take it instead of the two points.
+ * It is used both as a line and as a line segment between its points, in the same way as two points are used by the other functions.
+ * Overloads of functions with square roots or normalization avoid them, so their results may differ by a rounding error,
+ * the rest give the same results as the versions taking points.
+ */
+template<typename T>
+struct line2 {
+	/** First point. */
+	glm::vec<2, T> p1;
+	/** Second point. */
+	glm::vec<2, T> p2;
+	/** Difference <tt>p2 - p1</tt>. */
+	glm::vec<2, T> delta;
+	/** Unit vector from @ref p1 to @ref p2, zero if they are equal. */
+	glm::vec<2, T> direction;
+	/**
+	 * Unit normal of the implicit form, zero if the points are equal.
+	 * Signed distance of a point @c x is <tt>dot(normal, x) + c</tt>, see @ref dist_to_line_signed.
+	 */
+	glm::vec<2, T> normal;
+	/** Constant term of the implicit form. */
+	T c;
+	/** Squared length of @ref delta. */
+	T length2;
+	/** Length of @ref delta. */
+	T length;
+
+	line2() = default;
+
+	/**
+	 * Precomputes a line.
+	 * @param a1 First point on the line.
+	 * @param a2 Second point on the line.
+	 */
+	line2(glm::vec<2, T> a1, glm::vec<2, T> a2);
+};
+
+typedef line2<float> fline2;
+typedef line2<double> dline2;
+
 /**
  * Calculates point to line distance.
  * The line is defined by 2 points, running in the direction from first to second.
@@ -26,7 +72,8 @@ namespace glm_plus {
  * @param a2 Second point on the line.
  * @return Point to line distance.
  */
-float dist_to_line_signed(glm::fvec2 x, glm::fvec2 a1, glm::fvec2 a2);
+template<typename T>
+GLM_PLUS_INLINE T dist_to_line_signed(glm::vec<2, T> x, glm::vec<2, T> a1, glm::vec<2, T> a2);
 
 /**
  * Finds point on the line, closest to a point.
@@ -35,7 +82,38 @@ float dist_to_line_signed(glm::fvec2 x, glm::fvec2 a1, glm::fvec2 a2);
  * @param a2 Second point on the line.
  * @return Point on the line closest to @p x.
  */
-glm::fvec2 closest_point_on_line(glm::fvec2 x, glm::fvec2 a1, glm::fvec2 a2);
+template<typename T>
+GLM_PLUS_INLINE glm::vec<2, T> closest_point_on_line(glm::vec<2, T> x, glm::vec<2, T> a1, glm::vec<2, T> a2);
+
+/**
+ * Finds the parameter of the point on the line segment, closest to a point.
+ * @param x Point to test.
+ * @param a1 First line segment point.
+ * @param a2 Second line segment point.
+ * @return Parameter of the closest point, from 0 at @p a1 to 1 at @p a2. Zero-length line segments return 0.
+ */
+template<typename T>
+GLM_PLUS_CONSTEXPR T closest_param_on_line_segment(glm::vec<2, T> x, glm::vec<2, T> a1, glm::vec<2, T> a2);
+
+/**
+ * Finds point on the line segment, closest to a point.
+ * @param x Point to test.
+ * @param a1 First line segment point.
+ * @param a2 Second line segment point.
+ * @return Point on the line segment closest to @p x.
+ */
+template<typename T>
+GLM_PLUS_CONSTEXPR glm::vec<2, T> closest_point_on_line_segment(glm::vec<2, T> x, glm::vec<2, T> a1, glm::vec<2, T> a2);
+
+/**
+ * Calculates point to line segment distance.
+ * @param x Point to test.
+ * @param a1 First line segment point.
+ * @param a2 Second line segment point.
+ * @return Distance from @p x to the closest point on the line segment.
+ */
+template<typename T>
+GLM_PLUS_INLINE T dist_to_line_segment(glm::vec<2, T> x, glm::vec<2, T> a1, glm::vec<2, T> a2);
 
 /**
  * Check if the point is in the strip.
@@ -46,18 +124,20 @@ glm::fvec2 closest_point_on_line(glm::fvec2 x, glm::fvec2 a1, glm::fvec2 a2);
  * @param p2 Second strip limit point.
  * @return @c True if the point is between the two points, @c false otherwise.
  */
-bool is_between_two_points(glm::fvec2 x, glm::fvec2 p1, glm::fvec2 p2);
+template<typename T>
+GLM_PLUS_CONSTEXPR bool is_between_two_points(glm::vec<2, T> x, glm::vec<2, T> p1, glm::vec<2, T> p2);
 
 /**
  * Check if the point is right of or on the line.
  * The line is defined by 2 points, running in the direction from first to second.
  * @warning If the point is exactly on the line, the result may be incorrect due to rounding error.
- * Consider using @ref right_of_line_with_margin.
+ * Consider using @ref right_of_line_with_margin, or @ref is_right_of_line_exact from predicates.h.
  * @param x Point to test.
  * @param a1 First point on the line.
  * @param a2 Second point on the line.
  */
-bool is_right_of_line(glm::fvec2 x, glm::fvec2 a1, glm::fvec2 a2);
+template<typename T>
+GLM_PLUS_CONSTEXPR bool is_right_of_line(glm::vec<2, T> x, glm::vec<2, T> a1, glm::vec<2, T> a2);
 
 /**
  * Check if the point is right of the line with margin.
@@ -71,7 +151,8 @@ bool is_right_of_line(glm::fvec2 x, glm::fvec2 a1, glm::fvec2 a2);
  * @param margin Max distance from the line. Positive values make the function more strict, negative values make it less strict.
  * @return @c True if the point is right of the line with margin, @c false otherwise.
  */
-bool is_right_of_line_with_margin(glm::fvec2 x, glm::fvec2 a1, glm::fvec2 a2, float margin = tiny_margin);
+template<typename T>
+GLM_PLUS_INLINE bool is_right_of_line_with_margin(glm::vec<2, T> x, glm::vec<2, T> a1, glm::vec<2, T> a2, type_identity_t<T> margin = tiny_margin_v<T>);
 
 /**
  * Check if the point is inside a section, constructed from two lines (arms) which share a center point.
@@ -84,7 +165,8 @@ bool is_right_of_line_with_margin(glm::fvec2 x, glm::fvec2 a1, glm::fvec2 a2, fl
  * @param b Point on the second section arm.
  * @return @c True if the point is inside the section, @c false otherwise.
  */
-bool is_inside_section(glm::fvec2 x, glm::fvec2 center, glm::fvec2 a, glm::fvec2 b);
+template<typename T>
+GLM_PLUS_CONSTEXPR bool is_inside_section(glm::vec<2, T> x, glm::vec<2, T> center, glm::vec<2, T> a, glm::vec<2, T> b);
 
 /**
  * Check if the point is inside a section, constructed from two lines (arms) which share a center point with margin.
@@ -96,7 +178,8 @@ bool is_inside_section(glm::fvec2 x, glm::fvec2 center, glm::fvec2 a, glm::fvec2
  * @param b Point on the second section arm.
  * @param margin Max distance from the section. Positive values make the function more strict, negative values make it less strict.
  */
-bool is_inside_section_with_margin(glm::fvec2 x, glm::fvec2 center, glm::fvec2 a, glm::fvec2 b, float margin = tiny_margin);
+template<typename T>
+GLM_PLUS_INLINE bool is_inside_section_with_margin(glm::vec<2, T> x, glm::vec<2, T> center, glm::vec<2, T> a, glm::vec<2, T> b, type_identity_t<T> margin = tiny_margin_v<T>);
 
 /**
  * Calculates the position where two lines intersect.
@@ -109,7 +192,8 @@ bool is_inside_section_with_margin(glm::fvec2 x, glm::fvec2 center, glm::fvec2 a
  * @param result Intersection point.
  * @return @c True if lines intersect, @c false if they are parallel.
  */
-bool lines_intersect(glm::fvec2 a1, glm::fvec2 a2, glm::fvec2 b1, glm::fvec2 b2, glm::vec2* result);
+template<typename T>
+GLM_PLUS_CONSTEXPR bool lines_intersect(glm::vec<2, T> a1, glm::vec<2, T> a2, glm::vec<2, T> b1, glm::vec<2, T> b2, glm::vec<2, T>* result);
 
 /**
  * Check if two lines segments intersect.
@@ -120,7 +204,25 @@ bool lines_intersect(glm::fvec2 a1, glm::fvec2 a2, glm::fvec2 b1, glm::fvec2 b2,
  * @param b4 Second line segment point.
  * @return @c True if lines coincide, @c false otherwise.
  */
-bool line_segments_intersect(glm::fvec2 a1, glm::fvec2 a2, glm::fvec2 b3, glm::fvec2 b4, glm::vec2* result);
+template<typename T>
+GLM_PLUS_CONSTEXPR bool line_segments_intersect(glm::vec<2, T> a1, glm::vec<2, T> a2, glm::vec<2, T> b3, glm::vec<2, T> b4, glm::vec<2, T>* result);
+
+/**
+ * Check if two line segments intersect, using their parametric form.
+ * The intersection point is <tt>a1 + (a2 - a1) * t</tt> and <tt>b1 + (b2 - b1) * u</tt>.
+ * Segments intersect if both @p t and @p u are within [0, 1], which is tested without branches.
+ * Parallel and coinciding segments do not intersect, and neither do segments with disjoint bounding boxes.
+ * Results may differ from @ref line_segments_intersect by a rounding error when the intersection is exactly at an end point.
+ * @param a1 First point of the first line segment.
+ * @param a2 Second point of the first line segment.
+ * @param b1 First point of the second line segment.
+ * @param b2 Second point of the second line segment.
+ * @param t Intersection parameter along the first line segment. Written even if segments do not intersect.
+ * @param u Intersection parameter along the second line segment. Written even if segments do not intersect.
+ * @return @c True if line segments intersect, @c false otherwise.
+ */
+template<typename T>
+GLM_PLUS_CONSTEXPR bool line_segments_intersect_parametric(glm::vec<2, T> a1, glm::vec<2, T> a2, glm::vec<2, T> b1, glm::vec<2, T> b2, T* t, T* u);
 
 /**
  * Checks if a horizontal ray (running in positive x direction) intersects a line segment.
@@ -129,20 +231,23 @@ bool line_segments_intersect(glm::fvec2 a1, glm::fvec2 a2, glm::fvec2 b3, glm::f
  * @param a2 Second point of the line segment.
  * @return @c True if the ray intersects the line segment, @c false otherwise.
  */
-bool horizontal_ray_line_segment_intersect(glm::fvec2 ray_start, glm::fvec2 a1, glm::fvec2 a2);
+template<typename T>
+GLM_PLUS_CONSTEXPR bool horizontal_ray_line_segment_intersect(glm::vec<2, T> ray_start, glm::vec<2, T> a1, glm::vec<2, T> a2);
 
 /**
  * Check if two lines coincide (overlap).
  * There is a small leeway, which is necessary due to rounding errors,
  * which means that two lines that are very very nearly but not quite coincident
  * might still return @c true.
+ * The margin does not scale with coordinate magnitude, see @ref lines_coincide_exact for an exact test.
  * @param a1 First point on the first line.
  * @param a2 Second point on the first line.
  * @param b1 First point on the second line.
  * @param b2 Second point on the second line.
  * @return @c True if lines coincide, @c false otherwise.
  */
-bool lines_coincide(glm::fvec2 a1, glm::fvec2 a2, glm::fvec2 b1, glm::fvec2 b2, float margin = tiny_margin);
+template<typename T>
+GLM_PLUS_CONSTEXPR bool lines_coincide(glm::vec<2, T> a1, glm::vec<2, T> a2, glm::vec<2, T> b1, glm::vec<2, T> b2, type_identity_t<T> margin = tiny_margin_v<T>);
 
 /**
  * Check if two line segments coincide.
@@ -153,7 +258,8 @@ bool lines_coincide(glm::fvec2 a1, glm::fvec2 a2, glm::fvec2 b1, glm::fvec2 b2,
  * @param b2 Second point of the second line segment.
  * @return @c True if line segments coincide, @c false otherwise.
  */
-bool line_segments_coincide(glm::fvec2 a1, glm::fvec2 a2, glm::fvec2 b1, glm::fvec2 b2);
+template<typename T>
+GLM_PLUS_INLINE bool line_segments_coincide(glm::vec<2, T> a1, glm::vec<2, T> a2, glm::vec<2, T> b1, glm::vec<2, T> b2);
 
 /**
  * Check if a line intersects a circle.
@@ -166,7 +272,8 @@ bool line_segments_coincide(glm::fvec2 a1, glm::fvec2 a2, glm::fvec2 b1, glm::fv
  * @param result Intersection point.
  * @return \c True if line and circle intersect, \c false otherwise.
  */
-bool line_circle_intersect(glm::fvec2 center, float r, glm::fvec2 a1, glm::fvec2 a2, glm::fvec2* result);
+template<typename T>
+GLM_PLUS_INLINE bool line_circle_intersect(glm::vec<2, T> center, type_identity_t<T> r, glm::vec<2, T> a1, glm::vec<2, T> a2, glm::vec<2, T>* result);
 
 /**
  * Check if a line segment intersects a circle.
@@ -179,6 +286,144 @@ bool line_circle_intersect(glm::fvec2 center, float r, glm::fvec2 a1, glm::fvec2
  * @param result Intersection point.
  * @return \c True if line segment and circle intersect, \c false otherwise.
  */
-bool line_segment_circle_intersect(glm::fvec2 center, float r, glm::fvec2 a1, glm::fvec2 a2, glm::fvec2* result);
+template<typename T>
+GLM_PLUS_INLINE bool line_segment_circle_intersect(glm::vec<2, T> center, type_identity_t<T> r, glm::vec<2, T> a1, glm::vec<2, T> a2, glm::vec<2, T>* result);
+
+/**
+ * Finds the time of impact of a moving circle with a line segment.
+ * The circle moves from @p center to <tt>center + velocity</tt> during the time interval [0, 1].
+ * A circle, which already touches the line segment, hits it at time 0, unless it is moving away from it or along it.
+ * A circle centered on the line segment always hits it at time 0, with the normal of the line segment facing against the motion.
+ * @param center Circle center at time 0.
+ * @param r Circle radius.
+ * @param velocity Displacement of the circle during the time interval.
+ * @param a1 First line segment point.
+ * @param a2 Second line segment point.
+ * @param t Time of the first contact.
+ * @param normal Unit contact normal, pointing from the line segment towards the circle center.
+ * @return \c True if the circle hits the line segment, \c false otherwise, in which case no outputs are written.
+ */
+template<typename T>
+GLM_PLUS_INLINE bool moving_circle_line_segment_impact(glm::vec<2, T> center, type_identity_t<T> r, glm::vec<2, T> velocity,
+		glm::vec<2, T> a1, glm::vec<2, T> a2, T* t, glm::vec<2, T>* normal);
+
+/**
+ * Finds the time of impact of two moving circles.
+ * Circles move from their centers by their velocities during the time interval [0, 1].
+ * Circles, which already touch, hit at time 0, unless they are moving apart.
+ * @param center1 Center of the first circle at time 0.
+ * @param r1 Radius of the first circle.
+ * @param velocity1 Displacement of the first circle during the time interval.
+ * @param center2 Center of the second circle at time 0.
+ * @param r2 Radius of the second circle.
+ * @param velocity2 Displacement of the second circle during the time interval.
+ * @param t Time of the first contact.
+ * @param normal Unit contact normal, pointing from the second circle towards the first one.
+ * @return \c True if the circles hit, \c false otherwise, in which case no outputs are written.
+ */
+template<typename T>
+GLM_PLUS_INLINE bool moving_circles_impact(glm::vec<2, T> center1, type_identity_t<T> r1, glm::vec<2, T> velocity1,
+		glm::vec<2, T> center2, type_identity_t<T> r2, glm::vec<2, T> velocity2, T* t, glm::vec<2, T>* normal);
+
+/**
+ * Finds the time of impact of a moving line segment with a static line segment.
+ * The moving line segment is translated by @p velocity during the time interval [0, 1], without rotating.
+ * The first contact is always at an end point of one of the segments.
+ * Line segments, which already intersect or touch, hit at time 0.
+ * @param a1 First point of the moving line segment at time 0.
+ * @param a2 Second point of the moving line segment at time 0.
+ * @param velocity Displacement of the moving line segment during the time interval.
+ * @param b1 First point of the static line segment.
+ * @param b2 Second point of the static line segment.
+ * @param t Time of the first contact.
+ * @param normal Unit contact normal, perpendicular to the segment hit by the other one's end point and facing against @p velocity.
+ * If both segments are parallel to @p velocity, it is the opposite direction of @p velocity.
+ * @return \c True if the line segments hit, \c false otherwise, in which case no outputs are written.
+ */
+template<typename T>
+GLM_PLUS_INLINE bool moving_line_segment_impact(glm::vec<2, T> a1, glm::vec<2, T> a2, glm::vec<2, T> velocity,
+		glm::vec<2, T> b1, glm::vec<2, T> b2, T* t, glm::vec<2, T>* normal);
+
+/** Version of @ref dist_to_line_signed for a precomputed line, without a square root. */
+template<typename T>
+GLM_PLUS_INLINE T dist_to_line_signed(glm::vec<2, T> x, const line2<T>& line);
+
+/** Version of @ref closest_point_on_line for a precomputed line, without normalization. */
+template<typename T>
+GLM_PLUS_INLINE glm::vec<2, T> closest_point_on_line(glm::vec<2, T> x, const line2<T>& line);
+
+/** Version of @ref closest_param_on_line_segment for a precomputed line segment. */
+template<typename T>
+GLM_PLUS_INLINE T closest_param_on_line_segment(glm::vec<2, T> x, const line2<T>& segment);
+
+/** Version of @ref closest_point_on_line_segment for a precomputed line segment. */
+template<typename T>
+GLM_PLUS_INLINE glm::vec<2, T> closest_point_on_line_segment(glm::vec<2, T> x, const line2<T>& segment);
+
+/** Version of @ref dist_to_line_segment for a precomputed line segment. */
+template<typename T>
+GLM_PLUS_INLINE T dist_to_line_segment(glm::vec<2, T> x, const line2<T>& segment);
+
+/** Version of @ref is_between_two_points for the points of a precomputed line. */
+template<typename T>
+GLM_PLUS_INLINE bool is_between_two_points(glm::vec<2, T> x, const line2<T>& line);
+
+/** Version of @ref is_right_of_line for a precomputed line. */
+template<typename T>
+GLM_PLUS_INLINE bool is_right_of_line(glm::vec<2, T> x, const line2<T>& line);
+
+/** Version of @ref is_right_of_line_with_margin for a precomputed line, without a square root. */
+template<typename T>
+GLM_PLUS_INLINE bool is_right_of_line_with_margin(glm::vec<2, T> x, const line2<T>& line, type_identity_t<T> margin = tiny_margin_v<T>);
+
+/** Version of @ref lines_intersect for precomputed lines. */
+template<typename T>
+GLM_PLUS_INLINE bool lines_intersect(const line2<T>& a, const line2<T>& b, glm::vec<2, T>* result);
+
+/** Version of @ref line_segments_intersect for precomputed line segments. */
+template<typename T>
+GLM_PLUS_INLINE bool line_segments_intersect(const line2<T>& a, const line2<T>& b, glm::vec<2, T>* result);
+
+/** Version of @ref line_segments_intersect_parametric for precomputed line segments. */
+template<typename T>
+GLM_PLUS_INLINE bool line_segments_intersect_parametric(const line2<T>& a, const line2<T>& b, T* t, T* u);
+
+/** Version of @ref horizontal_ray_line_segment_intersect for a precomputed line segment. */
+template<typename T>
+GLM_PLUS_INLINE bool horizontal_ray_line_segment_intersect(glm::vec<2, T> ray_start, const line2<T>& segment);
+
+/** Version of @ref lines_coincide for precomputed lines. */
+template<typename T>
+GLM_PLUS_INLINE bool lines_coincide(const line2<T>& a, const line2<T>& b, type_identity_t<T> margin = tiny_margin_v<T>);
+
+/** Version of @ref line_segments_coincide for precomputed line segments. */
+template<typename T>
+GLM_PLUS_INLINE bool line_segments_coincide(const line2<T>& a, const line2<T>& b);
+
+/** Version of @ref line_circle_intersect for a precomputed line, without normalization. */
+template<typename T>
+GLM_PLUS_INLINE bool line_circle_intersect(glm::vec<2, T> center, type_identity_t<T> r, const line2<T>& line, glm::vec<2, T>* result);
+
+/** Version of @ref line_segment_circle_intersect for a precomputed line segment, without normalization. */
+template<typename T>
+GLM_PLUS_INLINE bool line_segment_circle_intersect(glm::vec<2, T> center, type_identity_t<T> r, const line2<T>& segment, glm::vec<2, T>* result);
+
+/** Version of @ref moving_circle_line_segment_impact for a precomputed line segment. */
+template<typename T>
+GLM_PLUS_INLINE bool moving_circle_line_segment_impact(glm::vec<2, T> center, type_identity_t<T> r, glm::vec<2, T> velocity,
+		const line2<T>& segment, T* t, glm::vec<2, T>* normal);
+
+/** Version of @ref moving_line_segment_impact for a precomputed static line segment. */
+template<typename T>
+GLM_PLUS_INLINE bool moving_line_segment_impact(glm::vec<2, T> a1, glm::vec<2, T> a2, glm::vec<2, T> velocity,
+		const line2<T>& segment, T* t, glm::vec<2, T>* normal);
+
+}
+
+#include "line.inl"
 
-}
\ No newline at end of file
+// Unless in header-only mode, float and double versions are compiled only once, into the library.
+#ifndef GLM_PLUS_HEADER_ONLY
+GLM_PLUS_LINE_INSTANTIATE(extern, float);
+GLM_PLUS_LINE_INSTANTIATE(extern, double);
+#endif
\ No newline at end of file
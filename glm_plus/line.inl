@@ -0,0 +1,570 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+/**
+ * @file line.inl
+ * Definitions of functions declared in @ref line.h.
+ * Unless @c GLM_PLUS_HEADER_ONLY is defined, @c float and @c double versions are compiled into the library.
+ */
+
+#pragma once
+
+#include "line.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include "vector.h"
+#include "util.h"
+
+/**
+ * Declares (with @p prefix @c extern) or defines explicit instantiations of all functions in @ref line.h for scalar type @p T.
+ */
+#define GLM_PLUS_LINE_INSTANTIATE(prefix, T) \
+	prefix template T glm_plus::dist_to_line_signed<T>(glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>); \
+	prefix template glm::vec<2, T> glm_plus::closest_point_on_line<T>(glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>); \
+	prefix template T glm_plus::closest_param_on_line_segment<T>(glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>); \
+	prefix template glm::vec<2, T> glm_plus::closest_point_on_line_segment<T>(glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>); \
+	prefix template T glm_plus::dist_to_line_segment<T>(glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>); \
+	prefix template bool glm_plus::is_between_two_points<T>(glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>); \
+	prefix template bool glm_plus::is_right_of_line<T>(glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>); \
+	prefix template bool glm_plus::is_right_of_line_with_margin<T>(glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>, T); \
+	prefix template bool glm_plus::is_inside_section<T>(glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>); \
+	prefix template bool glm_plus::is_inside_section_with_margin<T>(glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>, T); \
+	prefix template bool glm_plus::lines_intersect<T>(glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>*); \
+	prefix template bool glm_plus::line_segments_intersect<T>(glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>*); \
+	prefix template bool glm_plus::line_segments_intersect_parametric<T>(glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>, T*, T*); \
+	prefix template bool glm_plus::horizontal_ray_line_segment_intersect<T>(glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>); \
+	prefix template bool glm_plus::lines_coincide<T>(glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>, T); \
+	prefix template bool glm_plus::line_segments_coincide<T>(glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>); \
+	prefix template bool glm_plus::line_circle_intersect<T>(glm::vec<2, T>, T, glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>*); \
+	prefix template bool glm_plus::line_segment_circle_intersect<T>(glm::vec<2, T>, T, glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>*); \
+	prefix template bool glm_plus::moving_circle_line_segment_impact<T>(glm::vec<2, T>, T, glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>, T*, glm::vec<2, T>*); \
+	prefix template bool glm_plus::moving_circles_impact<T>(glm::vec<2, T>, T, glm::vec<2, T>, glm::vec<2, T>, T, glm::vec<2, T>, T*, glm::vec<2, T>*); \
+	prefix template bool glm_plus::moving_line_segment_impact<T>(glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>, T*, glm::vec<2, T>*); \
+	prefix template struct glm_plus::line2<T>; \
+	prefix template T glm_plus::dist_to_line_signed<T>(glm::vec<2, T>, const line2<T>&); \
+	prefix template glm::vec<2, T> glm_plus::closest_point_on_line<T>(glm::vec<2, T>, const line2<T>&); \
+	prefix template T glm_plus::closest_param_on_line_segment<T>(glm::vec<2, T>, const line2<T>&); \
+	prefix template glm::vec<2, T> glm_plus::closest_point_on_line_segment<T>(glm::vec<2, T>, const line2<T>&); \
+	prefix template T glm_plus::dist_to_line_segment<T>(glm::vec<2, T>, const line2<T>&); \
+	prefix template bool glm_plus::is_between_two_points<T>(glm::vec<2, T>, const line2<T>&); \
+	prefix template bool glm_plus::is_right_of_line<T>(glm::vec<2, T>, const line2<T>&); \
+	prefix template bool glm_plus::is_right_of_line_with_margin<T>(glm::vec<2, T>, const line2<T>&, T); \
+	prefix template bool glm_plus::lines_intersect<T>(const line2<T>&, const line2<T>&, glm::vec<2, T>*); \
+	prefix template bool glm_plus::line_segments_intersect<T>(const line2<T>&, const line2<T>&, glm::vec<2, T>*); \
+	prefix template bool glm_plus::line_segments_intersect_parametric<T>(const line2<T>&, const line2<T>&, T*, T*); \
+	prefix template bool glm_plus::horizontal_ray_line_segment_intersect<T>(glm::vec<2, T>, const line2<T>&); \
+	prefix template bool glm_plus::lines_coincide<T>(const line2<T>&, const line2<T>&, T); \
+	prefix template bool glm_plus::line_segments_coincide<T>(const line2<T>&, const line2<T>&); \
+	prefix template bool glm_plus::line_circle_intersect<T>(glm::vec<2, T>, T, const line2<T>&, glm::vec<2, T>*); \
+	prefix template bool glm_plus::line_segment_circle_intersect<T>(glm::vec<2, T>, T, const line2<T>&, glm::vec<2, T>*); \
+	prefix template bool glm_plus::moving_circle_line_segment_impact<T>(glm::vec<2, T>, T, glm::vec<2, T>, const line2<T>&, T*, glm::vec<2, T>*); \
+	prefix template bool glm_plus::moving_line_segment_impact<T>(glm::vec<2, T>, glm::vec<2, T>, glm::vec<2, T>, const line2<T>&, T*, glm::vec<2, T>*)
+
+namespace glm_plus {
+
+template<typename T>
+GLM_PLUS_INLINE line2<T>::line2(glm::vec<2, T> a1, glm::vec<2, T> a2) : p1(a1), p2(a2), delta(a2 - a1) {
+	// Squared length uses the same operations as closest_param_on_line_segment, so segment overloads give the same results.
+	length2 = delta.x * delta.x + delta.y * delta.y;
+	length = std::sqrt(length2);
+	T inv_length = length > T(0) ? T(1) / length : T(0);
+	direction = delta * inv_length;
+	normal = glm::vec<2, T>(direction.y, -direction.x);
+	c = (delta.x * a1.y - delta.y * a1.x) * inv_length;
+}
+
+template<typename T>
+GLM_PLUS_INLINE T dist_to_line_signed(glm::vec<2, T> x, glm::vec<2, T> a1, glm::vec<2, T> a2) {
+	return ((a2.x - a1.x) * (a1.y - x.y) - (a1.x - x.x) * (a2.y -a1.y)) / std::sqrt(square(a2.x - a1.x) + square(a2.y - a1.y));
+}
+
+template<typename T>
+GLM_PLUS_INLINE glm::vec<2, T> closest_point_on_line(glm::vec<2, T> x, glm::vec<2, T> a1, glm::vec<2, T> a2) {
+	glm::vec<2, T> n12 = glm::normalize(a2 - a1);
+	T dist = glm::dot(glm::normalize(n12), x - a1);
+	return a1 + n12 * dist;
+}
+
+namespace detail {
+
+// Parameter of the point on a line segment, closest to x. Batched queries call this directly, since it is not instantiated
+// into the library, so it is inlined and their loops can be vectorized. Clamping the dot product instead of the parameter
+// avoids branches and gives the same result, since length2 / length2 is exactly 1. Zero-length segments give 0.
+template<typename T>
+GLM_PLUS_CONSTEXPR T closest_param(glm::vec<2, T> x, glm::vec<2, T> a1, glm::vec<2, T> a2) {
+	T dx = a2.x - a1.x;
+	T dy = a2.y - a1.y;
+	T length2 = dx * dx + dy * dy;
+	T dot = (x.x - a1.x) * dx + (x.y - a1.y) * dy;
+	dot = std::min(std::max(dot, T(0)), length2);
+	return dot / (length2 + static_cast<T>(length2 == T(0)));
+}
+
+}
+
+template<typename T>
+GLM_PLUS_CONSTEXPR T closest_param_on_line_segment(glm::vec<2, T> x, glm::vec<2, T> a1, glm::vec<2, T> a2) {
+	return detail::closest_param(x, a1, a2);
+}
+
+template<typename T>
+GLM_PLUS_CONSTEXPR glm::vec<2, T> closest_point_on_line_segment(glm::vec<2, T> x, glm::vec<2, T> a1, glm::vec<2, T> a2) {
+	T t = closest_param_on_line_segment(x, a1, a2);
+	return glm::vec<2, T>(a1.x + (a2.x - a1.x) * t, a1.y + (a2.y - a1.y) * t);
+}
+
+template<typename T>
+GLM_PLUS_INLINE T dist_to_line_segment(glm::vec<2, T> x, glm::vec<2, T> a1, glm::vec<2, T> a2) {
+	glm::vec<2, T> p = closest_point_on_line_segment(x, a1, a2);
+	return std::sqrt(square(x.x - p.x) + square(x.y - p.y));
+}
+
+template<typename T>
+GLM_PLUS_CONSTEXPR bool is_between_two_points(glm::vec<2, T> x, glm::vec<2, T> p1, glm::vec<2, T> p2) {
+	T ppx = p2.x - p1.x;
+	T ppy = p2.y - p1.y;
+	if ((x.x - p1.x) * ppx + (x.y - p1.y) * ppy < T(0))
+		return false;
+	ppx = p1.x - p2.x;
+	ppy = p1.y - p2.y;
+	if ((x.x - p2.x) * ppx + (x.y - p2.y) * ppy < T(0))
+		return false;
+	return true;
+}
+
+template<typename T>
+GLM_PLUS_CONSTEXPR bool is_right_of_line(glm::vec<2, T> x, glm::vec<2, T> a1, glm::vec<2, T> a2) {
+	T c = (a2.x - a1.x) * (x.y - a1.y) - (x.x - a1.x) * (a2.y - a1.y);
+	return c >= T(0);
+}
+
+template<typename T>
+GLM_PLUS_INLINE bool is_right_of_line_with_margin(glm::vec<2, T> x, glm::vec<2, T> a1, glm::vec<2, T> a2, type_identity_t<T> margin) {
+	return dist_to_line_signed(x, a1, a2) < -margin;
+}
+
+template<typename T>
+GLM_PLUS_CONSTEXPR bool is_inside_section(glm::vec<2, T> x, glm::vec<2, T> center, glm::vec<2, T> a, glm::vec<2, T> b) {
+	T c = (a.x - center.x) * (b.y - center.y) - (b.x - center.x) * (a.y - center.y);
+	return c >= T(0)
+		? is_right_of_line(x, a, center) || is_right_of_line(x, center, b)
+		: is_right_of_line(x, a, center) && is_right_of_line(x, center, b);
+}
+
+template<typename T>
+GLM_PLUS_INLINE bool is_inside_section_with_margin(glm::vec<2, T> x, glm::vec<2, T> center, glm::vec<2, T> a, glm::vec<2, T> b, type_identity_t<T> margin) {
+	T c = (a.x - center.x) * (b.y - center.y) - (b.x - center.x) * (a.y - center.y);
+	return c > T(0)
+		? is_right_of_line_with_margin(x, a, center, margin) || is_right_of_line_with_margin(x, center, b, margin)
+		: is_right_of_line_with_margin(x, a, center, margin) && is_right_of_line_with_margin(x, center, b, margin);
+}
+
+template<typename T>
+GLM_PLUS_CONSTEXPR bool lines_intersect(glm::vec<2, T> a1, glm::vec<2, T> a2, glm::vec<2, T> b1, glm::vec<2, T> b2, glm::vec<2, T>* result) {
+	T d3 = (a1.x - a2.x) * (b1.y - b2.y) - (b1.x - b2.x) * (a1.y - a2.y);
+	if (d3 == T(0))
+		return false;
+	
+	T d1 = a1.x * a2.y - a2.x * a1.y;
+	T d2 = b1.x * b2.y - b2.x * b1.y;
+	T dx = d1 * (b1.x - b2.x) - d2 * (a1.x - a2.x);
+	T dy = d1 * (b1.y - b2.y) - d2 * (a1.y - a2.y);
+	result->x = dx / d3;
+	result->y = dy / d3;
+	return true;
+}
+
+template<typename T>
+GLM_PLUS_CONSTEXPR bool line_segments_intersect(glm::vec<2, T> a1, glm::vec<2, T> a2, glm::vec<2, T> b1, glm::vec<2, T> b2, glm::vec<2, T>* result) {
+	return lines_intersect(a1, a2, b1, b2, result) && is_between_two_points(*result, a1, a2) && is_between_two_points(*result, b1, b2);
+}
+
+template<typename T>
+GLM_PLUS_CONSTEXPR bool line_segments_intersect_parametric(glm::vec<2, T> a1, glm::vec<2, T> a2, glm::vec<2, T> b1, glm::vec<2, T> b2, T* t, T* u) {
+	T rx = a2.x - a1.x;
+	T ry = a2.y - a1.y;
+	T sx = b2.x - b1.x;
+	T sy = b2.y - b1.y;
+	T dx = b1.x - a1.x;
+	T dy = b1.y - a1.y;
+	T denom = rx * sy - ry * sx;
+	T t_num = dx * sy - dy * sx;
+	T u_num = dx * ry - dy * rx;
+
+	// Flip signs, so both parameters can be compared to a positive denominator without dividing.
+	T sign = denom < T(0) ? T(-1) : T(1);
+	denom *= sign;
+	t_num *= sign;
+	u_num *= sign;
+	T safe_denom = denom != T(0) ? denom : T(1);
+	*t = t_num / safe_denom;
+	*u = u_num / safe_denom;
+
+	// Denominator of collinear segments is rounding noise, which could place them anywhere on the common line.
+	// Intersecting segments always have overlapping bounding boxes, which rules these out.
+	bool boxes = (std::min(a1.x, a2.x) <= std::max(b1.x, b2.x)) & (std::min(b1.x, b2.x) <= std::max(a1.x, a2.x))
+		& (std::min(a1.y, a2.y) <= std::max(b1.y, b2.y)) & (std::min(b1.y, b2.y) <= std::max(a1.y, a2.y));
+	return boxes & (denom != T(0)) & (t_num >= T(0)) & (t_num <= denom) & (u_num >= T(0)) & (u_num <= denom);
+}
+
+template<typename T>
+GLM_PLUS_CONSTEXPR bool horizontal_ray_line_segment_intersect(glm::vec<2, T> ray_start, glm::vec<2, T> a1, glm::vec<2, T> a2) {
+	glm::vec<2, T> top = a1.y > a2.y ? a1 : a2;
+	glm::vec<2, T> bottom = a1.y > a2.y ? a2 : a1;
+	
+	if (ray_start.y < bottom.y || ray_start.y > top.y)
+		return false;
+	
+	T f = (ray_start.y - bottom.y) / (top.y - bottom.y);
+	T x = f * (top.x - bottom.x) + bottom.x;
+	return x >= ray_start.x;
+}
+
+template<typename T>
+GLM_PLUS_CONSTEXPR bool lines_coincide(glm::vec<2, T> a1, glm::vec<2, T> a2, glm::vec<2, T> b1, glm::vec<2, T> b2, type_identity_t<T> margin) {
+	T d1 = (a1.x - a2.x) * (b1.y - b2.y) - (b1.x - b2.x) * (a1.y - a2.y);
+	T d2 = (a1.x - a2.x) * (a1.y - b1.y) - (a1.x - b1.x) * (a1.y - a2.y);
+	return (d1 < T(0) ? -d1 : d1) < margin && (d2 < T(0) ? -d2 : d2) < margin;
+}
+
+template<typename T>
+GLM_PLUS_INLINE bool line_segments_coincide(glm::vec<2, T> a1, glm::vec<2, T> a2, glm::vec<2, T> b1, glm::vec<2, T> b2) {
+	if (!lines_coincide(a1, a2, b1, b2))
+		return false;
+	
+	if (is_between_two_points(a1, b1, b2)) {
+		if (is_between_two_points(a2, b1, b2)) {
+			// Both points of section 1 are within section 2.
+			return true;
+		}
+		else {
+			if (is_overlapping(a1, b1) || is_overlapping(a1, b2)) {
+				// Section 1 head is touching section 2, not overlapping.
+				return false;
+			}
+			else {
+				// Section 1 head is overlapping section 2.
+				return true;
+			}
+		}
+	}
+	else if (is_between_two_points(a2, b1, b2)) {
+		if (is_overlapping(a2, b1) || is_overlapping(a2, b2)) {
+			// Section 1 tail is touching section 2, not overlapping.
+			return false;
+		}
+		else {
+			// Section 1 tail is overlapping section 2.
+			return true;
+		}
+	}
+	else if (is_between_two_points(b1, a1, a2)) {
+		// Section 2 is completely inside section 1.
+		return true;
+	}
+	else {
+		// Sections are not touching at all.
+		return false;
+	}
+}
+
+template<typename T>
+GLM_PLUS_INLINE bool line_circle_intersect(glm::vec<2, T> center, type_identity_t<T> r, glm::vec<2, T> a1, glm::vec<2, T> a2, glm::vec<2, T>* result) {
+	if (a1 == a2)
+		return false;
+	
+	glm::vec<2, T> closest_point = closest_point_on_line(center, a1, a2);
+	T dist2 = glm::distance2(closest_point, center);
+	if (dist2 > r * r)
+		return false;
+	
+	T dist_p = std::sqrt(r * r - dist2);
+	*result = closest_point + set_length(a1 - a2, dist_p);
+	return true;
+}
+
+template<typename T>
+GLM_PLUS_INLINE bool line_segment_circle_intersect(glm::vec<2, T> center, type_identity_t<T> r, glm::vec<2, T> a1, glm::vec<2, T> a2, glm::vec<2, T>* result) {
+	return line_circle_intersect(center, r, a1, a2, result) && is_between_two_points(*result, a1, a2);
+}
+
+namespace detail {
+
+// Point m + w * t reaches distance r from the origin, while approaching it.
+template<typename T>
+GLM_PLUS_INLINE bool moving_point_circle_impact(glm::vec<2, T> m, glm::vec<2, T> w, T r, T* t, glm::vec<2, T>* normal) {
+	T a = glm::dot(w, w);
+	T b = glm::dot(m, w);
+	if (b >= T(0))
+		return false;
+
+	T c = glm::dot(m, m) - r * r;
+	T time = T(0);
+	if (c > T(0)) {
+		T disc = b * b - a * c;
+		if (disc < T(0))
+			return false;
+		time = (-b - std::sqrt(disc)) / a;
+		if (time > T(1))
+			return false;
+	}
+
+	// Contact is at the center only for zero radius, then the normal follows the motion.
+	glm::vec<2, T> contact = m + w * time;
+	T length = glm::length(contact);
+	*t = time;
+	*normal = length > T(0) ? contact / length : -w / std::sqrt(a);
+	return true;
+}
+
+// Point p + w * t hits line segment q1, q2. Collinear segments are hit at their end point closest to p.
+template<typename T>
+GLM_PLUS_INLINE bool moving_point_line_segment_impact(glm::vec<2, T> p, glm::vec<2, T> w, glm::vec<2, T> q1, glm::vec<2, T> q2, T* t) {
+	glm::vec<2, T> e = q2 - q1;
+	glm::vec<2, T> f = q1 - p;
+	T denom = w.x * e.y - w.y * e.x;
+	T f_w = f.x * w.y - f.y * w.x;
+	if (denom != T(0)) {
+		T time = (f.x * e.y - f.y * e.x) / denom;
+		T u = f_w / denom;
+		if (time < T(0) || time > T(1) || u < T(0) || u > T(1))
+			return false;
+		*t = time;
+		return true;
+	}
+	T ww = glm::dot(w, w);
+	if (f_w != T(0) || ww == T(0))
+		return false;
+
+	T t1 = glm::dot(f, w) / ww;
+	T t2 = glm::dot(q2 - p, w) / ww;
+	T time = std::max(std::min(t1, t2), T(0));
+	if (time > std::max(t1, t2) || time > T(1))
+		return false;
+	*t = time;
+	return true;
+}
+
+// Unit normal of edge e facing against velocity w. Edges parallel to w face against it.
+template<typename T>
+GLM_PLUS_INLINE glm::vec<2, T> facing_normal(glm::vec<2, T> e, glm::vec<2, T> w) {
+	glm::vec<2, T> n(-e.y, e.x);
+	T dot = glm::dot(n, w);
+	T ww = glm::dot(w, w);
+	if (dot == T(0) && ww > T(0))
+		return -w / std::sqrt(ww);
+	T length = glm::length(n);
+	return length > T(0) ? (dot > T(0) ? -n : n) / length : n;
+}
+
+}
+
+template<typename T>
+GLM_PLUS_INLINE bool moving_circle_line_segment_impact(glm::vec<2, T> center, type_identity_t<T> r, glm::vec<2, T> velocity,
+		glm::vec<2, T> a1, glm::vec<2, T> a2, T* t, glm::vec<2, T>* normal) {
+	return moving_circle_line_segment_impact(center, r, velocity, line2<T>(a1, a2), t, normal);
+}
+
+template<typename T>
+GLM_PLUS_INLINE bool moving_circles_impact(glm::vec<2, T> center1, type_identity_t<T> r1, glm::vec<2, T> velocity1,
+		glm::vec<2, T> center2, type_identity_t<T> r2, glm::vec<2, T> velocity2, T* t, glm::vec<2, T>* normal) {
+	return detail::moving_point_circle_impact(center1 - center2, velocity1 - velocity2, T(r1 + r2), t, normal);
+}
+
+template<typename T>
+GLM_PLUS_INLINE bool moving_line_segment_impact(glm::vec<2, T> a1, glm::vec<2, T> a2, glm::vec<2, T> velocity,
+		glm::vec<2, T> b1, glm::vec<2, T> b2, T* t, glm::vec<2, T>* normal) {
+	T t_a, u_b;
+	if (line_segments_intersect_parametric(a1, a2, b1, b2, &t_a, &u_b)) {
+		*t = T(0);
+		*normal = detail::facing_normal(b2 - b1, velocity);
+		return true;
+	}
+
+	// End points of the moving segment hit the static one, and end points of the static segment hit the moving one
+	// when moving in the opposite direction.
+	glm::vec<2, T> starts[4] = {a1, a2, b1, b2};
+	glm::vec<2, T> velocities[4] = {velocity, velocity, -velocity, -velocity};
+	glm::vec<2, T> ends1[4] = {b1, b1, a1, a1};
+	glm::vec<2, T> ends2[4] = {b2, b2, a2, a2};
+	bool found = false;
+	T best_t = T(0);
+	std::size_t best = 0;
+	for (std::size_t i = 0; i < 4; ++i) {
+		T time;
+		if (detail::moving_point_line_segment_impact(starts[i], velocities[i], ends1[i], ends2[i], &time) && (!found || time < best_t)) {
+			found = true;
+			best_t = time;
+			best = i;
+		}
+	}
+	if (!found)
+		return false;
+	*t = best_t;
+	*normal = detail::facing_normal(ends2[best] - ends1[best], velocity);
+	return true;
+}
+
+template<typename T>
+GLM_PLUS_INLINE T dist_to_line_signed(glm::vec<2, T> x, const line2<T>& line) {
+	return line.normal.x * x.x + line.normal.y * x.y + line.c;
+}
+
+template<typename T>
+GLM_PLUS_INLINE glm::vec<2, T> closest_point_on_line(glm::vec<2, T> x, const line2<T>& line) {
+	return line.p1 + line.direction * glm::dot(line.direction, x - line.p1);
+}
+
+template<typename T>
+GLM_PLUS_INLINE T closest_param_on_line_segment(glm::vec<2, T> x, const line2<T>& segment) {
+	if (segment.length2 == T(0))
+		return T(0);
+	T t = ((x.x - segment.p1.x) * segment.delta.x + (x.y - segment.p1.y) * segment.delta.y) / segment.length2;
+	return t < T(0) ? T(0) : (t > T(1) ? T(1) : t);
+}
+
+template<typename T>
+GLM_PLUS_INLINE glm::vec<2, T> closest_point_on_line_segment(glm::vec<2, T> x, const line2<T>& segment) {
+	T t = closest_param_on_line_segment(x, segment);
+	return glm::vec<2, T>(segment.p1.x + segment.delta.x * t, segment.p1.y + segment.delta.y * t);
+}
+
+template<typename T>
+GLM_PLUS_INLINE T dist_to_line_segment(glm::vec<2, T> x, const line2<T>& segment) {
+	glm::vec<2, T> p = closest_point_on_line_segment(x, segment);
+	return std::sqrt(square(x.x - p.x) + square(x.y - p.y));
+}
+
+template<typename T>
+GLM_PLUS_INLINE bool is_between_two_points(glm::vec<2, T> x, const line2<T>& line) {
+	return is_between_two_points(x, line.p1, line.p2);
+}
+
+template<typename T>
+GLM_PLUS_INLINE bool is_right_of_line(glm::vec<2, T> x, const line2<T>& line) {
+	T c = line.delta.x * (x.y - line.p1.y) - (x.x - line.p1.x) * line.delta.y;
+	return c >= T(0);
+}
+
+template<typename T>
+GLM_PLUS_INLINE bool is_right_of_line_with_margin(glm::vec<2, T> x, const line2<T>& line, type_identity_t<T> margin) {
+	return dist_to_line_signed(x, line) < -margin;
+}
+
+template<typename T>
+GLM_PLUS_INLINE bool lines_intersect(const line2<T>& a, const line2<T>& b, glm::vec<2, T>* result) {
+	return lines_intersect(a.p1, a.p2, b.p1, b.p2, result);
+}
+
+template<typename T>
+GLM_PLUS_INLINE bool line_segments_intersect(const line2<T>& a, const line2<T>& b, glm::vec<2, T>* result) {
+	return line_segments_intersect(a.p1, a.p2, b.p1, b.p2, result);
+}
+
+template<typename T>
+GLM_PLUS_INLINE bool line_segments_intersect_parametric(const line2<T>& a, const line2<T>& b, T* t, T* u) {
+	return line_segments_intersect_parametric(a.p1, a.p2, b.p1, b.p2, t, u);
+}
+
+template<typename T>
+GLM_PLUS_INLINE bool horizontal_ray_line_segment_intersect(glm::vec<2, T> ray_start, const line2<T>& segment) {
+	return horizontal_ray_line_segment_intersect(ray_start, segment.p1, segment.p2);
+}
+
+template<typename T>
+GLM_PLUS_INLINE bool lines_coincide(const line2<T>& a, const line2<T>& b, type_identity_t<T> margin) {
+	return lines_coincide(a.p1, a.p2, b.p1, b.p2, margin);
+}
+
+template<typename T>
+GLM_PLUS_INLINE bool line_segments_coincide(const line2<T>& a, const line2<T>& b) {
+	return line_segments_coincide(a.p1, a.p2, b.p1, b.p2);
+}
+
+template<typename T>
+GLM_PLUS_INLINE bool line_circle_intersect(glm::vec<2, T> center, type_identity_t<T> r, const line2<T>& line, glm::vec<2, T>* result) {
+	if (line.length2 == T(0))
+		return false;
+
+	glm::vec<2, T> closest_point = closest_point_on_line(center, line);
+	T dist2 = glm::distance2(closest_point, center);
+	if (dist2 > r * r)
+		return false;
+
+	T dist_p = std::sqrt(r * r - dist2);
+	*result = closest_point - line.direction * dist_p;
+	return true;
+}
+
+template<typename T>
+GLM_PLUS_INLINE bool line_segment_circle_intersect(glm::vec<2, T> center, type_identity_t<T> r, const line2<T>& segment, glm::vec<2, T>* result) {
+	return line_circle_intersect(center, r, segment, result) && is_between_two_points(*result, segment);
+}
+
+template<typename T>
+GLM_PLUS_INLINE bool moving_circle_line_segment_impact(glm::vec<2, T> center, type_identity_t<T> r, glm::vec<2, T> velocity,
+		const line2<T>& segment, T* t, glm::vec<2, T>* normal) {
+	glm::vec<2, T> d = segment.delta;
+	glm::vec<2, T> m = center - closest_point_on_line_segment(center, segment);
+	if (m == glm::vec<2, T>(T(0))) {
+		// The center lies on the line segment, so there is no direction away from it. The normal faces against the motion.
+		*t = T(0);
+		*normal = segment.length2 > T(0) || glm::dot(velocity, velocity) > T(0) ? detail::facing_normal(d, velocity) : glm::vec<2, T>(T(0), T(1));
+		return true;
+	}
+	if (glm::dot(m, m) <= r * r) {
+		// Distance to a line segment is convex along the motion, so a circle moving away never comes back.
+		if (glm::dot(m, velocity) >= T(0))
+			return false;
+		*t = T(0);
+		*normal = glm::normalize(m);
+		return true;
+	}
+
+	// Contact with the flat side of the capsule swept around the line segment.
+	if (segment.length2 > T(0)) {
+		glm::vec<2, T> m1 = center - segment.p1;
+		T side = d.x * m1.y - d.y * m1.x < T(0) ? T(-1) : T(1);
+		T dist = side * (d.x * m1.y - d.y * m1.x);
+		T speed = -side * (d.x * velocity.y - d.y * velocity.x);
+		T gap = dist - r * segment.length;
+		if (speed > T(0) && gap >= T(0) && gap <= speed) {
+			T time = gap / speed;
+			T s = glm::dot(m1 + velocity * time, d);
+			if (s >= T(0) && s <= segment.length2) {
+				*t = time;
+				*normal = glm::vec<2, T>(-d.y, d.x) * (side / segment.length);
+				return true;
+			}
+		}
+	}
+
+	// Otherwise the first contact is with one of the rounded ends.
+	T t1 = T(0);
+	T t2 = T(0);
+	glm::vec<2, T> n1(T(0));
+	glm::vec<2, T> n2(T(0));
+	bool hit1 = detail::moving_point_circle_impact(center - segment.p1, velocity, T(r), &t1, &n1);
+	bool hit2 = detail::moving_point_circle_impact(center - segment.p2, velocity, T(r), &t2, &n2);
+	if (hit2 && (!hit1 || t2 < t1)) {
+		t1 = t2;
+		n1 = n2;
+	}
+	else if (!hit1)
+		return false;
+	*t = t1;
+	*normal = n1;
+	return true;
+}
+
+template<typename T>
+GLM_PLUS_INLINE bool moving_line_segment_impact(glm::vec<2, T> a1, glm::vec<2, T> a2, glm::vec<2, T> velocity,
+		const line2<T>& segment, T* t, glm::vec<2, T>* normal) {
+	return moving_line_segment_impact(a1, a2, velocity, segment.p1, segment.p2, t, normal);
+}
+
+}
@@ -0,0 +1,399 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "line_batch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "line.h"
+
+using namespace glm_plus;
+using namespace glm;
+
+void glm_plus::dist_to_line_signed(const float* xs, const float* ys, std::size_t count, fvec2 a1, fvec2 a2, float* result) {
+	// Distance is an affine function of the point: d = x * nx + y * ny + c.
+	float dx = a2.x - a1.x;
+	float dy = a2.y - a1.y;
+	float inv_length = 1.0f / std::sqrt(square(dx) + square(dy));
+	float nx = dy * inv_length;
+	float ny = -dx * inv_length;
+	float c = (dx * a1.y - dy * a1.x) * inv_length;
+
+	for (std::size_t i = 0; i < count; ++i)
+		result[i] = xs[i] * nx + ys[i] * ny + c;
+}
+
+void glm_plus::is_right_of_line(const float* xs, const float* ys, std::size_t count, fvec2 a1, fvec2 a2, std::uint32_t* result) {
+	float dx = a2.x - a1.x;
+	float dy = a2.y - a1.y;
+	detail::write_mask(count, result, [=](std::size_t i) {
+		return static_cast<std::uint32_t>(dx * (ys[i] - a1.y) - dy * (xs[i] - a1.x) >= 0.0f);
+	});
+}
+
+namespace {
+
+// Tests up to 32 segments and appends hits to the output lists.
+// Tests are evaluated into arrays first, so the first loop can be vectorized.
+// The second loop writes every entry and only advances the output position on hits, so it does not branch.
+std::size_t segments_intersect_block(fvec2 a1, float rx, float ry, fvec2 a_min, fvec2 a_max,
+		const float* x1s, const float* y1s, const float* x2s, const float* y2s,
+		std::uint32_t count, std::uint32_t first, std::uint32_t* hits, float* ts) {
+	std::uint32_t flags[32];
+	float params[32];
+	for (std::uint32_t j = 0; j < count; ++j) {
+		float sx = x2s[j] - x1s[j];
+		float sy = y2s[j] - y1s[j];
+		float dx = x1s[j] - a1.x;
+		float dy = y1s[j] - a1.y;
+		float denom = rx * sy - ry * sx;
+		float t_num = dx * sy - dy * sx;
+		float u_num = dx * ry - dy * rx;
+
+		float sign = std::copysign(1.0f, denom);
+		denom *= sign;
+		t_num *= sign;
+		u_num *= sign;
+		params[j] = t_num / (denom + static_cast<float>(denom == 0.0f));
+		std::uint32_t boxes = (a_min.x <= std::max(x1s[j], x2s[j])) & (std::min(x1s[j], x2s[j]) <= a_max.x)
+			& (a_min.y <= std::max(y1s[j], y2s[j])) & (std::min(y1s[j], y2s[j]) <= a_max.y);
+		flags[j] = boxes & (denom != 0.0f) & (t_num >= 0.0f) & (t_num <= denom) & (u_num >= 0.0f) & (u_num <= denom);
+	}
+
+	std::size_t n = 0;
+	for (std::uint32_t j = 0; j < count; ++j) {
+		hits[n] = first + j;
+		ts[n] = params[j];
+		n += flags[j];
+	}
+	return n;
+}
+
+}
+
+std::size_t glm_plus::line_segments_intersect(fvec2 a1, fvec2 a2, const float* x1s, const float* y1s, const float* x2s, const float* y2s,
+		std::size_t count, std::uint32_t* hits, float* ts) {
+	float rx = a2.x - a1.x;
+	float ry = a2.y - a1.y;
+	fvec2 a_min = glm::min(a1, a2);
+	fvec2 a_max = glm::max(a1, a2);
+
+	std::size_t n = 0;
+	for (std::size_t i = 0; i < count; i += 32) {
+		auto block = static_cast<std::uint32_t>(std::min<std::size_t>(32, count - i));
+		n += segments_intersect_block(a1, rx, ry, a_min, a_max, x1s + i, y1s + i, x2s + i, y2s + i, block, static_cast<std::uint32_t>(i), hits + n, ts + n);
+	}
+	return n;
+}
+
+namespace {
+
+// Line segment a1 + d * t enters a circle at t = (-b - sqrt(disc)) / a, where
+// a = d.d, b = f.d, c = f.f - r^2, disc = b^2 - a * c and f = a1 - center.
+// Entry is within [0, 1] if the start is outside (c >= 0), the circle is ahead (b <= 0)
+// and the entry is not past the end, which can be checked without square roots: -b - a <= 0 or (b + a)^2 <= disc.
+inline std::uint32_t enters_circle(float a, float b, float c, float disc) {
+	float ba = b + a;
+	return (a > 0.0f) & (disc >= 0.0f) & (c >= 0.0f) & (b <= 0.0f) & ((ba >= 0.0f) | (ba * ba <= disc));
+}
+
+}
+
+bool glm_plus::line_segment_circle_intersect(const float* cxs, const float* cys, const float* rs, std::size_t count, fvec2 a1, fvec2 a2,
+		std::uint32_t* index, float* t, fvec2* entry, fvec2* exit) {
+	float dx = a2.x - a1.x;
+	float dy = a2.y - a1.y;
+	float a = dx * dx + dy * dy;
+
+	bool found = false;
+	std::uint32_t best_index = 0;
+	float best_t = 0.0f;
+	float best_disc = 0.0f;
+	for (std::size_t i = 0; i < count; i += 32) {
+		auto block = static_cast<std::uint32_t>(std::min<std::size_t>(32, count - i));
+		std::uint32_t flags[32];
+		float bs[32];
+		float discs[32];
+		for (std::uint32_t j = 0; j < block; ++j) {
+			float fx = a1.x - cxs[i + j];
+			float fy = a1.y - cys[i + j];
+			float b = fx * dx + fy * dy;
+			float c = fx * fx + fy * fy - rs[i + j] * rs[i + j];
+			float disc = b * b - a * c;
+			bs[j] = b;
+			discs[j] = disc;
+			flags[j] = enters_circle(a, b, c, disc);
+		}
+
+		for (std::uint32_t j = 0; j < block; ++j) {
+			if (!flags[j])
+				continue;
+			float tj = (-bs[j] - std::sqrt(discs[j])) / a;
+			if (!found || tj < best_t) {
+				found = true;
+				best_index = static_cast<std::uint32_t>(i + j);
+				best_t = tj;
+				best_disc = discs[j];
+			}
+		}
+	}
+
+	if (!found)
+		return false;
+	*index = best_index;
+	*t = best_t;
+	if (entry)
+		*entry = fvec2(a1.x + dx * best_t, a1.y + dy * best_t);
+	if (exit) {
+		float t_exit = best_t + 2.0f * std::sqrt(best_disc) / a;
+		*exit = fvec2(a1.x + dx * t_exit, a1.y + dy * t_exit);
+	}
+	return true;
+}
+
+std::size_t glm_plus::line_segment_circle_intersect(fvec2 center, float r, const float* x1s, const float* y1s, const float* x2s, const float* y2s,
+		std::size_t count, std::uint32_t* hits, float* ts, float* t_exits) {
+	float r2 = r * r;
+	std::size_t n = 0;
+	for (std::size_t i = 0; i < count; i += 32) {
+		auto block = static_cast<std::uint32_t>(std::min<std::size_t>(32, count - i));
+		std::uint32_t flags[32];
+		float as[32];
+		float bs[32];
+		float discs[32];
+		for (std::uint32_t j = 0; j < block; ++j) {
+			float dx = x2s[i + j] - x1s[i + j];
+			float dy = y2s[i + j] - y1s[i + j];
+			float fx = x1s[i + j] - center.x;
+			float fy = y1s[i + j] - center.y;
+			float a = dx * dx + dy * dy;
+			float b = fx * dx + fy * dy;
+			float c = fx * fx + fy * fy - r2;
+			float disc = b * b - a * c;
+			as[j] = a;
+			bs[j] = b;
+			discs[j] = disc;
+			flags[j] = enters_circle(a, b, c, disc);
+		}
+
+		// Compact the hits first, so square roots are only calculated for them.
+		std::uint32_t block_hits[32];
+		std::uint32_t m = 0;
+		for (std::uint32_t j = 0; j < block; ++j) {
+			block_hits[m] = j;
+			m += flags[j];
+		}
+		for (std::uint32_t k = 0; k < m; ++k) {
+			std::uint32_t j = block_hits[k];
+			float s = std::sqrt(discs[j]);
+			hits[n + k] = static_cast<std::uint32_t>(i + j);
+			ts[n + k] = (-bs[j] - s) / as[j];
+			if (t_exits)
+				t_exits[n + k] = (-bs[j] + s) / as[j];
+		}
+		n += m;
+	}
+	return n;
+}
+
+bool glm_plus::closest_line_segment(fvec2 x, const float* x1s, const float* y1s, const float* x2s, const float* y2s, std::size_t count,
+		std::uint32_t* index, float* t, float* distance2) {
+	if (count == 0)
+		return false;
+
+	std::uint32_t best_index = 0;
+	float best_t = 0.0f;
+	float best_distance2 = std::numeric_limits<float>::infinity();
+	for (std::size_t i = 0; i < count; i += 32) {
+		auto block = static_cast<std::uint32_t>(std::min<std::size_t>(32, count - i));
+		float params[32];
+		float distances2[32];
+		for (std::uint32_t j = 0; j < block; ++j) {
+			fvec2 p1(x1s[i + j], y1s[i + j]);
+			fvec2 p2(x2s[i + j], y2s[i + j]);
+			float tj = detail::closest_param(x, p1, p2);
+			float ex = x.x - (p1.x + (p2.x - p1.x) * tj);
+			float ey = x.y - (p1.y + (p2.y - p1.y) * tj);
+			params[j] = tj;
+			distances2[j] = ex * ex + ey * ey;
+		}
+
+		for (std::uint32_t j = 0; j < block; ++j) {
+			if (distances2[j] < best_distance2) {
+				best_index = static_cast<std::uint32_t>(i + j);
+				best_t = params[j];
+				best_distance2 = distances2[j];
+			}
+		}
+	}
+
+	*index = best_index;
+	*t = best_t;
+	*distance2 = best_distance2;
+	return true;
+}
+
+namespace {
+
+// First hit found so far by the time of impact searches.
+struct impact {
+	bool found = false;
+	std::uint32_t index = 0;
+	float t = 1.0f;
+	fvec2 normal;
+
+	void update(std::uint32_t i, float ti, fvec2 ni) {
+		if (!found || ti < t) {
+			found = true;
+			index = i;
+			t = ti;
+			normal = ni;
+		}
+	}
+
+	bool write(std::uint32_t* out_index, float* out_t, fvec2* out_normal) const {
+		if (!found)
+			return false;
+		*out_index = index;
+		*out_t = t;
+		*out_normal = normal;
+		return true;
+	}
+};
+
+// Grows a box by a margin relative to its coordinates,
+// so rounding in its corners does not cull contacts, which the scalar tests find.
+void inflate_box(fvec2* box_min, fvec2* box_max) {
+	float magnitude = std::max({1.0f, std::abs(box_min->x), std::abs(box_min->y), std::abs(box_max->x), std::abs(box_max->y)});
+	float margin = tiny_margin * magnitude;
+	*box_min -= margin;
+	*box_max += margin;
+}
+
+// Flags up to 32 line segments overlapping a box.
+// The flags are compacted into a list of candidates, which is returned as their number.
+std::uint32_t segments_in_box(fvec2 box_min, fvec2 box_max, const float* x1s, const float* y1s, const float* x2s, const float* y2s,
+		std::uint32_t count, std::uint32_t* candidates) {
+	std::uint32_t flags[32];
+	for (std::uint32_t j = 0; j < count; ++j) {
+		flags[j] = (std::max(x1s[j], x2s[j]) >= box_min.x) & (std::min(x1s[j], x2s[j]) <= box_max.x)
+			& (std::max(y1s[j], y2s[j]) >= box_min.y) & (std::min(y1s[j], y2s[j]) <= box_max.y);
+	}
+
+	std::uint32_t n = 0;
+	for (std::uint32_t j = 0; j < count; ++j) {
+		candidates[n] = j;
+		n += flags[j];
+	}
+	return n;
+}
+
+
+// Flags up to 32 circles hit by a moving circle before time bt.
+// Relative motion m + w * t enters the sum of radii, which is tested without square roots like in enters_circle,
+// and circles, which already touch, are hit if they are approaching.
+// Every comparison is loosened by a margin relative to its terms, so rounding never culls a circle, which the scalar test hits.
+// Static circles are a separate instance, so both loops are vectorized.
+template<bool Moving>
+void circle_impact_flags(fvec2 center, float r, fvec2 velocity, float bt, const float* cxs, const float* cys, const float* rs,
+		const float* vxs, const float* vys, std::uint32_t count, std::uint32_t* flags) {
+	for (std::uint32_t j = 0; j < count; ++j) {
+		float mx = center.x - cxs[j];
+		float my = center.y - cys[j];
+		float wx = Moving ? velocity.x - vxs[j] : velocity.x;
+		float wy = Moving ? velocity.y - vys[j] : velocity.y;
+		float radius = r + rs[j];
+		float a = wx * wx + wy * wy;
+		float b = mx * wx + my * wy;
+		float mm = mx * mx + my * my;
+		float rr = radius * radius;
+		float c = mm - rr;
+		float disc = b * b - a * c;
+		float disc_margin = tiny_margin * (b * b + a * std::abs(c));
+		float bat = b + a * bt;
+		flags[j] = (b < tiny_margin * (mm + a)) & ((c <= tiny_margin * (mm + rr)) | ((disc >= -disc_margin)
+			& ((bat >= -tiny_margin * (std::abs(b) + a * bt)) | (bat * bat <= disc + disc_margin))));
+	}
+}
+
+}
+
+bool glm_plus::moving_circle_line_segment_impact(fvec2 center, float r, fvec2 velocity,
+		const float* x1s, const float* y1s, const float* x2s, const float* y2s, std::size_t count,
+		std::uint32_t* index, float* t, fvec2* normal) {
+	impact best;
+	for (std::size_t i = 0; i < count; i += 32) {
+		auto block = static_cast<std::uint32_t>(std::min<std::size_t>(32, count - i));
+		// The box shrinks as earlier hits are found, so later blocks skip more segments.
+		fvec2 end = center + velocity * best.t;
+		fvec2 box_min = glm::min(center, end) - r;
+		fvec2 box_max = glm::max(center, end) + r;
+		inflate_box(&box_min, &box_max);
+		std::uint32_t candidates[32];
+		std::uint32_t m = segments_in_box(box_min, box_max, x1s + i, y1s + i, x2s + i, y2s + i, block, candidates);
+		for (std::uint32_t k = 0; k < m; ++k) {
+			std::size_t s = i + candidates[k];
+			float ts;
+			fvec2 ns;
+			if (moving_circle_line_segment_impact(center, r, velocity, fvec2(x1s[s], y1s[s]), fvec2(x2s[s], y2s[s]), &ts, &ns))
+				best.update(static_cast<std::uint32_t>(s), ts, ns);
+		}
+	}
+	return best.write(index, t, normal);
+}
+
+bool glm_plus::moving_circles_impact(fvec2 center, float r, fvec2 velocity,
+		const float* cxs, const float* cys, const float* rs, const float* vxs, const float* vys, std::size_t count,
+		std::uint32_t* index, float* t, fvec2* normal) {
+	impact best;
+	for (std::size_t i = 0; i < count; i += 32) {
+		auto block = static_cast<std::uint32_t>(std::min<std::size_t>(32, count - i));
+		std::uint32_t flags[32];
+		if (vxs)
+			circle_impact_flags<true>(center, r, velocity, best.t, cxs + i, cys + i, rs + i, vxs + i, vys + i, block, flags);
+		else
+			circle_impact_flags<false>(center, r, velocity, best.t, cxs + i, cys + i, rs + i, vxs, vys, block, flags);
+
+		std::uint32_t candidates[32];
+		std::uint32_t m = 0;
+		for (std::uint32_t j = 0; j < block; ++j) {
+			candidates[m] = j;
+			m += flags[j];
+		}
+		for (std::uint32_t k = 0; k < m; ++k) {
+			std::size_t s = i + candidates[k];
+			fvec2 vs = vxs ? fvec2(vxs[s], vys[s]) : fvec2(0.0f);
+			float ts;
+			fvec2 ns;
+			if (moving_circles_impact(center, r, velocity, fvec2(cxs[s], cys[s]), rs[s], vs, &ts, &ns))
+				best.update(static_cast<std::uint32_t>(s), ts, ns);
+		}
+	}
+	return best.write(index, t, normal);
+}
+
+bool glm_plus::moving_line_segment_impact(fvec2 a1, fvec2 a2, fvec2 velocity,
+		const float* x1s, const float* y1s, const float* x2s, const float* y2s, std::size_t count,
+		std::uint32_t* index, float* t, fvec2* normal) {
+	impact best;
+	for (std::size_t i = 0; i < count; i += 32) {
+		auto block = static_cast<std::uint32_t>(std::min<std::size_t>(32, count - i));
+		fvec2 offset = velocity * best.t;
+		fvec2 box_min = glm::min(glm::min(a1, a2), glm::min(a1, a2) + offset);
+		fvec2 box_max = glm::max(glm::max(a1, a2), glm::max(a1, a2) + offset);
+		inflate_box(&box_min, &box_max);
+		std::uint32_t candidates[32];
+		std::uint32_t m = segments_in_box(box_min, box_max, x1s + i, y1s + i, x2s + i, y2s + i, block, candidates);
+		for (std::uint32_t k = 0; k < m; ++k) {
+			std::size_t s = i + candidates[k];
+			float ts;
+			fvec2 ns;
+			if (moving_line_segment_impact(a1, a2, velocity, fvec2(x1s[s], y1s[s]), fvec2(x2s[s], y2s[s]), &ts, &ns))
+				best.update(static_cast<std::uint32_t>(s), ts, ns);
+		}
+	}
+	return best.write(index, t, normal);
+}
@@ -0,0 +1,194 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+/**
+ * @file line_batch.h
+ * This header contains batched versions of the functions in @ref line.h,
+ * which test many primitives against a single line at once.
+ * Points are passed as a structure of arrays (separate x and y coordinate arrays),
+ * which lets the compiler vectorize the loops.
+ * Results equal the scalar versions only if multiplications and additions are not contracted into fused multiply-adds,
+ * which round differently. The CMake target passes @c -ffp-contract=off to its users for this.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "glm/gtc/type_precision.hpp"
+#include "util.h"
+
+namespace glm_plus {
+
+/**
+ * Calculates point to line distance for many points.
+ * Batched version of @ref dist_to_line_signed.
+ * The line length is calculated only once, so the results may differ from the scalar version by a rounding error.
+ * @param xs X coordinates of the points to test.
+ * @param ys Y coordinates of the points to test.
+ * @param count Number of points.
+ * @param a1 First point on the line.
+ * @param a2 Second point on the line.
+ * @param result Array of @p count point to line distances.
+ */
+void dist_to_line_signed(const float* xs, const float* ys, std::size_t count, glm::fvec2 a1, glm::fvec2 a2, float* result);
+
+/**
+ * Check if the points are right of or on the line.
+ * Batched version of @ref is_right_of_line.
+ * Results are written as a bitmask, see @ref mask_words.
+ * @param xs X coordinates of the points to test.
+ * @param ys Y coordinates of the points to test.
+ * @param count Number of points.
+ * @param a1 First point on the line.
+ * @param a2 Second point on the line.
+ * @param result Bitmask of <tt>mask_words(count)</tt> words. Unused bits of the last word are cleared.
+ */
+void is_right_of_line(const float* xs, const float* ys, std::size_t count, glm::fvec2 a1, glm::fvec2 a2, std::uint32_t* result);
+
+/**
+ * Finds line segments intersected by a single line segment.
+ * Batched version of @ref line_segments_intersect_parametric, which tests one segment against many.
+ * Hits are written as a compact list, in the order of the tested segments.
+ * @param a1 First point of the line segment.
+ * @param a2 Second point of the line segment.
+ * @param x1s X coordinates of the first points of the tested line segments.
+ * @param y1s Y coordinates of the first points of the tested line segments.
+ * @param x2s X coordinates of the second points of the tested line segments.
+ * @param y2s Y coordinates of the second points of the tested line segments.
+ * @param count Number of tested line segments.
+ * @param hits Indices of intersected line segments. Must have room for @p count elements.
+ * @param ts Intersection parameters along the line segment @p a1, @p a2 for each hit. Must have room for @p count elements.
+ * @return Number of hits.
+ */
+std::size_t line_segments_intersect(glm::fvec2 a1, glm::fvec2 a2, const float* x1s, const float* y1s, const float* x2s, const float* y2s,
+		std::size_t count, std::uint32_t* hits, float* ts);
+
+/**
+ * Finds the first circle hit by a line segment.
+ * Batched version of @ref line_segment_circle_intersect, which tests many circles against one line segment.
+ * A circle is hit if the line segment enters it, so segments starting inside a circle do not hit it,
+ * the same as with the scalar version.
+ * Hits are found without square roots, which are only calculated for hit circles.
+ * @param cxs X coordinates of circle centers.
+ * @param cys Y coordinates of circle centers.
+ * @param rs Circle radii.
+ * @param count Number of circles.
+ * @param a1 First line segment point.
+ * @param a2 Second line segment point.
+ * @param index Index of the first hit circle. If several circles are entered at the same point, the one with the smallest index.
+ * @param t Entry parameter of the first hit. The entry point is <tt>a1 + (a2 - a1) * t</tt>.
+ * @param entry If not @c nullptr, receives the point where the line segment enters the first hit circle.
+ * @param exit If not @c nullptr, receives the point where the line leaves the first hit circle. It may lie beyond @p a2.
+ * @return @c True if any circle is hit, @c false otherwise, in which case no outputs are written.
+ */
+bool line_segment_circle_intersect(const float* cxs, const float* cys, const float* rs, std::size_t count, glm::fvec2 a1, glm::fvec2 a2,
+		std::uint32_t* index, float* t, glm::fvec2* entry = nullptr, glm::fvec2* exit = nullptr);
+
+/**
+ * Finds line segments, which hit a circle.
+ * Batched version of @ref line_segment_circle_intersect, which tests many line segments against one circle.
+ * Hits are written as a compact list, in the order of the tested segments.
+ * @param center Circle center.
+ * @param r Circle radius.
+ * @param x1s X coordinates of the first points of the line segments.
+ * @param y1s Y coordinates of the first points of the line segments.
+ * @param x2s X coordinates of the second points of the line segments.
+ * @param y2s Y coordinates of the second points of the line segments.
+ * @param count Number of line segments.
+ * @param hits Indices of line segments that hit the circle. Must have room for @p count elements.
+ * @param ts Entry parameters along each hit line segment. Must have room for @p count elements.
+ * @param t_exits If not @c nullptr, receives exit parameters along each hit line segment, which may be greater than 1.
+ * Must have room for @p count elements.
+ * @return Number of hits.
+ */
+std::size_t line_segment_circle_intersect(glm::fvec2 center, float r, const float* x1s, const float* y1s, const float* x2s, const float* y2s,
+		std::size_t count, std::uint32_t* hits, float* ts, float* t_exits = nullptr);
+
+/**
+ * Finds the line segment closest to a point.
+ * Batched version of @ref closest_point_on_line_segment, which tests many line segments against one point.
+ * Results are the same as with the scalar version.
+ * @param x Point to test.
+ * @param x1s X coordinates of the first points of the line segments.
+ * @param y1s Y coordinates of the first points of the line segments.
+ * @param x2s X coordinates of the second points of the line segments.
+ * @param y2s Y coordinates of the second points of the line segments.
+ * @param count Number of line segments.
+ * @param index Index of the closest line segment. If several are equally close, the first one is found.
+ * @param t Parameter of the closest point along the closest line segment, see @ref closest_param_on_line_segment.
+ * @param distance2 Squared distance from @p x to the closest point.
+ * @return @c True if a line segment was found, @c false if @p count is 0, in which case outputs are left unchanged.
+ */
+bool closest_line_segment(glm::fvec2 x, const float* x1s, const float* y1s, const float* x2s, const float* y2s, std::size_t count,
+		std::uint32_t* index, float* t, float* distance2);
+
+/**
+ * Finds the first line segment hit by a moving circle.
+ * Batched version of @ref moving_circle_line_segment_impact, which tests one circle against many line segments.
+ * Line segments outside the bounding box of the circle's motion until the first hit found so far are skipped in vectorized blocks,
+ * and the rest are tested with the scalar version.
+ * @param center Circle center at time 0.
+ * @param r Circle radius.
+ * @param velocity Displacement of the circle during the time interval [0, 1].
+ * @param x1s X coordinates of the first points of the line segments.
+ * @param y1s Y coordinates of the first points of the line segments.
+ * @param x2s X coordinates of the second points of the line segments.
+ * @param y2s Y coordinates of the second points of the line segments.
+ * @param count Number of line segments.
+ * @param index Index of the first hit line segment. If several are hit at the same time, the one with the smallest index.
+ * @param t Time of the first contact.
+ * @param normal Unit contact normal, pointing from the line segment towards the circle center.
+ * @return @c True if any line segment is hit, @c false otherwise, in which case no outputs are written.
+ */
+bool moving_circle_line_segment_impact(glm::fvec2 center, float r, glm::fvec2 velocity,
+		const float* x1s, const float* y1s, const float* x2s, const float* y2s, std::size_t count,
+		std::uint32_t* index, float* t, glm::fvec2* normal);
+
+/**
+ * Finds the first circle hit by a moving circle.
+ * Batched version of @ref moving_circles_impact, which tests one circle against many.
+ * Hits are found without square roots, which are only calculated for hit circles.
+ * @param center Circle center at time 0.
+ * @param r Circle radius.
+ * @param velocity Displacement of the circle during the time interval [0, 1].
+ * @param cxs X coordinates of the other circle centers at time 0.
+ * @param cys Y coordinates of the other circle centers at time 0.
+ * @param rs Radii of the other circles.
+ * @param vxs X coordinates of the other circle displacements. If @c nullptr, the other circles do not move.
+ * @param vys Y coordinates of the other circle displacements. Must be @c nullptr if @p vxs is.
+ * @param count Number of other circles.
+ * @param index Index of the first hit circle. If several are hit at the same time, the one with the smallest index.
+ * @param t Time of the first contact.
+ * @param normal Unit contact normal, pointing from the hit circle towards the moving one.
+ * @return @c True if any circle is hit, @c false otherwise, in which case no outputs are written.
+ */
+bool moving_circles_impact(glm::fvec2 center, float r, glm::fvec2 velocity,
+		const float* cxs, const float* cys, const float* rs, const float* vxs, const float* vys, std::size_t count,
+		std::uint32_t* index, float* t, glm::fvec2* normal);
+
+/**
+ * Finds the first static line segment hit by a moving line segment.
+ * Batched version of @ref moving_line_segment_impact, which tests one moving line segment against many static ones.
+ * Line segments outside the bounding box of the motion until the first hit found so far are skipped in vectorized blocks,
+ * and the rest are tested with the scalar version.
+ * @param a1 First point of the moving line segment at time 0.
+ * @param a2 Second point of the moving line segment at time 0.
+ * @param velocity Displacement of the moving line segment during the time interval [0, 1].
+ * @param x1s X coordinates of the first points of the static line segments.
+ * @param y1s Y coordinates of the first points of the static line segments.
+ * @param x2s X coordinates of the second points of the static line segments.
+ * @param y2s Y coordinates of the second points of the static line segments.
+ * @param count Number of static line segments.
+ * @param index Index of the first hit line segment. If several are hit at the same time, the one with the smallest index.
+ * @param t Time of the first contact.
+ * @param normal Unit contact normal, see @ref moving_line_segment_impact.
+ * @return @c True if any line segment is hit, @c false otherwise, in which case no outputs are written.
+ */
+bool moving_line_segment_impact(glm::fvec2 a1, glm::fvec2 a2, glm::fvec2 velocity,
+		const float* x1s, const float* y1s, const float* x2s, const float* y2s, std::size_t count,
+		std::uint32_t* index, float* t, glm::fvec2* normal);
+
+}
@@ -0,0 +1,63 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "parallel.h"
+
+#include <algorithm>
+
+#include "line_batch.h"
+#include "types_batch.h"
+
+using namespace glm_plus;
+using namespace glm;
+
+namespace {
+
+// Chunk size for bitmask outputs. Automatic chunk sizes are multiples of 64,
+// so chunks never share a mask word, but the last chunk may end in the middle of one.
+constexpr std::size_t bits_per_word = 32;
+
+}
+
+void glm_plus::dist_to_line_signed(executor& pool, const float* xs, const float* ys, std::size_t count, fvec2 a1, fvec2 a2, float* result) {
+	pool.parallel_for(count, 0, [=](std::size_t begin, std::size_t end) {
+		dist_to_line_signed(xs + begin, ys + begin, end - begin, a1, a2, result + begin);
+	});
+}
+
+void glm_plus::is_right_of_line(executor& pool, const float* xs, const float* ys, std::size_t count, fvec2 a1, fvec2 a2, std::uint32_t* result) {
+	pool.parallel_for(count, 0, [=](std::size_t begin, std::size_t end) {
+		is_right_of_line(xs + begin, ys + begin, end - begin, a1, a2, result + begin / bits_per_word);
+	});
+}
+
+void glm_plus::inside_rect(executor& pool, const float* xs, const float* ys, std::size_t count, const farea& area, std::uint32_t* result) {
+	pool.parallel_for(count, 0, [=, &area](std::size_t begin, std::size_t end) {
+		inside_rect(xs + begin, ys + begin, end - begin, area, result + begin / bits_per_word);
+	});
+}
+
+std::size_t glm_plus::line_segments_intersect(executor& pool, fvec2 a1, fvec2 a2, const float* x1s, const float* y1s, const float* x2s, const float* y2s,
+		std::size_t count, std::uint32_t* hits, float* ts, arena* scratch) {
+	// Each chunk writes its hits at the start of its own part of the output, then the parts are moved together in order.
+	std::size_t chunk_size = std::max<std::size_t>(1024, count / (pool.get_thread_count() * 8));
+	std::size_t chunks = (count + chunk_size - 1) / chunk_size;
+	arena_scope scope(scratch);
+	arena_vector<std::size_t> counts(chunks, 0, arena_allocator<std::size_t>(scratch));
+	pool.parallel_for(count, chunk_size, [&](std::size_t begin, std::size_t end) {
+		std::size_t n = line_segments_intersect(a1, a2, x1s + begin, y1s + begin, x2s + begin, y2s + begin, end - begin, hits + begin, ts + begin);
+		for (std::size_t i = 0; i < n; ++i)
+			hits[begin + i] += static_cast<std::uint32_t>(begin);
+		counts[begin / chunk_size] = n;
+	});
+
+	std::size_t n = 0;
+	for (std::size_t c = 0; c < chunks; ++c) {
+		std::size_t begin = c * chunk_size;
+		std::copy(hits + begin, hits + begin + counts[c], hits + n);
+		std::copy(ts + begin, ts + begin + counts[c], ts + n);
+		n += counts[c];
+	}
+	return n;
+}
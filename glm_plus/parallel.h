@@ -0,0 +1,83 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+/**
+ * @file parallel.h
+ * This header contains parallel versions of the batched functions in @ref line_batch.h and @ref types_batch.h.
+ * The batch is split into chunks, which run on an @ref executor.
+ * Results are the same as with the single-threaded versions, independent of the number of threads.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "arena.h"
+#include "glm/gtc/type_precision.hpp"
+#include "executor.h"
+#include "types.h"
+#include "util.h"
+
+namespace glm_plus {
+
+/**
+ * Calculates point to line distance for many points in parallel.
+ * Parallel version of @ref dist_to_line_signed.
+ * @param pool Executor to run on.
+ * @param xs X coordinates of the points to test.
+ * @param ys Y coordinates of the points to test.
+ * @param count Number of points.
+ * @param a1 First point on the line.
+ * @param a2 Second point on the line.
+ * @param result Array of @p count point to line distances.
+ */
+void dist_to_line_signed(executor& pool, const float* xs, const float* ys, std::size_t count, glm::fvec2 a1, glm::fvec2 a2, float* result);
+
+/**
+ * Check if the points are right of or on the line, in parallel.
+ * Parallel version of @ref is_right_of_line.
+ * @param pool Executor to run on.
+ * @param xs X coordinates of the points to test.
+ * @param ys Y coordinates of the points to test.
+ * @param count Number of points.
+ * @param a1 First point on the line.
+ * @param a2 Second point on the line.
+ * @param result Bitmask of <tt>mask_words(count)</tt> words. Unused bits of the last word are cleared.
+ */
+void is_right_of_line(executor& pool, const float* xs, const float* ys, std::size_t count, glm::fvec2 a1, glm::fvec2 a2, std::uint32_t* result);
+
+/**
+ * Check if the points are inside an area, in parallel. Points on the area edge are inside.
+ * Parallel version of @ref inside_rect.
+ * @param pool Executor to run on.
+ * @param xs X coordinates of the points to test.
+ * @param ys Y coordinates of the points to test.
+ * @param count Number of points.
+ * @param area Area.
+ * @param result Bitmask of <tt>mask_words(count)</tt> words. Unused bits of the last word are cleared.
+ */
+void inside_rect(executor& pool, const float* xs, const float* ys, std::size_t count, const farea& area, std::uint32_t* result);
+
+/**
+ * Finds line segments intersected by a single line segment, in parallel.
+ * Parallel version of @ref line_segments_intersect.
+ * Hits are written in the order of the tested segments, the same as with the single-threaded version.
+ * @param pool Executor to run on.
+ * @param a1 First point of the line segment.
+ * @param a2 Second point of the line segment.
+ * @param x1s X coordinates of the first points of the tested line segments.
+ * @param y1s Y coordinates of the first points of the tested line segments.
+ * @param x2s X coordinates of the second points of the tested line segments.
+ * @param y2s Y coordinates of the second points of the tested line segments.
+ * @param count Number of tested line segments.
+ * @param hits Indices of intersected line segments. Must have room for @p count elements.
+ * @param ts Intersection parameters along the line segment @p a1, @p a2 for each hit. Must have room for @p count elements.
+ * @param scratch Arena for hit counts of chunks, 8 bytes per chunk. Heap is used if @c nullptr.
+ * @return Number of hits.
+ */
+std::size_t line_segments_intersect(executor& pool, glm::fvec2 a1, glm::fvec2 a2, const float* x1s, const float* y1s, const float* x2s, const float* y2s,
+		std::size_t count, std::uint32_t* hits, float* ts, arena* scratch = nullptr);
+
+}
@@ -0,0 +1,122 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "polygon.h"
+
+#include <algorithm>
+
+using namespace glm_plus;
+using namespace glm;
+
+namespace {
+
+// Check if a horizontal line at height y crosses the edge, including the lower end and excluding the upper one.
+bool edge_spans(fvec2 a, fvec2 b, float y) {
+	return (a.y <= y) != (b.y <= y);
+}
+
+float edge_x(fvec2 bottom, float dxdy, float y) {
+	return bottom.x + (y - bottom.y) * dxdy;
+}
+
+}
+
+bool glm_plus::polygon_contains(const polygon& poly, fvec2 x) {
+	bool inside = false;
+	std::size_t n = poly.vertices.size();
+	for (std::size_t i = 0, j = n - 1; i < n; j = i++) {
+		fvec2 a = poly.vertices[j];
+		fvec2 b = poly.vertices[i];
+		if (!edge_spans(a, b, x.y))
+			continue;
+		
+		fvec2 bottom = a.y < b.y ? a : b;
+		fvec2 top = a.y < b.y ? b : a;
+		float dxdy = (top.x - bottom.x) / (top.y - bottom.y);
+		if (edge_x(bottom, dxdy, x.y) >= x.x)
+			inside = !inside;
+	}
+	return inside;
+}
+
+polygon_index::polygon_index(const polygon& poly, arena* scratch) {
+	const std::vector<fvec2>& vertices = poly.vertices;
+	std::size_t n = vertices.size();
+	if (n < 3)
+		return;
+	
+	slab_ys.reserve(n);
+	for (fvec2 v : vertices)
+		slab_ys.push_back(v.y);
+	std::sort(slab_ys.begin(), slab_ys.end());
+	slab_ys.erase(std::unique(slab_ys.begin(), slab_ys.end()), slab_ys.end());
+	
+	std::size_t slab_count = slab_ys.size() - 1;
+	auto slab_of = [this](float y) {
+		return static_cast<std::size_t>(std::lower_bound(slab_ys.begin(), slab_ys.end(), y) - slab_ys.begin());
+	};
+	
+	// Count edges per slab, then fill them in, compressed-row style.
+	slab_offsets.assign(slab_count + 1, 0);
+	for (std::size_t i = 0, j = n - 1; i < n; j = i++) {
+		fvec2 a = vertices[j];
+		fvec2 b = vertices[i];
+		if (a.y == b.y)
+			continue;
+		std::size_t first = slab_of(std::min(a.y, b.y));
+		std::size_t last = slab_of(std::max(a.y, b.y));
+		for (std::size_t s = first; s < last; ++s)
+			++slab_offsets[s + 1];
+	}
+	for (std::size_t s = 0; s < slab_count; ++s)
+		slab_offsets[s + 1] += slab_offsets[s];
+	
+	slab_edges.resize(slab_offsets.back());
+	arena_scope scope(scratch);
+	arena_vector<std::uint32_t> fill(slab_offsets.begin(), slab_offsets.end() - 1, arena_allocator<std::uint32_t>(scratch));
+	for (std::size_t i = 0, j = n - 1; i < n; j = i++) {
+		fvec2 a = vertices[j];
+		fvec2 b = vertices[i];
+		if (a.y == b.y)
+			continue;
+		fvec2 bottom = a.y < b.y ? a : b;
+		fvec2 top = a.y < b.y ? b : a;
+		edge e = {bottom.x, bottom.y, (top.x - bottom.x) / (top.y - bottom.y)};
+		std::size_t first = slab_of(bottom.y);
+		std::size_t last = slab_of(top.y);
+		for (std::size_t s = first; s < last; ++s)
+			slab_edges[fill[s]++] = e;
+	}
+	
+	// Edges of a simple polygon do not cross inside a slab, so their order by x is the same at every height.
+	for (std::size_t s = 0; s < slab_count; ++s) {
+		float mid = slab_ys[s] + (slab_ys[s + 1] - slab_ys[s]) * 0.5f;
+		std::sort(slab_edges.begin() + slab_offsets[s], slab_edges.begin() + slab_offsets[s + 1], [mid](const edge& e1, const edge& e2) {
+			return edge_x(fvec2(e1.x, e1.y), e1.dxdy, mid) < edge_x(fvec2(e2.x, e2.y), e2.dxdy, mid);
+		});
+	}
+}
+
+bool polygon_index::contains(fvec2 x) const {
+	if (slab_ys.size() < 2 || !(x.y >= slab_ys.front() && x.y < slab_ys.back()))
+		return false;
+	
+	std::size_t slab = static_cast<std::size_t>(std::upper_bound(slab_ys.begin(), slab_ys.end(), x.y) - slab_ys.begin()) - 1;
+	return slab_contains(slab, x);
+}
+
+void polygon_index::contains(const fvec2* points, std::size_t count, std::uint32_t* result) const {
+	detail::write_mask(count, result, [this, points](std::size_t i) {
+		return static_cast<std::uint32_t>(contains(points[i]));
+	});
+}
+
+bool polygon_index::slab_contains(std::size_t slab, fvec2 x) const {
+	const edge* begin = slab_edges.data() + slab_offsets[slab];
+	const edge* end = slab_edges.data() + slab_offsets[slab + 1];
+	const edge* right = std::partition_point(begin, end, [x](const edge& e) {
+		return edge_x(fvec2(e.x, e.y), e.dxdy, x.y) < x.x;
+	});
+	return (end - right) & 1;
+}
@@ -0,0 +1,111 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+/**
+ * @file polygon.h
+ * This header contains the polygon type and functions for testing if points are inside a polygon.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "arena.h"
+#include "glm/gtc/type_precision.hpp"
+#include "util.h"
+
+namespace glm_plus {
+
+/**
+ * Represents a simple polygon by its vertices.
+ * The last vertex is connected back to the first one.
+ */
+struct polygon {
+	polygon() = default;
+	explicit polygon(std::vector<glm::fvec2> vertices) :
+			vertices(std::move(vertices)) {}
+
+	std::vector<glm::fvec2> vertices;
+};
+
+/**
+ * List of polygons, stored in a single vertex array.
+ * Polygon @c i consists of vertices from <tt>offsets[i]</tt> to <tt>offsets[i + 1]</tt>.
+ */
+struct polygon_list {
+	std::vector<glm::fvec2> vertices;
+	std::vector<std::size_t> offsets = {0};
+
+	void clear() {
+		vertices.clear();
+		offsets.assign(1, 0);
+	}
+
+	[[nodiscard]] std::size_t size() const { return offsets.size() - 1; }
+};
+
+/**
+ * Check if the point is inside the polygon.
+ * Counts polygon edges crossed by a horizontal ray, running from the point in positive x direction.
+ * Unlike repeated calls to @ref horizontal_ray_line_segment_intersect, each edge includes its lower end but not its upper end,
+ * so rays passing exactly through a vertex are counted correctly.
+ * Runs in O(n). Use @ref polygon_index for many queries against the same polygon.
+ * @param poly Polygon.
+ * @param x Point to test.
+ * @return @c True if the point is inside the polygon, @c false otherwise.
+ */
+bool polygon_contains(const polygon& poly, glm::fvec2 x);
+
+/**
+ * Acceleration structure for testing if points are inside a polygon.
+ * The polygon is split into horizontal slabs at vertex heights.
+ * Edges crossing each slab are sorted by x, so a query is two binary searches.
+ * Results are the same as for @ref polygon_contains.
+ * @note Memory use is proportional to the total number of edges crossing each slab,
+ * which is O(n) for most shapes, but can be O(n^2) for polygons with many long, overlapping edges.
+ */
+class polygon_index {
+public:
+	polygon_index() = default;
+	/**
+	 * @param poly Polygon to index.
+	 * @param scratch Arena for temporary buffers while building. Heap is used if @c nullptr.
+	 */
+	explicit polygon_index(const polygon& poly, arena* scratch = nullptr);
+
+	/**
+	 * Check if the point is inside the polygon.
+	 * @param x Point to test.
+	 * @return @c True if the point is inside the polygon, @c false otherwise.
+	 */
+	[[nodiscard]] bool contains(glm::fvec2 x) const;
+
+	/**
+	 * Check if the points are inside the polygon.
+	 * Results are written as a bitmask, see @ref mask_words.
+	 * @param points Points to test.
+	 * @param count Number of points.
+	 * @param result Bitmask of <tt>mask_words(count)</tt> words.
+	 */
+	void contains(const glm::fvec2* points, std::size_t count, std::uint32_t* result) const;
+
+private:
+	/** Polygon edge, stored as its lower point and inverse slope. */
+	struct edge {
+		float x;
+		float y;
+		float dxdy;
+	};
+
+	[[nodiscard]] bool slab_contains(std::size_t slab, glm::fvec2 x) const;
+
+	std::vector<float> slab_ys;
+	std::vector<std::uint32_t> slab_offsets;
+	std::vector<edge> slab_edges;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,163 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "polyline.h"
+
+#include <algorithm>
+
+#include "line.h"
+
+using namespace glm_plus;
+using namespace glm;
+
+namespace {
+
+// Squared distance to the closest point of a segment.
+float segment_distance2(fvec2 x, fvec2 p1, fvec2 p2, float* t) {
+	*t = detail::closest_param(x, p1, p2);
+	float ex = x.x - (p1.x + (p2.x - p1.x) * *t);
+	float ey = x.y - (p1.y + (p2.y - p1.y) * *t);
+	return ex * ex + ey * ey;
+}
+
+// Tests the segments between consecutive vertices and keeps the closest one.
+// Distances are calculated in blocks first, so that loop can be vectorized, and compared afterwards.
+void closest_open(fvec2 x, const fvec2* vertices, std::size_t segment_count, std::uint32_t first_id, segment_point& best) {
+	for (std::size_t i = 0; i < segment_count; i += 32) {
+		auto block = static_cast<std::uint32_t>(std::min<std::size_t>(32, segment_count - i));
+		const fvec2* v = vertices + i;
+		float params[32];
+		float distances2[32];
+		for (std::uint32_t j = 0; j < block; ++j)
+			distances2[j] = segment_distance2(x, v[j], v[j + 1], &params[j]);
+
+		for (std::uint32_t j = 0; j < block; ++j) {
+			if (distances2[j] < best.distance2) {
+				best.id = first_id + static_cast<std::uint32_t>(i + j);
+				best.t = params[j];
+				best.distance2 = distances2[j];
+			}
+		}
+	}
+}
+
+void closest_segment(fvec2 x, fvec2 p1, fvec2 p2, std::uint32_t id, segment_point& best) {
+	float t;
+	float d2 = segment_distance2(x, p1, p2, &t);
+	if (d2 < best.distance2) {
+		best.id = id;
+		best.t = t;
+		best.distance2 = d2;
+	}
+}
+
+// Tests a polyline and sets the closest point, if a closer one is found.
+// Ids of segments are offset by first_id.
+void closest_ring(fvec2 x, const fvec2* vertices, std::size_t count, bool closed, std::uint32_t first_id, segment_point& best) {
+	if (count == 1) {
+		closest_segment(x, vertices[0], vertices[0], first_id, best);
+		return;
+	}
+	closest_open(x, vertices, count - 1, first_id, best);
+	if (closed)
+		closest_segment(x, vertices[count - 1], vertices[0], first_id + static_cast<std::uint32_t>(count - 1), best);
+}
+
+segment_point no_point() {
+	return {std::numeric_limits<std::uint32_t>::max(), 0.0f, fvec2(0.0f), std::numeric_limits<float>::infinity()};
+}
+
+void set_point(const fvec2* vertices, std::size_t count, std::size_t first, segment_point& best) {
+	std::size_t i = best.id - first;
+	fvec2 p1 = vertices[i];
+	fvec2 p2 = vertices[i + 1 < count ? i + 1 : 0];
+	best.point = fvec2(p1.x + (p2.x - p1.x) * best.t, p1.y + (p2.y - p1.y) * best.t);
+}
+
+}
+
+bool glm_plus::closest_point_on_polyline(fvec2 x, const fvec2* vertices, std::size_t count, segment_point* result, bool closed) {
+	if (count == 0)
+		return false;
+	segment_point best = no_point();
+	closest_ring(x, vertices, count, closed, 0, best);
+	set_point(vertices, count, 0, best);
+	*result = best;
+	return true;
+}
+
+void glm_plus::closest_point_on_polyline(const fvec2* xs, std::size_t count, const fvec2* vertices, std::size_t vertex_count,
+		segment_point* result, bool closed) {
+	for (std::size_t i = 0; i < count; ++i)
+		closest_point_on_polyline(xs[i], vertices, vertex_count, result + i, closed);
+}
+
+void glm_plus::closest_point_on_polyline(executor& pool, const fvec2* xs, std::size_t count, const fvec2* vertices, std::size_t vertex_count,
+		segment_point* result, bool closed) {
+	pool.parallel_for(count, 0, [=](std::size_t begin, std::size_t end) {
+		closest_point_on_polyline(xs + begin, end - begin, vertices, vertex_count, result + begin, closed);
+	});
+}
+
+bool glm_plus::closest_point_on_boundary(fvec2 x, const polygon_list& shape, segment_point* result) {
+	segment_point best = no_point();
+	std::size_t ring = 0;
+	for (std::size_t r = 0; r < shape.size(); ++r) {
+		std::size_t first = shape.offsets[r];
+		std::size_t count = shape.offsets[r + 1] - first;
+		if (count == 0)
+			continue;
+		std::uint32_t id = best.id;
+		closest_ring(x, shape.vertices.data() + first, count, true, static_cast<std::uint32_t>(first), best);
+		if (best.id != id)
+			ring = r;
+	}
+	if (best.id == std::numeric_limits<std::uint32_t>::max())
+		return false;
+	std::size_t first = shape.offsets[ring];
+	set_point(shape.vertices.data() + first, shape.offsets[ring + 1] - first, first, best);
+	*result = best;
+	return true;
+}
+
+void polyline_index::build(const fvec2* vertices, std::size_t count, bool closed, std::size_t leaf_size, arena* scratch) {
+	arena_scope scope(scratch);
+	arena_allocator<fsegment> alloc(scratch);
+	arena_vector<fsegment> segments(alloc);
+	segments.reserve(count + 1);
+	if (count == 1)
+		segments.emplace_back(vertices[0], vertices[0]);
+	for (std::size_t i = 0; i + 1 < count; ++i)
+		segments.emplace_back(vertices[i], vertices[i + 1]);
+	if (closed && count > 1)
+		segments.emplace_back(vertices[count - 1], vertices[0]);
+	build(segments.data(), segments.size(), leaf_size, scratch);
+}
+
+void polyline_index::build(const polygon_list& shape, std::size_t leaf_size, arena* scratch) {
+	// Each polygon has as many segments as vertices, so segment ids are vertex indices.
+	arena_scope scope(scratch);
+	arena_allocator<fsegment> alloc(scratch);
+	arena_vector<fsegment> segments(alloc);
+	segments.reserve(shape.vertices.size());
+	for (std::size_t r = 0; r < shape.size(); ++r) {
+		std::size_t first = shape.offsets[r];
+		std::size_t count = shape.offsets[r + 1] - first;
+		for (std::size_t i = 0; i < count; ++i)
+			segments.emplace_back(shape.vertices[first + i], shape.vertices[first + (i + 1) % count]);
+	}
+	build(segments.data(), segments.size(), leaf_size, scratch);
+}
+
+void polyline_index::build(const fsegment* segments, std::size_t count, std::size_t leaf_size, arena* scratch) {
+	build_segment_index(segments, count, &data, leaf_size, scratch);
+	// Freshly built data is always valid, so it does not need to be verified.
+	segment_index::open(data.data(), data.size(), &index, false);
+}
+
+void polyline_index::closest(executor& pool, const fvec2* xs, std::size_t count, segment_point* result, float max_distance) const {
+	pool.parallel_for(count, 0, [=](std::size_t begin, std::size_t end) {
+		index.closest(xs + begin, end - begin, result + begin, max_distance);
+	});
+}
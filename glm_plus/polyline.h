@@ -0,0 +1,131 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+/**
+ * @file polyline.h
+ * This header contains closest point queries against polylines and polygon boundaries.
+ * Segment @c i of a polyline runs from vertex @c i to vertex <tt>i + 1</tt>.
+ * Closed polylines have one more segment, from the last vertex back to the first one,
+ * and a polyline with a single vertex has a single zero-length segment.
+ * Results are @ref segment_point structures. If several segments are equally close, the one with the smallest index is found.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "executor.h"
+#include "glm/gtc/type_precision.hpp"
+#include "polygon.h"
+#include "segment_index.h"
+
+namespace glm_plus {
+
+/**
+ * Finds the point on a polyline, closest to a point.
+ * Runs in O(n), with segments tested in vectorized blocks. Use @ref polyline_index for long polylines.
+ * @param x Point to test.
+ * @param vertices Polyline vertices.
+ * @param count Number of vertices.
+ * @param result Found point, where @c id is the segment index.
+ * @param closed Whether the polyline is closed.
+ * @return @c True on success, @c false if the polyline has no vertices, in which case @p result is left unchanged.
+ */
+bool closest_point_on_polyline(glm::fvec2 x, const glm::fvec2* vertices, std::size_t count, segment_point* result, bool closed = false);
+
+/**
+ * Finds the point on a polyline, closest to each of many points.
+ * @param xs Points to test.
+ * @param count Number of points.
+ * @param vertices Polyline vertices.
+ * @param vertex_count Number of vertices. Must not be 0.
+ * @param result Found point for each point.
+ * @param closed Whether the polyline is closed.
+ */
+void closest_point_on_polyline(const glm::fvec2* xs, std::size_t count, const glm::fvec2* vertices, std::size_t vertex_count,
+		segment_point* result, bool closed = false);
+
+/**
+ * Parallel version of the batched @ref closest_point_on_polyline.
+ * @param pool Executor to run on.
+ */
+void closest_point_on_polyline(executor& pool, const glm::fvec2* xs, std::size_t count, const glm::fvec2* vertices, std::size_t vertex_count,
+		segment_point* result, bool closed = false);
+
+/**
+ * Finds the point on the boundary of polygons, closest to a point.
+ * @param x Point to test.
+ * @param shape Polygons. Each polygon is a closed polyline.
+ * @param result Found point, where @c id is the index of the first vertex of the segment in <tt>shape.vertices</tt>.
+ * @return @c True on success, @c false if there are no vertices, in which case @p result is left unchanged.
+ */
+bool closest_point_on_boundary(glm::fvec2 x, const polygon_list& shape, segment_point* result);
+
+/**
+ * Acceleration structure for closest point queries against a long polyline or polygon boundaries.
+ * Segments are stored in a @ref segment_index, so queries run in O(log n) for typical inputs.
+ * Results are the same as for @ref closest_point_on_polyline and @ref closest_point_on_boundary,
+ * as long as floating-point contraction stays off, see @ref line_batch.h.
+ */
+class polyline_index {
+public:
+	polyline_index() = default;
+	polyline_index(const polyline_index&) = delete;
+	polyline_index& operator=(const polyline_index&) = delete;
+	polyline_index(polyline_index&&) = default;
+	polyline_index& operator=(polyline_index&&) = default;
+
+	/**
+	 * Builds the index for a polyline. Previous contents are replaced.
+	 * @param vertices Polyline vertices.
+	 * @param count Number of vertices.
+	 * @param closed Whether the polyline is closed.
+	 * @param leaf_size Maximum number of segments in a leaf.
+	 * @param scratch Arena for temporary buffers while building. Heap is used if @c nullptr.
+	 */
+	void build(const glm::fvec2* vertices, std::size_t count, bool closed = false, std::size_t leaf_size = 16, arena* scratch = nullptr);
+
+	/**
+	 * Builds the index for the boundary of polygons. Previous contents are replaced.
+	 * Segment ids are indices of their first vertex in <tt>shape.vertices</tt>.
+	 * @param shape Polygons.
+	 * @param leaf_size Maximum number of segments in a leaf.
+	 * @param scratch Arena for temporary buffers while building. Heap is used if @c nullptr.
+	 */
+	void build(const polygon_list& shape, std::size_t leaf_size = 16, arena* scratch = nullptr);
+
+	/**
+	 * Finds the closest point, see @ref segment_index::closest.
+	 */
+	bool closest(glm::fvec2 x, segment_point* result, float max_distance = std::numeric_limits<float>::infinity()) const {
+		return index.closest(x, result, max_distance);
+	}
+
+	/**
+	 * Finds the closest point to each of many points, see @ref segment_index::closest.
+	 */
+	void closest(const glm::fvec2* xs, std::size_t count, segment_point* result, float max_distance = std::numeric_limits<float>::infinity()) const {
+		index.closest(xs, count, result, max_distance);
+	}
+
+	/**
+	 * Parallel version of the batched @ref closest.
+	 * @param pool Executor to run on.
+	 */
+	void closest(executor& pool, const glm::fvec2* xs, std::size_t count, segment_point* result,
+		float max_distance = std::numeric_limits<float>::infinity()) const;
+
+	[[nodiscard]] const segment_index& get_index() const { return index; }
+
+private:
+	void build(const fsegment* segments, std::size_t count, std::size_t leaf_size, arena* scratch);
+
+	std::vector<std::uint8_t> data;
+	segment_index index;
+};
+
+}
@@ -0,0 +1,295 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "predicates.h"
+
+#include <cassert>
+#include <cmath>
+
+using namespace glm_plus;
+using namespace glm;
+
+namespace {
+
+// An expansion is an array of non-overlapping doubles, sorted by increasing magnitude, whose exact sum is the represented value.
+// Its sign is the sign of the last (largest) component. Zero components are removed, but at least one is always kept.
+
+constexpr double epsilon = 1.1102230246251565e-16;  // 2^-53, half of the double machine epsilon.
+constexpr double orient2d_error_bound = (3.0 + 16.0 * epsilon) * epsilon;
+constexpr double incircle_error_bound = (10.0 + 96.0 * epsilon) * epsilon;
+
+constexpr int max_product_terms = 512;
+
+// x + y == a + b exactly, if |a| >= |b|.
+inline void fast_two_sum(double a, double b, double& x, double& y) {
+	x = a + b;
+	double b_virtual = x - a;
+	y = b - b_virtual;
+}
+
+// x + y == a + b exactly.
+inline void two_sum(double a, double b, double& x, double& y) {
+	x = a + b;
+	double b_virtual = x - a;
+	double a_virtual = x - b_virtual;
+	double b_round = b - b_virtual;
+	double a_round = a - a_virtual;
+	y = a_round + b_round;
+}
+
+// x + y == a - b exactly.
+inline void two_diff(double a, double b, double& x, double& y) {
+	x = a - b;
+	double b_virtual = a - x;
+	double a_virtual = x + b_virtual;
+	double b_round = b_virtual - b;
+	double a_round = a - a_virtual;
+	y = a_round + b_round;
+}
+
+// x + y == a * b exactly. Uses fma instead of splitting the operands,
+// because splitting breaks if the compiler contracts its multiply and subtract into a fused operation.
+inline void two_product(double a, double b, double& x, double& y) {
+	x = a * b;
+	y = std::fma(a, b, -x);
+}
+
+int expansion_sum(int elen, const double* e, int flen, const double* f, double* h) {
+	int ei = 0;
+	int fi = 0;
+	int hi = 0;
+	double enow = e[0];
+	double fnow = f[0];
+	auto next_e = [&] { enow = ++ei < elen ? e[ei] : 0.0; };
+	auto next_f = [&] { fnow = ++fi < flen ? f[fi] : 0.0; };
+
+	double q;
+	double q_new;
+	double hh;
+	if ((fnow > enow) == (fnow > -enow)) {
+		q = enow;
+		next_e();
+	}
+	else {
+		q = fnow;
+		next_f();
+	}
+
+	if (ei < elen && fi < flen) {
+		if ((fnow > enow) == (fnow > -enow)) {
+			fast_two_sum(enow, q, q_new, hh);
+			next_e();
+		}
+		else {
+			fast_two_sum(fnow, q, q_new, hh);
+			next_f();
+		}
+		q = q_new;
+		if (hh != 0.0)
+			h[hi++] = hh;
+
+		while (ei < elen && fi < flen) {
+			if ((fnow > enow) == (fnow > -enow)) {
+				two_sum(q, enow, q_new, hh);
+				next_e();
+			}
+			else {
+				two_sum(q, fnow, q_new, hh);
+				next_f();
+			}
+			q = q_new;
+			if (hh != 0.0)
+				h[hi++] = hh;
+		}
+	}
+
+	while (ei < elen) {
+		two_sum(q, enow, q_new, hh);
+		next_e();
+		q = q_new;
+		if (hh != 0.0)
+			h[hi++] = hh;
+	}
+	while (fi < flen) {
+		two_sum(q, fnow, q_new, hh);
+		next_f();
+		q = q_new;
+		if (hh != 0.0)
+			h[hi++] = hh;
+	}
+
+	if (q != 0.0 || hi == 0)
+		h[hi++] = q;
+	return hi;
+}
+
+int scale_expansion(int elen, const double* e, double b, double* h) {
+	int hi = 0;
+	double q;
+	double hh;
+	two_product(e[0], b, q, hh);
+	if (hh != 0.0)
+		h[hi++] = hh;
+
+	for (int ei = 1; ei < elen; ++ei) {
+		double product1;
+		double product0;
+		double sum;
+		two_product(e[ei], b, product1, product0);
+		two_sum(q, product0, sum, hh);
+		if (hh != 0.0)
+			h[hi++] = hh;
+		fast_two_sum(product1, sum, q, hh);
+		if (hh != 0.0)
+			h[hi++] = hh;
+	}
+
+	if (q != 0.0 || hi == 0)
+		h[hi++] = q;
+	return hi;
+}
+
+int expansion_product(int elen, const double* e, int flen, const double* f, double* h) {
+	assert(2 * elen * flen <= max_product_terms);
+	double scaled[max_product_terms];
+	double sum[2][max_product_terms];
+	int length = scale_expansion(elen, e, f[0], sum[0]);
+	int current = 0;
+	for (int fi = 1; fi < flen; ++fi) {
+		int scaled_length = scale_expansion(elen, e, f[fi], scaled);
+		length = expansion_sum(length, sum[current], scaled_length, scaled, sum[1 - current]);
+		current = 1 - current;
+	}
+	for (int i = 0; i < length; ++i)
+		h[i] = sum[current][i];
+	return length;
+}
+
+int negate(int elen, double* e) {
+	for (int i = 0; i < elen; ++i)
+		e[i] = -e[i];
+	return elen;
+}
+
+// Exact a * d - b * c, for two-component expansions a, b, c and d.
+int cross_difference(const double* a, const double* b, const double* c, const double* d, double* h) {
+	double ad[8];
+	double bc[8];
+	int ad_length = expansion_product(2, a, 2, d, ad);
+	int bc_length = negate(expansion_product(2, b, 2, c, bc), bc);
+	return expansion_sum(ad_length, ad, bc_length, bc, h);
+}
+
+double orient2d_exact(dvec2 a, dvec2 b, dvec2 c) {
+	double acx[2];
+	double acy[2];
+	double bcx[2];
+	double bcy[2];
+	two_diff(a.x, c.x, acx[1], acx[0]);
+	two_diff(a.y, c.y, acy[1], acy[0]);
+	two_diff(b.x, c.x, bcx[1], bcx[0]);
+	two_diff(b.y, c.y, bcy[1], bcy[0]);
+
+	double det[16];
+	int length = cross_difference(acx, acy, bcx, bcy, det);
+	return det[length - 1];
+}
+
+double incircle_exact(dvec2 a, dvec2 b, dvec2 c, dvec2 d) {
+	double adx[2];
+	double ady[2];
+	double bdx[2];
+	double bdy[2];
+	double cdx[2];
+	double cdy[2];
+	two_diff(a.x, d.x, adx[1], adx[0]);
+	two_diff(a.y, d.y, ady[1], ady[0]);
+	two_diff(b.x, d.x, bdx[1], bdx[0]);
+	two_diff(b.y, d.y, bdy[1], bdy[0]);
+	two_diff(c.x, d.x, cdx[1], cdx[0]);
+	two_diff(c.y, d.y, cdy[1], cdy[0]);
+
+	// Each point contributes lift * cross, where lift = dx^2 + dy^2 and cross is the 2x2 determinant of the other two points.
+	auto term = [](const double* px, const double* py, const double* qx, const double* qy, const double* rx, const double* ry, double* h) {
+		double xx[8];
+		double yy[8];
+		double lift[16];
+		double cross[16];
+		int xx_length = expansion_product(2, px, 2, px, xx);
+		int yy_length = expansion_product(2, py, 2, py, yy);
+		int lift_length = expansion_sum(xx_length, xx, yy_length, yy, lift);
+		int cross_length = cross_difference(qx, qy, rx, ry, cross);
+		return expansion_product(lift_length, lift, cross_length, cross, h);
+	};
+
+	double aterm[max_product_terms];
+	double bterm[max_product_terms];
+	double cterm[max_product_terms];
+	double ab[2 * max_product_terms];
+	double det[3 * max_product_terms];
+	int alength = term(adx, ady, bdx, bdy, cdx, cdy, aterm);
+	int blength = term(bdx, bdy, cdx, cdy, adx, ady, bterm);
+	int clength = term(cdx, cdy, adx, ady, bdx, bdy, cterm);
+	int ablength = expansion_sum(alength, aterm, blength, bterm, ab);
+	int length = expansion_sum(ablength, ab, clength, cterm, det);
+	return det[length - 1];
+}
+
+}
+
+double glm_plus::orient2d(dvec2 a, dvec2 b, dvec2 c) {
+	double left = (a.x - c.x) * (b.y - c.y);
+	double right = (a.y - c.y) * (b.x - c.x);
+	double det = left - right;
+
+	// If both products have different signs (or one is zero), their difference can not cancel, so det has the correct sign.
+	double sum;
+	if (left > 0.0) {
+		if (right <= 0.0)
+			return det;
+		sum = left + right;
+	}
+	else if (left < 0.0) {
+		if (right >= 0.0)
+			return det;
+		sum = -left - right;
+	}
+	else {
+		return det;
+	}
+
+	if (det >= orient2d_error_bound * sum || -det >= orient2d_error_bound * sum)
+		return det;
+	return orient2d_exact(a, b, c);
+}
+
+double glm_plus::incircle(dvec2 a, dvec2 b, dvec2 c, dvec2 d) {
+	double adx = a.x - d.x;
+	double bdx = b.x - d.x;
+	double cdx = c.x - d.x;
+	double ady = a.y - d.y;
+	double bdy = b.y - d.y;
+	double cdy = c.y - d.y;
+
+	double bdxcdy = bdx * cdy;
+	double cdxbdy = cdx * bdy;
+	double alift = adx * adx + ady * ady;
+
+	double cdxady = cdx * ady;
+	double adxcdy = adx * cdy;
+	double blift = bdx * bdx + bdy * bdy;
+
+	double adxbdy = adx * bdy;
+	double bdxady = bdx * ady;
+	double clift = cdx * cdx + cdy * cdy;
+
+	double det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady);
+	double permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * alift
+		+ (std::abs(cdxady) + std::abs(adxcdy)) * blift
+		+ (std::abs(adxbdy) + std::abs(bdxady)) * clift;
+	double bound = incircle_error_bound * permanent;
+	if (det > bound || -det > bound)
+		return det;
+	return incircle_exact(a, b, c, d);
+}
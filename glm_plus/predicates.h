@@ -0,0 +1,83 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+/**
+ * @file predicates.h
+ * This header contains robust geometric predicates, which always return the correct sign.
+ * They first evaluate the determinant in double precision and check it against an error bound.
+ * Only if the sign is uncertain, they recalculate it exactly with floating point expansions
+ * (J. R. Shewchuk, Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric Predicates, 1997).
+ * Inputs are points with @c float or @c double coordinates, which are converted to @c double exactly.
+ * Results are correct as long as no intermediate value overflows or underflows.
+ */
+
+#pragma once
+
+#include "glm/gtc/type_precision.hpp"
+
+namespace glm_plus {
+
+/**
+ * Calculates the orientation of three points.
+ * The result has the same sign as <tt>cross(b - a, c - a)</tt> calculated exactly.
+ * It is positive when @p c is right of the line running from @p a to @p b, in the same sense as @ref is_right_of_line,
+ * negative when it is left of the line, and exactly zero when the points are collinear.
+ * In a coordinate system with y pointing up, positive means the points run counter-clockwise.
+ * @param a First point on the line.
+ * @param b Second point on the line.
+ * @param c Point to test.
+ * @return Value with the sign of the orientation. Its magnitude approximates twice the area of the triangle.
+ */
+double orient2d(glm::dvec2 a, glm::dvec2 b, glm::dvec2 c);
+
+/**
+ * Check if a point is inside the circle running through three other points.
+ * The result is positive when @p d is inside the circle, negative when it is outside and exactly zero when it is on the circle,
+ * as long as @ref orient2d of @p a, @p b and @p c is positive. Otherwise, the sign is reversed.
+ * @param a First point on the circle.
+ * @param b Second point on the circle.
+ * @param c Third point on the circle.
+ * @param d Point to test.
+ * @return Value with the sign of the incircle determinant.
+ */
+double incircle(glm::dvec2 a, glm::dvec2 b, glm::dvec2 c, glm::dvec2 d);
+
+inline double orient2d(glm::fvec2 a, glm::fvec2 b, glm::fvec2 c) {
+	return orient2d(glm::dvec2(a), glm::dvec2(b), glm::dvec2(c));
+}
+
+inline double incircle(glm::fvec2 a, glm::fvec2 b, glm::fvec2 c, glm::fvec2 d) {
+	return incircle(glm::dvec2(a), glm::dvec2(b), glm::dvec2(c), glm::dvec2(d));
+}
+
+/**
+ * Check if the point is right of or on the line, exactly.
+ * Same as @ref is_right_of_line, but points exactly on the line are always detected.
+ * @param x Point to test.
+ * @param a1 First point on the line.
+ * @param a2 Second point on the line.
+ * @return @c True if the point is right of or on the line, @c false otherwise.
+ */
+template<typename T>
+bool is_right_of_line_exact(glm::vec<2, T> x, glm::vec<2, T> a1, glm::vec<2, T> a2) {
+	return orient2d(glm::dvec2(a1), glm::dvec2(a2), glm::dvec2(x)) >= 0.0;
+}
+
+/**
+ * Check if two lines coincide, exactly.
+ * Unlike @ref lines_coincide, there is no margin, which would depend on the coordinate magnitude.
+ * @param a1 First point on the first line.
+ * @param a2 Second point on the first line.
+ * @param b1 First point on the second line.
+ * @param b2 Second point on the second line.
+ * @return @c True if lines coincide, @c false otherwise.
+ */
+template<typename T>
+bool lines_coincide_exact(glm::vec<2, T> a1, glm::vec<2, T> a2, glm::vec<2, T> b1, glm::vec<2, T> b2) {
+	glm::dvec2 p1(a1);
+	glm::dvec2 p2(a2);
+	return orient2d(p1, p2, glm::dvec2(b1)) == 0.0 && orient2d(p1, p2, glm::dvec2(b2)) == 0.0;
+}
+
+}
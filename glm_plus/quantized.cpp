@@ -0,0 +1,200 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "quantized.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "line_batch.h"
+
+using namespace glm_plus;
+using namespace glm;
+
+namespace {
+
+// Segments or points decoded at once, small enough to stay on the stack.
+constexpr std::size_t block_size = 256;
+
+constexpr float grid_steps = 65535.0f;
+
+// Converting NaN to an integer is undefined, so the lower bound is tested in a way that NaN fails, and it becomes 0.
+std::uint16_t encode_coordinate(float v, float origin, float inv_step) {
+	float g = std::round((v - origin) * inv_step);
+	if (!(g > 0.0f))
+		return 0;
+	return static_cast<std::uint16_t>(std::min(g, grid_steps));
+}
+
+std::uint32_t zigzag(std::int32_t v) {
+	return (static_cast<std::uint32_t>(v) << 1) ^ static_cast<std::uint32_t>(v >> 31);
+}
+
+std::int32_t unzigzag(std::uint32_t v) {
+	return static_cast<std::int32_t>(v >> 1) ^ -static_cast<std::int32_t>(v & 1);
+}
+
+void write_varint(std::uint32_t v, std::vector<std::uint8_t>& out) {
+	while (v >= 0x80) {
+		out.push_back(static_cast<std::uint8_t>(v | 0x80));
+		v >>= 7;
+	}
+	out.push_back(static_cast<std::uint8_t>(v));
+}
+
+std::uint32_t read_varint(const std::uint8_t*& p) {
+	std::uint32_t v = 0;
+	for (int shift = 0;; shift += 7) {
+		std::uint8_t b = *p++;
+		v |= static_cast<std::uint32_t>(b & 0x7f) << shift;
+		if (!(b & 0x80))
+			return v;
+	}
+}
+
+}
+
+quantization::quantization(const farea& bounds) :
+		origin(bounds.topleft),
+		step((bounds.bottomright.x - bounds.topleft.x) / grid_steps, (bounds.bottomright.y - bounds.topleft.y) / grid_steps) {}
+
+u16vec2 quantization::encode(fvec2 p) const {
+	float inv_x = step.x > 0.0f ? 1.0f / step.x : 0.0f;
+	float inv_y = step.y > 0.0f ? 1.0f / step.y : 0.0f;
+	return {encode_coordinate(p.x, origin.x, inv_x), encode_coordinate(p.y, origin.y, inv_y)};
+}
+
+farea quantized_segment_view::get_bounds(std::size_t i) const {
+	fvec2 lo = q.decode(std::min(x1s[i], x2s[i]), std::min(y1s[i], y2s[i]));
+	fvec2 hi = q.decode(std::max(x1s[i], x2s[i]), std::max(y1s[i], y2s[i]));
+	return {fpos(lo), fpos(hi)};
+}
+
+quantized_segment_view quantized_segment_view::subview(std::size_t first, std::size_t n) const {
+	quantized_segment_view v = *this;
+	v.x1s += first;
+	v.y1s += first;
+	v.x2s += first;
+	v.y2s += first;
+	v.count = n;
+	return v;
+}
+
+void quantized_segment_view::decode(std::size_t first, std::size_t n, float* xs1, float* ys1, float* xs2, float* ys2) const {
+	const float ox = q.origin.x;
+	const float oy = q.origin.y;
+	const float sx = q.step.x;
+	const float sy = q.step.y;
+	for (std::size_t i = 0; i < n; ++i) {
+		xs1[i] = ox + static_cast<float>(x1s[first + i]) * sx;
+		ys1[i] = oy + static_cast<float>(y1s[first + i]) * sy;
+		xs2[i] = ox + static_cast<float>(x2s[first + i]) * sx;
+		ys2[i] = oy + static_cast<float>(y2s[first + i]) * sy;
+	}
+}
+
+quantized_segments::quantized_segments(const fsegment* segments, std::size_t count, const farea& bounds) :
+		q(bounds),
+		data(4 * count),
+		count(count) {
+	for (std::size_t i = 0; i < count; ++i) {
+		u16vec2 p1 = q.encode(segments[i].p1);
+		u16vec2 p2 = q.encode(segments[i].p2);
+		data[i] = p1.x;
+		data[count + i] = p1.y;
+		data[2 * count + i] = p2.x;
+		data[3 * count + i] = p2.y;
+	}
+}
+
+quantized_polyline_view::iterator::iterator(const std::uint8_t* data, std::size_t remaining, const quantization& q) :
+		data(data),
+		remaining(remaining),
+		q(q) {
+	if (remaining > 0)
+		read();
+}
+
+quantized_polyline_view::iterator& quantized_polyline_view::iterator::operator++() {
+	if (--remaining > 0)
+		read();
+	return *this;
+}
+
+void quantized_polyline_view::iterator::read() {
+	x = static_cast<std::uint16_t>(x + unzigzag(read_varint(data)));
+	y = static_cast<std::uint16_t>(y + unzigzag(read_varint(data)));
+}
+
+void quantized_polyline_view::decode(float* xs, float* ys) const {
+	std::size_t i = 0;
+	for (iterator it = begin(); it != end(); ++it, ++i) {
+		fvec2 p = *it;
+		xs[i] = p.x;
+		ys[i] = p.y;
+	}
+}
+
+quantized_polyline::quantized_polyline(const fvec2* points, std::size_t count, const farea& bounds) :
+		q(bounds),
+		count(count) {
+	// Most deltas between neighboring points fit into one byte per coordinate.
+	data.reserve(2 * count);
+	std::int32_t x = 0;
+	std::int32_t y = 0;
+	for (std::size_t i = 0; i < count; ++i) {
+		u16vec2 p = q.encode(points[i]);
+		write_varint(zigzag(p.x - x), data);
+		write_varint(zigzag(p.y - y), data);
+		x = p.x;
+		y = p.y;
+	}
+}
+
+std::size_t glm_plus::line_segments_intersect(fvec2 a1, fvec2 a2, const quantized_segment_view& segments, std::uint32_t* hits, float* ts) {
+	float x1s[block_size];
+	float y1s[block_size];
+	float x2s[block_size];
+	float y2s[block_size];
+	std::size_t n = 0;
+	for (std::size_t i = 0; i < segments.size(); i += block_size) {
+		std::size_t block = std::min(block_size, segments.size() - i);
+		segments.decode(i, block, x1s, y1s, x2s, y2s);
+		std::size_t m = line_segments_intersect(a1, a2, x1s, y1s, x2s, y2s, block, hits + n, ts + n);
+		for (std::size_t k = n; k < n + m; ++k)
+			hits[k] += static_cast<std::uint32_t>(i);
+		n += m;
+	}
+	return n;
+}
+
+std::size_t glm_plus::line_segments_intersect(fvec2 a1, fvec2 a2, const quantized_polyline_view& polyline, std::uint32_t* hits, float* ts) {
+	if (polyline.size() < 2)
+		return 0;
+
+	// Edges of a block run between neighboring points, so the last point is carried over as the first point of the next block.
+	float xs[block_size + 1];
+	float ys[block_size + 1];
+	std::size_t n = 0;
+	std::size_t first = 0;
+	std::size_t filled = 0;
+	for (quantized_polyline_view::iterator it = polyline.begin(); it != polyline.end(); ++it) {
+		fvec2 p = *it;
+		xs[filled] = p.x;
+		ys[filled] = p.y;
+		++filled;
+		if (filled == block_size + 1 || first + filled == polyline.size()) {
+			std::size_t edges = filled - 1;
+			std::size_t m = line_segments_intersect(a1, a2, xs, ys, xs + 1, ys + 1, edges, hits + n, ts + n);
+			for (std::size_t k = n; k < n + m; ++k)
+				hits[k] += static_cast<std::uint32_t>(first);
+			n += m;
+			first += edges;
+			xs[0] = xs[edges];
+			ys[0] = ys[edges];
+			filled = 1;
+		}
+	}
+	return n;
+}
\ No newline at end of file
@@ -0,0 +1,276 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+/**
+ * @file quantized.h
+ * This header contains compact storage formats for large static sets of line segments and polylines.
+ * Coordinates are stored as 16-bit integers on a uniform grid over known bounds, typically a map tile.
+ * Segments take 8 bytes instead of 16, and polyline points are delta encoded, usually in 2 bytes instead of 8.
+ * Views read the data in place, so it can come from a memory mapped file,
+ * and decode only the elements that are accessed.
+ * Decoded coordinates differ from the original ones by at most half a grid step, see @ref quantization::get_max_error.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "glm/gtc/type_precision.hpp"
+#include "types.h"
+
+namespace glm_plus {
+
+/**
+ * Mapping between coordinates within bounds and 16-bit integers.
+ * Bounds are divided into 65535 equal steps in each direction.
+ */
+struct quantization {
+	quantization() = default;
+	explicit quantization(const farea& bounds);
+
+	/**
+	 * Converts a point to the nearest grid point. Points outside bounds are clamped, and NaN coordinates become 0.
+	 * @param p Point.
+	 * @return Grid coordinates.
+	 */
+	[[nodiscard]] glm::u16vec2 encode(glm::fvec2 p) const;
+
+	/**
+	 * Converts grid coordinates back to a point.
+	 * @param x Grid x coordinate.
+	 * @param y Grid y coordinate.
+	 * @return Point.
+	 */
+	[[nodiscard]] glm::fvec2 decode(std::uint16_t x, std::uint16_t y) const {
+		return {origin.x + static_cast<float>(x) * step.x, origin.y + static_cast<float>(y) * step.y};
+	}
+
+	/** Largest difference between a point within bounds and its decoded grid point, in each direction. */
+	[[nodiscard]] glm::fvec2 get_max_error() const { return step * 0.5f; }
+
+	glm::fvec2 origin = glm::fvec2(0.0f);
+	glm::fvec2 step = glm::fvec2(0.0f);
+};
+
+/**
+ * Read-only view of quantized line segments, stored as a structure of arrays of grid coordinates.
+ * The view does not own the data.
+ */
+class quantized_segment_view {
+public:
+	quantized_segment_view() = default;
+
+	/**
+	 * @param data Grid coordinates: @p count first point x coordinates, followed by first point y,
+	 * second point x and second point y coordinates.
+	 * @param count Number of line segments.
+	 * @param q Quantization used to encode the data.
+	 */
+	quantized_segment_view(const std::uint16_t* data, std::size_t count, const quantization& q) :
+			x1s(data),
+			y1s(data + count),
+			x2s(data + 2 * count),
+			y2s(data + 3 * count),
+			count(count),
+			q(q) {}
+
+	[[nodiscard]] std::size_t size() const { return count; }
+	[[nodiscard]] const quantization& get_quantization() const { return q; }
+
+	/**
+	 * Decodes a line segment.
+	 * @param i Index of the line segment.
+	 */
+	[[nodiscard]] fsegment operator[](std::size_t i) const { return {q.decode(x1s[i], y1s[i]), q.decode(x2s[i], y2s[i])}; }
+
+	/**
+	 * Returns bounds of a decoded line segment, for example to insert it into @ref aabb_tree or @ref spatial_hash.
+	 * @param i Index of the line segment.
+	 */
+	[[nodiscard]] farea get_bounds(std::size_t i) const;
+
+	/**
+	 * Returns a view of a range of line segments.
+	 * @param first Index of the first line segment.
+	 * @param n Number of line segments.
+	 */
+	[[nodiscard]] quantized_segment_view subview(std::size_t first, std::size_t n) const;
+
+	/**
+	 * Decodes a range of line segments into separate coordinate arrays, as used in @ref line_batch.h.
+	 * @param first Index of the first line segment.
+	 * @param n Number of line segments.
+	 * @param xs1 X coordinates of the first points.
+	 * @param ys1 Y coordinates of the first points.
+	 * @param xs2 X coordinates of the second points.
+	 * @param ys2 Y coordinates of the second points.
+	 */
+	void decode(std::size_t first, std::size_t n, float* xs1, float* ys1, float* xs2, float* ys2) const;
+
+private:
+	const std::uint16_t* x1s = nullptr;
+	const std::uint16_t* y1s = nullptr;
+	const std::uint16_t* x2s = nullptr;
+	const std::uint16_t* y2s = nullptr;
+	std::size_t count = 0;
+	quantization q;
+};
+
+/**
+ * Quantized line segments, which own their data.
+ */
+class quantized_segments {
+public:
+	quantized_segments() = default;
+
+	/**
+	 * Encodes line segments.
+	 * @param segments Line segments.
+	 * @param count Number of line segments.
+	 * @param bounds Bounds of the grid. Should contain all line segments.
+	 */
+	quantized_segments(const fsegment* segments, std::size_t count, const farea& bounds);
+
+	[[nodiscard]] quantized_segment_view view() const { return {data.data(), count, q}; }
+	[[nodiscard]] std::size_t size() const { return count; }
+	[[nodiscard]] const quantization& get_quantization() const { return q; }
+
+	/** Encoded data, in the layout expected by @ref quantized_segment_view. */
+	[[nodiscard]] const std::vector<std::uint16_t>& get_data() const { return data; }
+
+private:
+	quantization q;
+	std::vector<std::uint16_t> data;
+	std::size_t count = 0;
+};
+
+/**
+ * Read-only view of a quantized polyline.
+ * Each point is stored as the difference of grid coordinates from the previous point (the first from zero),
+ * with x and y encoded as zigzag variable length integers (7 bits per byte, high bit set on all but the last byte).
+ * Points can only be decoded in order. The view does not own the data.
+ */
+class quantized_polyline_view {
+public:
+	/**
+	 * Forward iterator over decoded points.
+	 * Keeps a copy of the quantization, so it stays valid after the view it came from is destroyed, as long as the data does.
+	 */
+	class iterator {
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef glm::fvec2 value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const glm::fvec2* pointer;
+		typedef glm::fvec2 reference;
+
+		iterator() = default;
+		iterator(const std::uint8_t* data, std::size_t remaining, const quantization& q);
+
+		glm::fvec2 operator*() const { return q.decode(x, y); }
+		iterator& operator++();
+		iterator operator++(int) {
+			iterator it = *this;
+			++*this;
+			return it;
+		}
+		bool operator==(const iterator& other) const { return remaining == other.remaining; }
+		bool operator!=(const iterator& other) const { return remaining != other.remaining; }
+
+	private:
+		void read();
+
+		const std::uint8_t* data = nullptr;
+		std::size_t remaining = 0;
+		quantization q;
+		std::uint16_t x = 0;
+		std::uint16_t y = 0;
+	};
+
+	quantized_polyline_view() = default;
+
+	/**
+	 * @param data Encoded points.
+	 * @param count Number of points.
+	 * @param q Quantization used to encode the data.
+	 */
+	quantized_polyline_view(const std::uint8_t* data, std::size_t count, const quantization& q) :
+			data(data),
+			count(count),
+			q(q) {}
+
+	[[nodiscard]] std::size_t size() const { return count; }
+	[[nodiscard]] const quantization& get_quantization() const { return q; }
+	[[nodiscard]] iterator begin() const { return {data, count, q}; }
+	[[nodiscard]] iterator end() const { return {}; }
+
+	/**
+	 * Decodes all points into separate coordinate arrays.
+	 * @param xs X coordinates, room for @ref size elements.
+	 * @param ys Y coordinates, room for @ref size elements.
+	 */
+	void decode(float* xs, float* ys) const;
+
+private:
+	const std::uint8_t* data = nullptr;
+	std::size_t count = 0;
+	quantization q;
+};
+
+/**
+ * Quantized polyline, which owns its data.
+ */
+class quantized_polyline {
+public:
+	quantized_polyline() = default;
+
+	/**
+	 * Encodes a polyline.
+	 * @param points Polyline points.
+	 * @param count Number of points.
+	 * @param bounds Bounds of the grid. Should contain all points.
+	 */
+	quantized_polyline(const glm::fvec2* points, std::size_t count, const farea& bounds);
+
+	[[nodiscard]] quantized_polyline_view view() const { return {data.data(), count, q}; }
+	[[nodiscard]] std::size_t size() const { return count; }
+	[[nodiscard]] const quantization& get_quantization() const { return q; }
+
+	/** Encoded data, in the layout expected by @ref quantized_polyline_view. */
+	[[nodiscard]] const std::vector<std::uint8_t>& get_data() const { return data; }
+
+private:
+	quantization q;
+	std::vector<std::uint8_t> data;
+	std::size_t count = 0;
+};
+
+/**
+ * Finds quantized line segments intersected by a single line segment.
+ * Same as the batched @ref line_segments_intersect, but segments are decoded in small blocks as they are tested.
+ * @param a1 First point of the line segment.
+ * @param a2 Second point of the line segment.
+ * @param segments Tested line segments.
+ * @param hits Indices of intersected line segments. Must have room for <tt>segments.size()</tt> elements.
+ * @param ts Intersection parameters along the line segment @p a1, @p a2 for each hit. Must have room for <tt>segments.size()</tt> elements.
+ * @return Number of hits.
+ */
+std::size_t line_segments_intersect(glm::fvec2 a1, glm::fvec2 a2, const quantized_segment_view& segments, std::uint32_t* hits, float* ts);
+
+/**
+ * Finds edges of a quantized polyline intersected by a single line segment.
+ * Edge @c i runs from point @c i to point <tt>i + 1</tt>. Points are decoded in small blocks as they are tested.
+ * @param a1 First point of the line segment.
+ * @param a2 Second point of the line segment.
+ * @param polyline Tested polyline.
+ * @param hits Indices of intersected edges. Must have room for <tt>polyline.size() - 1</tt> elements.
+ * @param ts Intersection parameters along the line segment @p a1, @p a2 for each hit. Must have room for <tt>polyline.size() - 1</tt> elements.
+ * @return Number of hits.
+ */
+std::size_t line_segments_intersect(glm::fvec2 a1, glm::fvec2 a2, const quantized_polyline_view& polyline, std::uint32_t* hits, float* ts);
+
+}
\ No newline at end of file
@@ -0,0 +1,463 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "segment_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "aabb_tree.h"
+#include "line_batch.h"
+
+using namespace glm_plus;
+using namespace glm;
+
+static_assert(sizeof(segment_index_header) == 64, "Header size is part of the file format.");
+static_assert(sizeof(segment_index_node) == 24, "Node size is part of the file format.");
+
+namespace {
+
+constexpr std::uint32_t byte_order_mark = 0x01020304u;
+
+// Segments of a leaf are tested against a ray in blocks of this size.
+constexpr std::size_t hit_block_size = 64;
+
+constexpr std::size_t align64(std::size_t x) {
+	return (x + 63) & ~std::size_t(63);
+}
+
+// Byte offsets of sections.
+struct layout {
+	std::size_t nodes;
+	std::size_t ids;
+	std::size_t positions;
+	std::size_t x1s;
+	std::size_t y1s;
+	std::size_t x2s;
+	std::size_t y2s;
+	std::size_t size;
+};
+
+layout make_layout(std::size_t node_count, std::size_t segment_count) {
+	layout l;
+	l.nodes = sizeof(segment_index_header);
+	l.ids = align64(l.nodes + node_count * sizeof(segment_index_node));
+	l.positions = align64(l.ids + segment_count * sizeof(std::uint32_t));
+	l.x1s = align64(l.positions + segment_count * sizeof(std::uint32_t));
+	l.y1s = align64(l.x1s + segment_count * sizeof(float));
+	l.x2s = align64(l.y1s + segment_count * sizeof(float));
+	l.y2s = align64(l.x2s + segment_count * sizeof(float));
+	l.size = align64(l.y2s + segment_count * sizeof(float));
+	return l;
+}
+
+// Mixes 64-bit words in 4 independent lanes, which keeps it much faster than reading the file from disk.
+// Size must be a multiple of 32 bytes.
+std::uint64_t checksum(const std::uint8_t* data, std::size_t size) {
+	std::uint64_t h[4] = {0x9e3779b97f4a7c15u, 0xbf58476d1ce4e5b9u, 0x94d049bb133111ebu, 0x2545f4914f6cdd1du};
+	for (std::size_t i = 0; i < size; i += 32) {
+		for (int lane = 0; lane < 4; ++lane) {
+			std::uint64_t w;
+			std::memcpy(&w, data + i + 8 * lane, sizeof(w));
+			h[lane] ^= w;
+			h[lane] = (h[lane] << 29 | h[lane] >> 35) * 0xff51afd7ed558ccdu;
+		}
+	}
+	std::uint64_t result = size;
+	for (std::uint64_t lane : h)
+		result = (result ^ lane) * 0xc4ceb9fe1a85ec53u;
+	return result ^ (result >> 32);
+}
+
+struct build_item {
+	fvec2 center;
+	std::uint32_t id;
+};
+
+void build_node(const fsegment* segments, build_item* items, std::size_t first, std::size_t count, std::size_t leaf_size,
+		arena_vector<segment_index_node>& nodes) {
+	auto index = nodes.size();
+	nodes.emplace_back();
+
+	segment_index_node node;
+	fvec2 lo(segments[items[first].id].p1);
+	fvec2 hi = lo;
+	fvec2 center_lo = items[first].center;
+	fvec2 center_hi = center_lo;
+	for (std::size_t i = first; i < first + count; ++i) {
+		const fsegment& s = segments[items[i].id];
+		lo = min(lo, min(s.p1, s.p2));
+		hi = max(hi, max(s.p1, s.p2));
+		center_lo = min(center_lo, items[i].center);
+		center_hi = max(center_hi, items[i].center);
+	}
+	node.min_x = lo.x;
+	node.min_y = lo.y;
+	node.max_x = hi.x;
+	node.max_y = hi.y;
+
+	if (count <= leaf_size) {
+		// Segments of a leaf are sorted by index, so the first of equally close segments in a leaf has the smallest index.
+		std::sort(items + first, items + first + count, [](const build_item& a, const build_item& b) {
+			return a.id < b.id;
+		});
+		node.first = static_cast<std::uint32_t>(first);
+		node.count = static_cast<std::uint32_t>(count);
+		nodes[index] = node;
+		return;
+	}
+
+	int axis = center_hi.x - center_lo.x >= center_hi.y - center_lo.y ? 0 : 1;
+	std::size_t half = count / 2;
+	std::nth_element(items + first, items + first + half, items + first + count, [axis](const build_item& a, const build_item& b) {
+		return a.center[axis] < b.center[axis];
+	});
+	build_node(segments, items, first, half, leaf_size, nodes);
+	node.first = static_cast<std::uint32_t>(nodes.size());
+	node.count = 0;
+	build_node(segments, items, first + half, count - half, leaf_size, nodes);
+	nodes[index] = node;
+}
+
+// Slab test of the segment from p1 to p1 + d against the node bounds.
+// Intersection tests accept segments, which touch within rounding errors, so the bounds grow by a margin relative to the coordinates.
+bool segment_overlaps(fvec2 p1, fvec2 d, const segment_index_node& n) {
+	float magnitude = std::max({1.0f, std::abs(p1.x), std::abs(p1.y), std::abs(n.min_x), std::abs(n.min_y), std::abs(n.max_x), std::abs(n.max_y)});
+	float margin = tiny_margin * magnitude;
+	float lo[2] = {n.min_x - margin, n.min_y - margin};
+	float hi[2] = {n.max_x + margin, n.max_y + margin};
+	float t0 = 0.0f;
+	float t1 = 1.0f;
+	for (int axis = 0; axis < 2; ++axis) {
+		if (d[axis] == 0.0f) {
+			if (p1[axis] < lo[axis] || p1[axis] > hi[axis])
+				return false;
+			continue;
+		}
+		float ta = (lo[axis] - p1[axis]) / d[axis];
+		float tb = (hi[axis] - p1[axis]) / d[axis];
+		t0 = std::max(t0, std::min(ta, tb));
+		t1 = std::min(t1, std::max(ta, tb));
+		if (t0 > t1)
+			return false;
+	}
+	return true;
+}
+
+}
+
+bool segment_index::open(const void* data, std::size_t size, segment_index* result, bool verify) {
+	*result = segment_index();
+	if (size < sizeof(segment_index_header) || reinterpret_cast<std::uintptr_t>(data) % 8 != 0)
+		return false;
+
+	segment_index_header header;
+	std::memcpy(&header, data, sizeof(header));
+	if (std::memcmp(header.magic, segment_index_magic, sizeof(header.magic)) != 0
+			|| header.version != segment_index_version || header.byte_order != byte_order_mark)
+		return false;
+	// Limit counts before calculating the layout, so it cannot overflow.
+	if (header.node_count > size / sizeof(segment_index_node) || header.segment_count > size / sizeof(float)
+			|| header.segment_count > 0xffffffffu || (header.node_count == 0) != (header.segment_count == 0))
+		return false;
+	auto node_count = static_cast<std::size_t>(header.node_count);
+	auto segment_count = static_cast<std::size_t>(header.segment_count);
+	layout l = make_layout(node_count, segment_count);
+	if (header.size != l.size || l.size > size)
+		return false;
+
+	const auto* bytes = static_cast<const std::uint8_t*>(data);
+	segment_index index;
+	index.nodes = reinterpret_cast<const segment_index_node*>(bytes + l.nodes);
+	index.ids = reinterpret_cast<const std::uint32_t*>(bytes + l.ids);
+	index.positions = reinterpret_cast<const std::uint32_t*>(bytes + l.positions);
+	index.x1s = reinterpret_cast<const float*>(bytes + l.x1s);
+	index.y1s = reinterpret_cast<const float*>(bytes + l.y1s);
+	index.x2s = reinterpret_cast<const float*>(bytes + l.x2s);
+	index.y2s = reinterpret_cast<const float*>(bytes + l.y2s);
+	index.node_count = node_count;
+	index.segment_count = segment_count;
+
+	if (verify) {
+		if (checksum(bytes + sizeof(header), l.size - sizeof(header)) != header.checksum)
+			return false;
+		// Second children always come after their parent, so valid references cannot form cycles.
+		for (std::size_t i = 0; i < node_count; ++i) {
+			const segment_index_node& n = index.nodes[i];
+			bool valid = n.count == 0
+				? n.first > i + 1 && n.first < node_count
+				: static_cast<std::uint64_t>(n.first) + n.count <= segment_count;
+			if (!valid)
+				return false;
+		}
+		for (std::size_t i = 0; i < segment_count; ++i) {
+			if (index.ids[i] >= segment_count || index.positions[i] >= segment_count)
+				return false;
+		}
+	}
+
+	*result = index;
+	return true;
+}
+
+void segment_index::query(const farea& range, std::vector<std::uint32_t>* result) const {
+	if (node_count == 0)
+		return;
+
+	detail::node_stack stack;
+	stack.push(0);
+	while (!stack.empty()) {
+		std::uint32_t i = stack.pop();
+		const segment_index_node& n = nodes[i];
+		if (n.min_x > range.bottomright.x || n.max_x < range.topleft.x || n.min_y > range.bottomright.y || n.max_y < range.topleft.y)
+			continue;
+
+		if (n.count == 0) {
+			stack.push(n.first);
+			stack.push(i + 1);
+			continue;
+		}
+		for (std::uint32_t s = n.first; s < n.first + n.count; ++s) {
+			if (std::min(x1s[s], x2s[s]) <= range.bottomright.x && std::max(x1s[s], x2s[s]) >= range.topleft.x
+					&& std::min(y1s[s], y2s[s]) <= range.bottomright.y && std::max(y1s[s], y2s[s]) >= range.topleft.y)
+				result->push_back(ids[s]);
+		}
+	}
+}
+
+void segment_index::intersect(fvec2 a1, fvec2 a2, std::vector<segment_hit>* result) const {
+	if (node_count == 0)
+		return;
+
+	fvec2 d = a2 - a1;
+	std::uint32_t hits[hit_block_size];
+	float ts[hit_block_size];
+	detail::node_stack stack;
+	stack.push(0);
+	while (!stack.empty()) {
+		std::uint32_t i = stack.pop();
+		const segment_index_node& n = nodes[i];
+		if (!segment_overlaps(a1, d, n))
+			continue;
+
+		if (n.count == 0) {
+			stack.push(n.first);
+			stack.push(i + 1);
+			continue;
+		}
+		for (std::size_t first = n.first; first < n.first + n.count; first += hit_block_size) {
+			std::size_t block = std::min(hit_block_size, n.first + n.count - first);
+			std::size_t m = line_segments_intersect(a1, a2, x1s + first, y1s + first, x2s + first, y2s + first, block, hits, ts);
+			for (std::size_t k = 0; k < m; ++k)
+				result->push_back({ids[first + hits[k]], ts[k]});
+		}
+	}
+}
+
+namespace {
+
+float distance2_to_node(fvec2 x, const segment_index_node& n) {
+	float dx = std::max(std::max(n.min_x - x.x, x.x - n.max_x), 0.0f);
+	float dy = std::max(std::max(n.min_y - x.y, x.y - n.max_y), 0.0f);
+	return dx * dx + dy * dy;
+}
+
+}
+
+bool segment_index::closest(fvec2 x, segment_point* result, float max_distance) const {
+	if (node_count == 0)
+		return false;
+
+	segment_point best = {std::numeric_limits<std::uint32_t>::max(), 0.0f, fvec2(0.0f), max_distance * max_distance};
+	std::uint32_t best_position = 0;
+	detail::node_stack stack;
+	stack.push(0);
+	while (!stack.empty()) {
+		std::uint32_t i = stack.pop();
+		const segment_index_node& n = nodes[i];
+		// Equally close nodes are still visited, to find the smallest index among equally close line segments.
+		if (distance2_to_node(x, n) > best.distance2)
+			continue;
+
+		if (n.count == 0) {
+			// The closer child is pushed last, so it is visited first.
+			if (distance2_to_node(x, nodes[i + 1]) <= distance2_to_node(x, nodes[n.first])) {
+				stack.push(n.first);
+				stack.push(i + 1);
+			} else {
+				stack.push(i + 1);
+				stack.push(n.first);
+			}
+			continue;
+		}
+		std::uint32_t k;
+		float t;
+		float d2;
+		closest_line_segment(x, x1s + n.first, y1s + n.first, x2s + n.first, y2s + n.first, n.count, &k, &t, &d2);
+		std::uint32_t s = n.first + k;
+		if (d2 < best.distance2 || (d2 == best.distance2 && ids[s] < best.id)) {
+			best.id = ids[s];
+			best.t = t;
+			best.distance2 = d2;
+			best_position = s;
+		}
+	}
+
+	if (best.id == std::numeric_limits<std::uint32_t>::max())
+		return false;
+	fvec2 p1(x1s[best_position], y1s[best_position]);
+	fvec2 p2(x2s[best_position], y2s[best_position]);
+	best.point = fvec2(p1.x + (p2.x - p1.x) * best.t, p1.y + (p2.y - p1.y) * best.t);
+	*result = best;
+	return true;
+}
+
+void segment_index::closest(const fvec2* xs, std::size_t count, segment_point* result, float max_distance) const {
+	for (std::size_t i = 0; i < count; ++i) {
+		if (!closest(xs[i], result + i, max_distance))
+			result[i] = {std::numeric_limits<std::uint32_t>::max(), 0.0f, fvec2(0.0f), std::numeric_limits<float>::infinity()};
+	}
+}
+
+fsegment segment_index::get_segment(std::uint32_t id) const {
+	std::uint32_t s = positions[id];
+	return {fvec2(x1s[s], y1s[s]), fvec2(x2s[s], y2s[s])};
+}
+
+void glm_plus::build_segment_index(const fsegment* segments, std::size_t count, std::vector<std::uint8_t>* result, std::size_t leaf_size,
+		arena* scratch) {
+	leaf_size = std::max<std::size_t>(leaf_size, 1);
+	arena_scope scope(scratch);
+	arena_vector<build_item> items(count, build_item(), arena_allocator<build_item>(scratch));
+	for (std::size_t i = 0; i < count; ++i)
+		items[i] = {(segments[i].p1 + segments[i].p2) * 0.5f, static_cast<std::uint32_t>(i)};
+	arena_allocator<segment_index_node> node_alloc(scratch);
+	arena_vector<segment_index_node> nodes(node_alloc);
+	if (count > 0) {
+		// Each leaf holds at least half of leaf_size segments, and there is one inner node less than leaves.
+		nodes.reserve(2 * (count / std::max<std::size_t>(1, leaf_size / 2) + 1));
+		build_node(segments, items.data(), 0, count, leaf_size, nodes);
+	}
+
+	layout l = make_layout(nodes.size(), count);
+	result->assign(l.size, 0);
+	std::uint8_t* bytes = result->data();
+	if (!nodes.empty())
+		std::memcpy(bytes + l.nodes, nodes.data(), nodes.size() * sizeof(segment_index_node));
+	for (std::size_t s = 0; s < count; ++s) {
+		const fsegment& segment = segments[items[s].id];
+		auto position = static_cast<std::uint32_t>(s);
+		std::memcpy(bytes + l.ids + s * sizeof(std::uint32_t), &items[s].id, sizeof(std::uint32_t));
+		std::memcpy(bytes + l.positions + items[s].id * sizeof(std::uint32_t), &position, sizeof(std::uint32_t));
+		std::memcpy(bytes + l.x1s + s * sizeof(float), &segment.p1.x, sizeof(float));
+		std::memcpy(bytes + l.y1s + s * sizeof(float), &segment.p1.y, sizeof(float));
+		std::memcpy(bytes + l.x2s + s * sizeof(float), &segment.p2.x, sizeof(float));
+		std::memcpy(bytes + l.y2s + s * sizeof(float), &segment.p2.y, sizeof(float));
+	}
+
+	segment_index_header header = {};
+	std::memcpy(header.magic, segment_index_magic, sizeof(header.magic));
+	header.version = segment_index_version;
+	header.byte_order = byte_order_mark;
+	header.segment_count = count;
+	header.node_count = nodes.size();
+	header.size = l.size;
+	header.checksum = checksum(bytes + sizeof(header), l.size - sizeof(header));
+	std::memcpy(bytes, &header, sizeof(header));
+}
+
+bool glm_plus::save_segment_index(const std::string& path, const fsegment* segments, std::size_t count, std::size_t leaf_size) {
+	std::vector<std::uint8_t> data;
+	build_segment_index(segments, count, &data, leaf_size);
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+	file.close();
+	return !file.fail();
+}
+
+mapped_segment_index::mapped_segment_index(mapped_segment_index&& other) noexcept :
+		data(std::exchange(other.data, nullptr)),
+		size(std::exchange(other.size, 0)),
+		index(std::exchange(other.index, segment_index())) {}
+
+mapped_segment_index& mapped_segment_index::operator=(mapped_segment_index&& other) noexcept {
+	if (this != &other) {
+		close();
+		data = std::exchange(other.data, nullptr);
+		size = std::exchange(other.size, 0);
+		index = std::exchange(other.index, segment_index());
+	}
+	return *this;
+}
+
+bool mapped_segment_index::open(const std::string& path, bool verify) {
+	close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER file_size;
+	HANDLE mapping = nullptr;
+	if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0)
+		mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!mapping)
+		return false;
+	data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (!data)
+		return false;
+	size = static_cast<std::size_t>(file_size.QuadPart);
+#else
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+		::close(fd);
+		return false;
+	}
+	void* p = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (p == MAP_FAILED)
+		return false;
+	data = p;
+	size = static_cast<std::size_t>(st.st_size);
+#endif
+
+	if (!segment_index::open(data, size, &index, verify)) {
+		close();
+		return false;
+	}
+	return true;
+}
+
+void mapped_segment_index::close() {
+	if (data) {
+#ifdef _WIN32
+		UnmapViewOfFile(data);
+#else
+		munmap(data, size);
+#endif
+	}
+	data = nullptr;
+	size = 0;
+	index = segment_index();
+}
@@ -0,0 +1,230 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+/**
+ * @file segment_index.h
+ * This header contains a static bounding volume hierarchy over line segments, stored in a flat, pointer-free format.
+ * The same bytes are used in memory and in files, so an index can be built once, saved,
+ * and then memory mapped and queried in place by any number of processes, without parsing or copying.
+ *
+ * File layout, all values in native byte order:
+ * - a 64 byte @ref segment_index_header,
+ * - nodes, see @ref segment_index_node,
+ * - original segment indices, as @c uint32_t, in the order of leaves,
+ * - positions of segments in leaf order, as @c uint32_t, indexed by original segment index,
+ * - first point x, first point y, second point x and second point y coordinates of segments, as separate @c float arrays.
+ *
+ * Each section starts at a multiple of 64 bytes.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "arena.h"
+#include "glm/gtc/type_precision.hpp"
+#include "types.h"
+
+namespace glm_plus {
+
+/**
+ * Header of a serialized segment index.
+ */
+struct segment_index_header {
+	/** Always @ref segment_index_magic. */
+	char magic[8];
+	/** Format version, @ref segment_index_version for files written by this version of the library. */
+	std::uint32_t version;
+	/** Always 0x01020304, written in native byte order, to detect files from machines with different byte order. */
+	std::uint32_t byte_order;
+	std::uint64_t segment_count;
+	std::uint64_t node_count;
+	/** Total size, including the header. */
+	std::uint64_t size;
+	/** Checksum of everything following the header. */
+	std::uint64_t checksum;
+	std::uint64_t reserved[2];
+};
+
+/**
+ * Node of a serialized segment index.
+ * Children of an inner node are the next node and node @ref first.
+ */
+struct segment_index_node {
+	float min_x;
+	float min_y;
+	float max_x;
+	float max_y;
+	/** First segment of a leaf, or index of the second child of an inner node. */
+	std::uint32_t first;
+	/** Number of segments of a leaf, 0 for inner nodes. */
+	std::uint32_t count;
+};
+
+constexpr char segment_index_magic[8] = {'G', 'L', 'M', 'P', 'S', 'I', 'D', 'X'};
+constexpr std::uint32_t segment_index_version = 1;
+
+/**
+ * Line segment hit by a ray.
+ */
+struct segment_hit {
+	/** Index of the line segment in the array the index was built from. */
+	std::uint32_t id;
+	/** Intersection parameter along the ray. */
+	float t;
+};
+
+/**
+ * Point on a line segment, closest to a query point.
+ */
+struct segment_point {
+	/** Index of the line segment. */
+	std::uint32_t id;
+	/** Parameter of the point along the line segment, from 0 at its first point to 1 at its second point. */
+	float t;
+	/** Closest point. */
+	glm::fvec2 point;
+	/** Squared distance from the query point. */
+	float distance2;
+};
+
+/**
+ * Read-only view of a serialized segment index. Does not own its data.
+ */
+class segment_index {
+public:
+	segment_index() = default;
+
+	/**
+	 * Opens serialized index data in place.
+	 * The header and section sizes are always checked. With @p verify, the checksum and all node references are checked too,
+	 * which reads the whole index. Skip it only for trusted data, which was already verified, like a file written by the same process.
+	 * @param data Index data, aligned to at least 8 bytes. Must stay valid while the index is used.
+	 * @param size Size of the data in bytes.
+	 * @param result Opened index.
+	 * @param verify Verify the checksum and node references.
+	 * @return @c True if the data is a valid index, @c false otherwise.
+	 */
+	static bool open(const void* data, std::size_t size, segment_index* result, bool verify = true);
+
+	/**
+	 * Finds line segments whose bounds overlap an area. Line segments touching the area edge are included.
+	 * @param range Area to search.
+	 * @param result Indices of found line segments are appended to this vector.
+	 */
+	void query(const farea& range, std::vector<std::uint32_t>* result) const;
+
+	/**
+	 * Finds line segments intersected by a line segment.
+	 * Leaves are tested with the batched @ref line_segments_intersect, so hits are the same as with a linear search,
+	 * as long as floating-point contraction stays off, see @ref line_batch.h.
+	 * @param a1 First point of the line segment.
+	 * @param a2 Second point of the line segment.
+	 * @param result Hits are appended to this vector, in no particular order.
+	 */
+	void intersect(glm::fvec2 a1, glm::fvec2 a2, std::vector<segment_hit>* result) const;
+
+	/**
+	 * Finds the line segment closest to a point.
+	 * Nodes are visited closest first, and leaves are tested with the batched @ref closest_line_segment,
+	 * so results are the same as with a linear search, as long as floating-point contraction stays off, see @ref line_batch.h.
+	 * If several line segments are equally close, the one with the smallest index is found.
+	 * @param x Point to test.
+	 * @param result Found point. Left unchanged if no line segment is found.
+	 * @param max_distance Only line segments within this distance are found.
+	 * @return @c True if a line segment was found, @c false otherwise.
+	 */
+	bool closest(glm::fvec2 x, segment_point* result, float max_distance = std::numeric_limits<float>::infinity()) const;
+
+	/**
+	 * Finds the line segment closest to each of many points.
+	 * @param xs Points to test.
+	 * @param count Number of points.
+	 * @param result Found point for each point. Points without a line segment within @p max_distance have id @c UINT32_MAX.
+	 * @param max_distance Only line segments within this distance are found.
+	 */
+	void closest(const glm::fvec2* xs, std::size_t count, segment_point* result, float max_distance = std::numeric_limits<float>::infinity()) const;
+
+	[[nodiscard]] std::size_t size() const { return segment_count; }
+
+	/**
+	 * Returns a line segment.
+	 * @param id Index of the line segment in the array the index was built from.
+	 */
+	[[nodiscard]] fsegment get_segment(std::uint32_t id) const;
+
+private:
+	const segment_index_node* nodes = nullptr;
+	const std::uint32_t* ids = nullptr;
+	const std::uint32_t* positions = nullptr;
+	const float* x1s = nullptr;
+	const float* y1s = nullptr;
+	const float* x2s = nullptr;
+	const float* y2s = nullptr;
+	std::size_t node_count = 0;
+	std::size_t segment_count = 0;
+};
+
+/**
+ * Builds a segment index and serializes it.
+ * Nodes are split at the median of segment centers, along the longer axis, until leaves contain at most @p leaf_size segments.
+ * Zero-length segments are included, but are never hit by @ref segment_index::intersect.
+ * @param segments Line segments.
+ * @param count Number of line segments.
+ * @param result Serialized index. Previous contents are replaced.
+ * @param leaf_size Maximum number of line segments in a leaf.
+ * @param scratch Arena for temporary buffers while building, about 40 bytes per line segment. Heap is used if @c nullptr.
+ */
+void build_segment_index(const fsegment* segments, std::size_t count, std::vector<std::uint8_t>* result, std::size_t leaf_size = 16,
+	arena* scratch = nullptr);
+
+/**
+ * Builds a segment index and writes it to a file.
+ * @param path File path.
+ * @param segments Line segments.
+ * @param count Number of line segments.
+ * @param leaf_size Maximum number of line segments in a leaf.
+ * @return @c True if the file was written, @c false otherwise.
+ */
+bool save_segment_index(const std::string& path, const fsegment* segments, std::size_t count, std::size_t leaf_size = 16);
+
+/**
+ * Segment index in a read-only memory mapped file.
+ * Pages are loaded on demand and shared between all processes that map the same file.
+ */
+class mapped_segment_index {
+public:
+	mapped_segment_index() = default;
+	mapped_segment_index(const mapped_segment_index&) = delete;
+	mapped_segment_index& operator=(const mapped_segment_index&) = delete;
+	mapped_segment_index(mapped_segment_index&& other) noexcept;
+	mapped_segment_index& operator=(mapped_segment_index&& other) noexcept;
+	~mapped_segment_index() { close(); }
+
+	/**
+	 * Maps a file and opens the index in it. A previously opened file is closed.
+	 * @param path File path.
+	 * @param verify Verify the checksum and node references, see @ref segment_index::open.
+	 * @return @c True if the file was mapped and contains a valid index, @c false otherwise.
+	 */
+	bool open(const std::string& path, bool verify = true);
+
+	/**
+	 * Unmaps the file. The index becomes empty.
+	 */
+	void close();
+
+	[[nodiscard]] const segment_index& get_index() const { return index; }
+
+private:
+	void* data = nullptr;
+	std::size_t size = 0;
+	segment_index index;
+};
+
+}
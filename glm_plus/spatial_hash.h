@@ -0,0 +1,329 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+/**
+ * @file spatial_hash.h
+ * This header contains a uniform grid spatial hash for indexing points and boxes.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "glm/glm.hpp"
+#include "types.h"
+
+namespace glm_plus {
+
+/**
+ * Uniform grid spatial hash, which stores objects identified by ids, along with their bounds.
+ * The plane is divided into square cells of equal size, which are hashed into a fixed number of buckets.
+ * Each object is referenced from every cell its bounds touch.
+ * All storage is kept in flat arrays, which are reused after objects are removed,
+ * so inserting, moving and removing objects does not allocate memory once the hash has grown to its working size.
+ * Moving an object within the same cells only updates its bounds.
+ * Ids are used as array indices, so they should be small and dense, like entity indices.
+ * @tparam T Coordinate type.
+ */
+template<typename T>
+class spatial_hash {
+public:
+	/**
+	 * @param cell_size Width and height of a grid cell. Should be about the size of a typical object.
+	 * @param bucket_count Number of hash buckets. Rounded up to a power of two.
+	 */
+	explicit spatial_hash(T cell_size, std::size_t bucket_count = 4096);
+
+	/**
+	 * Inserts an object. If an object with the same id exists, it is moved instead.
+	 * @param id Object id.
+	 * @param bounds Object bounds.
+	 */
+	void insert(std::uint32_t id, const box<T>& bounds) { move(id, bounds.topleft, bounds.bottomright); }
+
+	/**
+	 * Inserts a point object. If an object with the same id exists, it is moved instead.
+	 * @param id Object id.
+	 * @param position Object position.
+	 */
+	void insert(std::uint32_t id, pos<T> position) { move(id, position, position); }
+
+	/**
+	 * Moves an object. If no object with the id exists, it is inserted.
+	 * @param id Object id.
+	 * @param bounds New object bounds.
+	 */
+	void move(std::uint32_t id, const box<T>& bounds) { move(id, bounds.topleft, bounds.bottomright); }
+
+	/**
+	 * Moves a point object. If no object with the id exists, it is inserted.
+	 * @param id Object id.
+	 * @param position New object position.
+	 */
+	void move(std::uint32_t id, pos<T> position) { move(id, position, position); }
+
+	/**
+	 * Removes an object. Does nothing if no object with the id exists.
+	 * @param id Object id.
+	 */
+	void remove(std::uint32_t id);
+
+	/**
+	 * Removes all objects. Keeps allocated memory.
+	 */
+	void clear();
+
+	/**
+	 * Check if an object with the id exists.
+	 * @param id Object id.
+	 * @return @c True if the object exists, @c false otherwise.
+	 */
+	[[nodiscard]] bool contains(std::uint32_t id) const { return id < objects.size() && objects[id].first_entry != none; }
+
+	/**
+	 * Returns object bounds.
+	 * @param id Id of an existing object.
+	 * @return Object bounds.
+	 */
+	[[nodiscard]] area<T> get_bounds(std::uint32_t id) const { return objects[id].bounds; }
+
+	/**
+	 * Finds objects which overlap an area. Objects touching the area edge are included.
+	 * Each object is reported once.
+	 * @param range Area to search.
+	 * @param result Ids of found objects are appended to this vector.
+	 */
+	void query(const area<T>& range, std::vector<std::uint32_t>* result) const;
+
+	/**
+	 * Finds objects which overlap a circle. Objects touching the circle are included.
+	 * Each object is reported once.
+	 * @param center Circle center.
+	 * @param radius Circle radius.
+	 * @param result Ids of found objects are appended to this vector.
+	 */
+	void query(glm::vec<2, T> center, T radius, std::vector<std::uint32_t>* result) const;
+
+private:
+	static constexpr std::uint32_t none = 0xffffffffu;
+
+	struct cell_range {
+		std::int32_t x0;
+		std::int32_t y0;
+		std::int32_t x1;
+		std::int32_t y1;
+	};
+
+	struct object {
+		area<T> bounds;
+		cell_range cells;
+		std::uint32_t first_entry;
+	};
+
+	/** Reference to an object from a cell. Linked into a bucket list and into the list of the object's entries. */
+	struct entry {
+		std::int32_t cell_x;
+		std::int32_t cell_y;
+		std::uint32_t id;
+		std::uint32_t bucket_prev;
+		std::uint32_t bucket_next;
+		std::uint32_t object_next;
+	};
+
+	void move(std::uint32_t id, glm::vec<2, T> topleft, glm::vec<2, T> bottomright);
+	void link(std::uint32_t id, const cell_range& cells);
+	void unlink(std::uint32_t id);
+	[[nodiscard]] std::int32_t cell_of(T x) const;
+	[[nodiscard]] cell_range cells_of(glm::vec<2, T> topleft, glm::vec<2, T> bottomright) const;
+	[[nodiscard]] std::size_t bucket_of(std::int32_t x, std::int32_t y) const;
+	template<typename F>
+	void visit(const cell_range& range, F&& test, std::vector<std::uint32_t>* result) const;
+
+	double inv_cell_size;
+	std::size_t bucket_mask;
+	std::vector<std::uint32_t> buckets;
+	std::vector<entry> entries;
+	std::uint32_t free_entry = none;
+	std::vector<object> objects;
+};
+
+typedef spatial_hash<float> fspatial_hash;
+typedef spatial_hash<int> ispatial_hash;
+
+template<typename T>
+constexpr std::uint32_t spatial_hash<T>::none;
+
+template<typename T>
+spatial_hash<T>::spatial_hash(T cell_size, std::size_t bucket_count) :
+		inv_cell_size(1.0 / static_cast<double>(cell_size)) {
+	std::size_t n = 1;
+	while (n < bucket_count)
+		n *= 2;
+	bucket_mask = n - 1;
+	buckets.assign(n, none);
+}
+
+template<typename T>
+void spatial_hash<T>::remove(std::uint32_t id) {
+	if (!contains(id))
+		return;
+	unlink(id);
+}
+
+template<typename T>
+void spatial_hash<T>::clear() {
+	std::fill(buckets.begin(), buckets.end(), none);
+	entries.clear();
+	free_entry = none;
+	objects.clear();
+}
+
+template<typename T>
+void spatial_hash<T>::query(const area<T>& range, std::vector<std::uint32_t>* result) const {
+	visit(cells_of(range.topleft, range.bottomright), [&range](const area<T>& b) {
+		return b.topleft.x <= range.bottomright.x && b.bottomright.x >= range.topleft.x
+			&& b.topleft.y <= range.bottomright.y && b.bottomright.y >= range.topleft.y;
+	}, result);
+}
+
+template<typename T>
+void spatial_hash<T>::query(glm::vec<2, T> center, T radius, std::vector<std::uint32_t>* result) const {
+	glm::vec<2, T> r(radius);
+	visit(cells_of(center - r, center + r), [center, radius](const area<T>& b) {
+		// Distance from the circle center to the closest point of the bounds.
+		T dx = std::max(std::max(b.topleft.x - center.x, center.x - b.bottomright.x), T(0));
+		T dy = std::max(std::max(b.topleft.y - center.y, center.y - b.bottomright.y), T(0));
+		return dx * dx + dy * dy <= radius * radius;
+	}, result);
+}
+
+template<typename T>
+void spatial_hash<T>::move(std::uint32_t id, glm::vec<2, T> topleft, glm::vec<2, T> bottomright) {
+	cell_range cells = cells_of(topleft, bottomright);
+	if (id >= objects.size())
+		objects.resize(static_cast<std::size_t>(id) + 1, object{area<T>(), cell_range{0, 0, -1, -1}, none});
+
+	object& o = objects[id];
+	bool same_cells = o.first_entry != none
+		&& o.cells.x0 == cells.x0 && o.cells.y0 == cells.y0 && o.cells.x1 == cells.x1 && o.cells.y1 == cells.y1;
+	o.bounds = area<T>(pos<T>(topleft), pos<T>(bottomright));
+	if (same_cells)
+		return;
+
+	if (o.first_entry != none)
+		unlink(id);
+	link(id, cells);
+}
+
+template<typename T>
+void spatial_hash<T>::link(std::uint32_t id, const cell_range& cells) {
+	objects[id].cells = cells;
+	objects[id].first_entry = none;
+	std::uint32_t last = none;
+	for (std::int32_t y = cells.y0; y <= cells.y1; ++y) {
+		for (std::int32_t x = cells.x0; x <= cells.x1; ++x) {
+			std::uint32_t e;
+			if (free_entry != none) {
+				e = free_entry;
+				free_entry = entries[e].object_next;
+			}
+			else {
+				e = static_cast<std::uint32_t>(entries.size());
+				entries.emplace_back();
+			}
+
+			std::uint32_t& head = buckets[bucket_of(x, y)];
+			entries[e] = entry{x, y, id, none, head, none};
+			if (head != none)
+				entries[head].bucket_prev = e;
+			head = e;
+
+			if (last == none)
+				objects[id].first_entry = e;
+			else
+				entries[last].object_next = e;
+			last = e;
+		}
+	}
+}
+
+template<typename T>
+void spatial_hash<T>::unlink(std::uint32_t id) {
+	std::uint32_t e = objects[id].first_entry;
+	while (e != none) {
+		entry& en = entries[e];
+		if (en.bucket_prev != none)
+			entries[en.bucket_prev].bucket_next = en.bucket_next;
+		else
+			buckets[bucket_of(en.cell_x, en.cell_y)] = en.bucket_next;
+		if (en.bucket_next != none)
+			entries[en.bucket_next].bucket_prev = en.bucket_prev;
+
+		std::uint32_t next = en.object_next;
+		en.object_next = free_entry;
+		free_entry = e;
+		e = next;
+	}
+	objects[id].first_entry = none;
+}
+
+template<typename T>
+std::int32_t spatial_hash<T>::cell_of(T x) const {
+	return static_cast<std::int32_t>(std::floor(static_cast<double>(x) * inv_cell_size));
+}
+
+template<typename T>
+typename spatial_hash<T>::cell_range spatial_hash<T>::cells_of(glm::vec<2, T> topleft, glm::vec<2, T> bottomright) const {
+	return {cell_of(topleft.x), cell_of(topleft.y), cell_of(bottomright.x), cell_of(bottomright.y)};
+}
+
+template<typename T>
+std::size_t spatial_hash<T>::bucket_of(std::int32_t x, std::int32_t y) const {
+	auto h = static_cast<std::uint32_t>(x) * 0x8da6b343u ^ static_cast<std::uint32_t>(y) * 0xd8163841u;
+	return (h ^ (h >> 16)) & bucket_mask;
+}
+
+template<typename T>
+template<typename F>
+void spatial_hash<T>::visit(const cell_range& range, F&& test, std::vector<std::uint32_t>* result) const {
+	// An object is reported only from the first of its cells that lies in the searched range,
+	// so objects spanning several cells are not reported twice.
+	auto report = [&](const entry& en) {
+		const object& o = objects[en.id];
+		if (en.cell_x == std::max(o.cells.x0, range.x0) && en.cell_y == std::max(o.cells.y0, range.y0) && test(o.bounds))
+			result->push_back(en.id);
+	};
+
+	auto in_range = [&range](const entry& en) {
+		return en.cell_x >= range.x0 && en.cell_x <= range.x1 && en.cell_y >= range.y0 && en.cell_y <= range.y1;
+	};
+
+	double cell_count = (static_cast<double>(range.x1) - range.x0 + 1.0) * (static_cast<double>(range.y1) - range.y0 + 1.0);
+	if (cell_count > static_cast<double>(buckets.size())) {
+		// Range covers more cells than there are buckets, so it is cheaper to visit every bucket once.
+		for (std::uint32_t head : buckets) {
+			for (std::uint32_t e = head; e != none; e = entries[e].bucket_next) {
+				if (in_range(entries[e]))
+					report(entries[e]);
+			}
+		}
+		return;
+	}
+
+	for (std::int32_t y = range.y0; y <= range.y1; ++y) {
+		for (std::int32_t x = range.x0; x <= range.x1; ++x) {
+			for (std::uint32_t e = buckets[bucket_of(x, y)]; e != none; e = entries[e].bucket_next) {
+				const entry& en = entries[e];
+				if (en.cell_x == x && en.cell_y == y)
+					report(en);
+			}
+		}
+	}
+}
+
+}
\ No newline at end of file
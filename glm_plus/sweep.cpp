@@ -0,0 +1,407 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "sweep.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <set>
+#include <unordered_set>
+
+#include "line.h"
+
+using namespace glm_plus;
+using namespace glm;
+
+namespace {
+
+// Sweep runs in positive x direction. Points on the same vertical line are ordered by y.
+struct point_less {
+	bool operator()(dvec2 a, dvec2 b) const {
+		return a.x < b.x || (a.x == b.x && a.y < b.y);
+	}
+};
+
+struct sweep_segment {
+	dvec2 left;
+	dvec2 right;
+	double slope;  // Infinity for vertical segments.
+	double reach;  // Distance within which the pairwise tests may report touching, see touch_reach.
+	std::uint32_t id;
+};
+
+// Pairwise tests run in float, so they report segments as touching, when one passes an end point of the other
+// within a rounding error, and as coinciding, when they are parallel within tiny_margin.
+// Such pairs do not meet in the sweep, so they are collected separately, among segments closer than this to an end point.
+double touch_reach(dvec2 left, dvec2 right) {
+	double magnitude = std::max({1.0, std::abs(left.x), std::abs(left.y), std::abs(right.x), std::abs(right.y)});
+	return std::max(4.0 * std::numeric_limits<float>::epsilon() * magnitude, static_cast<double>(tiny_margin) / distance(left, right));
+}
+
+double distance_to_segment(dvec2 p, const sweep_segment& s) {
+	dvec2 d = s.right - s.left;
+	double t = std::min(std::max(dot(p - s.left, d) / dot(d, d), 0.0), 1.0);
+	return distance(p, s.left + d * t);
+}
+
+struct sweep_event {
+	explicit sweep_event(const arena_allocator<std::uint32_t>& alloc) :
+			starting(alloc),
+			ending(alloc) {}
+
+	arena_vector<std::uint32_t> starting;
+	arena_vector<std::uint32_t> ending;
+};
+
+class bentley_ottmann {
+public:
+	bentley_ottmann(const fsegment* input, std::size_t count, std::vector<segment_intersection>* result, arena* scratch);
+	void run();
+
+private:
+	// Orders segments by their height at the current sweep position.
+	// Segments passing through the same point are ordered by their height just after it.
+	struct status_less {
+		typedef void is_transparent;
+
+		bool operator()(std::uint32_t a, std::uint32_t b) const;
+		bool operator()(std::uint32_t a, double y) const { return sweep->key(a) < y; }
+		bool operator()(double y, std::uint32_t a) const { return y < sweep->key(a); }
+
+		const bentley_ottmann* sweep;
+	};
+	typedef std::set<std::uint32_t, status_less, arena_allocator<std::uint32_t>> status_set;
+	typedef std::map<dvec2, sweep_event, point_less, arena_allocator<std::pair<const dvec2, sweep_event>>> event_map;
+	typedef std::unordered_set<std::uint64_t, std::hash<std::uint64_t>, std::equal_to<std::uint64_t>, arena_allocator<std::uint64_t>> pair_set;
+
+	[[nodiscard]] double key(std::uint32_t s) const;
+	[[nodiscard]] bool intersection(std::uint32_t a, std::uint32_t b, dvec2* result) const;
+	sweep_event& event_at(dvec2 p);
+	void handle_event(dvec2 p, const sweep_event& event);
+	void find_touching(dvec2 p, const sweep_event& event);
+	void test_touching(std::uint32_t s, dvec2 p, double reach);
+	void find_new_event(std::uint32_t a, std::uint32_t b, dvec2 p);
+	void test_pair(std::uint32_t a, std::uint32_t b);
+
+	const fsegment* input;
+	std::vector<segment_intersection>* result;
+	arena_allocator<std::uint32_t> alloc;
+	arena_vector<sweep_segment> segments;
+	arena_vector<status_set::iterator> positions;
+	arena_vector<char> through;
+	arena_vector<char> listed;
+	arena_vector<std::uint32_t> passing;
+	arena_vector<std::uint32_t> inserted;
+	arena_vector<std::uint32_t> ended;
+	arena_vector<std::uint32_t> touching;
+	event_map events;
+	status_set status;
+	pair_set tested;
+	dvec2 sweep_point;
+};
+
+bool bentley_ottmann::status_less::operator()(std::uint32_t a, std::uint32_t b) const {
+	if (a == b)
+		return false;
+	double ka = sweep->key(a);
+	double kb = sweep->key(b);
+	if (ka != kb)
+		return ka < kb;
+	double sa = sweep->segments[a].slope;
+	double sb = sweep->segments[b].slope;
+	if (sa != sb)
+		return sa < sb;
+	return a < b;
+}
+
+bentley_ottmann::bentley_ottmann(const fsegment* input, std::size_t count, std::vector<segment_intersection>* result, arena* scratch) :
+		input(input),
+		result(result),
+		alloc(scratch),
+		segments(alloc),
+		positions(alloc),
+		through(alloc),
+		listed(alloc),
+		passing(alloc),
+		inserted(alloc),
+		ended(alloc),
+		touching(alloc),
+		events(point_less(), alloc),
+		status(status_less{this}, alloc),
+		tested(0, std::hash<std::uint64_t>(), std::equal_to<std::uint64_t>(), alloc),
+		sweep_point(0.0) {
+	segments.reserve(count);
+	for (std::size_t i = 0; i < count; ++i) {
+		dvec2 p1(input[i].p1);
+		dvec2 p2(input[i].p2);
+		if (p1 == p2)
+			continue;
+
+		sweep_segment s;
+		s.left = point_less()(p1, p2) ? p1 : p2;
+		s.right = point_less()(p1, p2) ? p2 : p1;
+		s.slope = s.left.x == s.right.x
+			? std::numeric_limits<double>::infinity()
+			: (s.right.y - s.left.y) / (s.right.x - s.left.x);
+		s.reach = touch_reach(s.left, s.right);
+		s.id = static_cast<std::uint32_t>(i);
+
+		auto index = static_cast<std::uint32_t>(segments.size());
+		segments.push_back(s);
+		event_at(s.left).starting.push_back(index);
+		event_at(s.right).ending.push_back(index);
+	}
+
+	positions.assign(segments.size(), status.end());
+	through.assign(segments.size(), 0);
+	listed.assign(segments.size(), 0);
+}
+
+void bentley_ottmann::run() {
+	result->clear();
+	while (!events.empty()) {
+		auto it = events.begin();
+		dvec2 p = it->first;
+		sweep_event event = std::move(it->second);
+		events.erase(it);
+		handle_event(p, event);
+	}
+
+	std::sort(result->begin(), result->end(), [](const segment_intersection& a, const segment_intersection& b) {
+		return a.first < b.first || (a.first == b.first && a.second < b.second);
+	});
+}
+
+sweep_event& bentley_ottmann::event_at(dvec2 p) {
+	auto it = events.lower_bound(p);
+	if (it == events.end() || point_less()(p, it->first))
+		it = events.emplace_hint(it, p, sweep_event(alloc));
+	return it->second;
+}
+
+double bentley_ottmann::key(std::uint32_t s) const {
+	const sweep_segment& seg = segments[s];
+	if (through[s])
+		return sweep_point.y;
+	if (std::isinf(seg.slope))
+		return std::min(std::max(sweep_point.y, seg.left.y), seg.right.y);
+	if (sweep_point.x <= seg.left.x)
+		return seg.left.y;
+	if (sweep_point.x >= seg.right.x)
+		return seg.right.y;
+	return seg.left.y + (sweep_point.x - seg.left.x) * seg.slope;
+}
+
+bool bentley_ottmann::intersection(std::uint32_t a, std::uint32_t b, dvec2* result) const {
+	const sweep_segment& s1 = segments[a];
+	const sweep_segment& s2 = segments[b];
+	bool vertical1 = std::isinf(s1.slope);
+	bool vertical2 = std::isinf(s2.slope);
+	if (vertical1 && vertical2)
+		return false;
+
+	if (vertical1 || vertical2) {
+		// Calculate the intersection on the vertical segment, so it lands exactly on its sweep position.
+		const sweep_segment& v = vertical1 ? s1 : s2;
+		const sweep_segment& o = vertical1 ? s2 : s1;
+		double x = v.left.x;
+		if (x < o.left.x || x > o.right.x)
+			return false;
+		double y = o.left.y + (x - o.left.x) * o.slope;
+		if (y < v.left.y || y > v.right.y)
+			return false;
+		*result = dvec2(x, y);
+		return true;
+	}
+
+	dvec2 r = s1.right - s1.left;
+	dvec2 s = s2.right - s2.left;
+	double denom = r.x * s.y - r.y * s.x;
+	if (denom == 0.0)
+		return false;
+
+	dvec2 d = s2.left - s1.left;
+	double t = (d.x * s.y - d.y * s.x) / denom;
+	double u = (d.x * r.y - d.y * r.x) / denom;
+	if (t < 0.0 || t > 1.0 || u < 0.0 || u > 1.0)
+		return false;
+
+	dvec2 q = s1.left + r * t;
+	q.x = std::min(std::max(q.x, std::max(s1.left.x, s2.left.x)), std::min(s1.right.x, s2.right.x));
+	*result = q;
+	return true;
+}
+
+void bentley_ottmann::handle_event(dvec2 p, const sweep_event& event) {
+	sweep_point = p;
+	double tolerance = 1.0e-10 * std::max(1.0, std::max(std::abs(p.x), std::abs(p.y)));
+
+	// Find segments that end at or pass through the event point.
+	passing.clear();
+	for (auto it = status.lower_bound(p.y - tolerance); it != status.end() && key(*it) <= p.y + tolerance; ++it) {
+		passing.push_back(*it);
+		listed[*it] = 1;
+	}
+	for (std::uint32_t s : event.ending) {
+		if (positions[s] != status.end() && !listed[s])
+			passing.push_back(s);
+	}
+	for (std::uint32_t s : passing)
+		listed[s] = 0;
+
+	find_touching(p, event);
+
+	// All segments meeting in the event point are candidate pairs.
+	for (std::size_t i = 0; i < passing.size(); ++i) {
+		for (std::size_t j = i + 1; j < passing.size(); ++j)
+			test_pair(passing[i], passing[j]);
+		for (std::uint32_t s : event.starting)
+			test_pair(passing[i], s);
+	}
+	for (std::size_t i = 0; i < event.starting.size(); ++i) {
+		for (std::size_t j = i + 1; j < event.starting.size(); ++j)
+			test_pair(event.starting[i], event.starting[j]);
+	}
+
+	// Remove passing segments and reinsert those that continue, so they get reordered after the event point.
+	inserted.clear();
+	for (std::uint32_t s : passing) {
+		status.erase(positions[s]);
+		positions[s] = status.end();
+		if (point_less()(p, segments[s].right))
+			inserted.push_back(s);
+		else
+			ended.push_back(s);
+	}
+	inserted.insert(inserted.end(), event.starting.begin(), event.starting.end());
+
+	for (std::uint32_t s : inserted)
+		through[s] = 1;
+	for (std::uint32_t s : inserted)
+		positions[s] = status.insert(s).first;
+
+	if (inserted.empty()) {
+		auto upper = status.lower_bound(p.y);
+		bool has_lower = upper != status.begin();
+		if (upper != status.end() && has_lower)
+			find_new_event(*std::prev(upper), *upper, p);
+		return;
+	}
+
+	auto lowest = status.lower_bound(p.y);
+	auto highest = std::prev(status.upper_bound(p.y));
+	std::uint32_t lowest_id = *lowest;
+	std::uint32_t highest_id = *highest;
+	bool has_lower = lowest != status.begin();
+	std::uint32_t lower_id = has_lower ? *std::prev(lowest) : 0;
+	bool has_upper = std::next(highest) != status.end();
+	std::uint32_t upper_id = has_upper ? *std::next(highest) : 0;
+
+	for (std::uint32_t s : inserted)
+		through[s] = 0;
+
+	if (has_lower)
+		find_new_event(lower_id, lowest_id, p);
+	if (has_upper)
+		find_new_event(highest_id, upper_id, p);
+}
+
+void bentley_ottmann::find_touching(dvec2 p, const sweep_event& event) {
+	touching.clear();
+	touching.insert(touching.end(), event.starting.begin(), event.starting.end());
+	touching.insert(touching.end(), event.ending.begin(), event.ending.end());
+	if (touching.empty())
+		return;
+	double reach = 0.0;
+	for (std::uint32_t s : touching)
+		reach = std::max(reach, segments[s].reach);
+
+	// Segments in the status, walking away from the event point until one is out of reach.
+	auto upper = status.lower_bound(p.y);
+	for (auto it = upper; it != status.end(); ++it) {
+		double r = std::max(reach, segments[*it].reach);
+		if (key(*it) - p.y > r && distance_to_segment(p, segments[*it]) > r)
+			break;
+		test_touching(*it, p, reach);
+	}
+	for (auto it = upper; it != status.begin();) {
+		--it;
+		double r = std::max(reach, segments[*it].reach);
+		if (p.y - key(*it) > r && distance_to_segment(p, segments[*it]) > r)
+			break;
+		test_touching(*it, p, reach);
+	}
+
+	// Segments, which ended just before the event point.
+	std::size_t kept = 0;
+	for (std::uint32_t s : ended) {
+		if (p.x - segments[s].right.x > std::max(reach, segments[s].reach))
+			continue;
+		test_touching(s, p, reach);
+		if (p.x - segments[s].right.x <= segments[s].reach)
+			ended[kept++] = s;
+	}
+	ended.resize(kept);
+
+	// Segments, which start just after the event point, on the same vertical line or to the right of it.
+	for (auto it = events.begin(); it != events.end() && it->first.x == p.x && it->first.y - p.y <= reach; ++it) {
+		for (std::uint32_t s : it->second.starting)
+			test_touching(s, p, reach);
+	}
+	for (auto it = events.upper_bound(dvec2(p.x, std::numeric_limits<double>::infinity())); it != events.end() && it->first.x - p.x <= reach; ++it) {
+		for (std::uint32_t s : it->second.starting)
+			test_touching(s, p, reach);
+	}
+}
+
+void bentley_ottmann::test_touching(std::uint32_t s, dvec2 p, double reach) {
+	if (distance_to_segment(p, segments[s]) > std::max(reach, segments[s].reach))
+		return;
+	for (std::uint32_t t : touching) {
+		if (t != s)
+			test_pair(s, t);
+	}
+}
+
+void bentley_ottmann::find_new_event(std::uint32_t a, std::uint32_t b, dvec2 p) {
+	test_pair(a, b);
+
+	dvec2 q;
+	if (intersection(a, b, &q) && point_less()(p, q))
+		event_at(q);
+}
+
+void bentley_ottmann::test_pair(std::uint32_t a, std::uint32_t b) {
+	std::uint32_t first = std::min(segments[a].id, segments[b].id);
+	std::uint32_t second = std::max(segments[a].id, segments[b].id);
+	if (!tested.insert(static_cast<std::uint64_t>(first) << 32 | second).second)
+		return;
+
+	const fsegment& s1 = input[first];
+	const fsegment& s2 = input[second];
+	if (line_segments_coincide(s1.p1, s1.p2, s2.p1, s2.p2)) {
+		const sweep_segment& l1 = segments[a];
+		const sweep_segment& l2 = segments[b];
+		dvec2 start = point_less()(l1.left, l2.left) ? l2.left : l1.left;
+		result->push_back({first, second, fvec2(start), true});
+		return;
+	}
+
+	fvec2 point;
+	if (line_segments_intersect(s1.p1, s1.p2, s2.p1, s2.p2, &point))
+		result->push_back({first, second, point, false});
+}
+
+}
+
+void glm_plus::find_line_segment_intersections(const fsegment* segments, std::size_t count, std::vector<segment_intersection>* result, arena* scratch) {
+	arena_scope scope(scratch);
+	bentley_ottmann sweep(segments, count, result, scratch);
+	sweep.run();
+}
\ No newline at end of file
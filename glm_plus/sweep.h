@@ -0,0 +1,53 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+/**
+ * @file sweep.h
+ * This header contains sweep-line algorithms over sets of line segments.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "arena.h"
+#include "glm/gtc/type_precision.hpp"
+#include "types.h"
+
+namespace glm_plus {
+
+/**
+ * A pair of intersecting or coinciding line segments.
+ */
+struct segment_intersection {
+	/** Index of the first segment. Always smaller than @ref second. */
+	std::size_t first;
+	/** Index of the second segment. */
+	std::size_t second;
+	/** Intersection point. If the segments coincide, this is a point on their shared part. */
+	glm::fvec2 point;
+	/** @c True if the segments coincide, @c false if they intersect in a single point. */
+	bool coincide;
+};
+
+/**
+ * Finds all pairs of intersecting line segments.
+ * Uses the Bentley-Ottmann sweep-line algorithm, which runs in O((n + k) log n) for n segments and k intersections.
+ * Every reported pair is confirmed with the same rules as pairwise tests:
+ * segments coincide if @ref line_segments_coincide returns @c true,
+ * otherwise they intersect if @ref line_segments_intersect returns @c true.
+ * This includes segments, which touch only within rounding errors of those tests.
+ * Coinciding segments are only found if they touch, even though @ref line_segments_coincide may accept
+ * segments shorter than the square root of @ref tiny_margin, which lie apart.
+ * Zero-length segments are ignored.
+ * @param segments Line segments.
+ * @param count Number of line segments.
+ * @param result Intersecting pairs, sorted by @ref segment_intersection::first and @ref segment_intersection::second.
+ * @param scratch Arena for the sweep state. Memory of removed events is not reused until the function returns,
+ * so the arena needs space proportional to the number of segments and intersections. Heap is used if @c nullptr.
+ */
+void find_line_segment_intersections(const fsegment* segments, std::size_t count, std::vector<segment_intersection>* result, arena* scratch = nullptr);
+
+}
\ No newline at end of file
@@ -0,0 +1,641 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "triangulation.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "predicates.h"
+
+using namespace glm_plus;
+using namespace glm;
+
+namespace {
+
+// Single polygons up to this size are triangulated by ear clipping.
+constexpr std::size_t ear_clipping_limit = 64;
+
+constexpr std::uint32_t no_triangle = 0xffffffff;
+
+inline std::uint32_t next(std::uint32_t i) { return i == 2 ? 0 : i + 1; }
+inline std::uint32_t prev(std::uint32_t i) { return i == 0 ? 2 : i - 1; }
+
+// Vertices run counter-clockwise. Edge i runs from v[i] to v[next(i)], and n[i] is the triangle on its other side.
+// Bit i of constrained is set for polygon edges, which are never flipped.
+// Bit i of parity is set if a polygon edge runs along edge i an odd number of times, so crossing it switches between inside and outside.
+struct triangle {
+	std::uint32_t v[3];
+	std::uint32_t n[3];
+	std::uint8_t constrained;
+	std::uint8_t parity;
+};
+
+typedef std::pair<std::uint32_t, std::uint32_t> edge;
+
+// Index along the Hilbert curve of a point on a 65536 x 65536 grid.
+std::uint32_t hilbert_index(std::uint32_t x, std::uint32_t y) {
+	constexpr std::uint32_t n = 1u << 16;
+	std::uint32_t d = 0;
+	for (std::uint32_t s = n / 2; s > 0; s /= 2) {
+		std::uint32_t rx = (x & s) != 0;
+		std::uint32_t ry = (y & s) != 0;
+		d += s * s * ((3 * rx) ^ ry);
+		if (ry == 0) {
+			if (rx == 1) {
+				x = n - 1 - x;
+				y = n - 1 - y;
+			}
+			std::swap(x, y);
+		}
+	}
+	return d;
+}
+
+class delaunay {
+public:
+	delaunay(const polygon_list& shape, arena* scratch);
+	bool run(std::vector<std::uint32_t>* result);
+
+private:
+	[[nodiscard]] std::uint32_t index_of(std::uint32_t t, std::uint32_t v) const;
+	[[nodiscard]] std::uint32_t locate(dvec2 p, std::uint32_t t) const;
+	[[nodiscard]] bool find_edge(std::uint32_t a, std::uint32_t b, std::uint32_t* t, std::uint32_t* e) const;
+	[[nodiscard]] std::uint32_t opposite(std::uint32_t t, std::uint32_t e) const;
+	[[nodiscard]] bool crosses(std::uint32_t a, std::uint32_t b, std::uint32_t c, std::uint32_t d) const;
+	void replace_neighbor(std::uint32_t t, std::uint32_t from, std::uint32_t to);
+	void insert_vertex(std::uint32_t v);
+	void split_triangle(std::uint32_t t, std::uint32_t v);
+	void split_edge(std::uint32_t t, std::uint32_t e, std::uint32_t v);
+	void flip(std::uint32_t t, std::uint32_t e);
+	void legalize();
+	void add_constraint(std::uint32_t t, std::uint32_t e);
+	bool insert_constraint(std::uint32_t a, std::uint32_t b);
+	void collect_inside(std::vector<std::uint32_t>* result);
+
+	const polygon_list& shape;
+	arena* scratch;
+	arena_vector<dvec2> points;
+	arena_vector<triangle> triangles;
+	arena_vector<std::uint32_t> vertex_triangles;
+	arena_vector<std::uint32_t> vertex_ids;
+	arena_vector<edge> stack;
+	arena_vector<edge> crossed;
+	arena_vector<edge> created;
+	std::uint32_t last_vertex = 0;  // Walks to locate new vertices start here.
+};
+
+delaunay::delaunay(const polygon_list& shape, arena* scratch) :
+		shape(shape),
+		scratch(scratch),
+		points(arena_allocator<dvec2>(scratch)),
+		triangles(arena_allocator<triangle>(scratch)),
+		vertex_triangles(arena_allocator<std::uint32_t>(scratch)),
+		vertex_ids(arena_allocator<std::uint32_t>(scratch)),
+		stack(arena_allocator<edge>(scratch)),
+		crossed(arena_allocator<edge>(scratch)),
+		created(arena_allocator<edge>(scratch)) {}
+
+bool delaunay::run(std::vector<std::uint32_t>* result) {
+	result->clear();
+	std::size_t count = shape.vertices.size();
+	if (count == 0)
+		return true;
+
+	// All vertices are inside a large triangle, so every inserted vertex falls into an existing triangle.
+	fvec2 low = shape.vertices[0];
+	fvec2 high = shape.vertices[0];
+	for (fvec2 p : shape.vertices) {
+		low = min(low, p);
+		high = max(high, p);
+	}
+	dvec2 center = (dvec2(low) + dvec2(high)) * 0.5;
+	double extent = std::max(static_cast<double>(high.x) - low.x, static_cast<double>(high.y) - low.y);
+	if (extent == 0.0)
+		extent = 1.0;
+
+	points.reserve(count + 3);
+	for (fvec2 p : shape.vertices)
+		points.emplace_back(p);
+	points.emplace_back(center.x - 20.0 * extent, center.y - extent);
+	points.emplace_back(center.x + 20.0 * extent, center.y - extent);
+	points.emplace_back(center.x, center.y + 20.0 * extent);
+
+	auto super = static_cast<std::uint32_t>(count);
+	triangles.reserve(2 * count + 1);
+	triangles.push_back({{super, super + 1, super + 2}, {no_triangle, no_triangle, no_triangle}, 0, 0});
+	vertex_triangles.assign(count + 3, 0);
+	vertex_ids.resize(count);
+	last_vertex = super;
+
+	// Vertices are inserted in rounds of random vertices, each twice as large as the previous one,
+	// which avoids many flips with vertices in convex position (N. Amenta, S. Choi, G. Rote, Incremental constructions con BRIO, 2003).
+	// Within a round, consecutive vertices along the Hilbert curve are close, so walks to locate them are short.
+	{
+		arena_vector<std::pair<std::uint32_t, std::uint32_t>> order(count, arena_allocator<std::pair<std::uint32_t, std::uint32_t>>(scratch));
+		float scale_x = high.x > low.x ? 65535.0f / (high.x - low.x) : 0.0f;
+		float scale_y = high.y > low.y ? 65535.0f / (high.y - low.y) : 0.0f;
+		for (std::size_t i = 0; i < count; ++i) {
+			fvec2 p = shape.vertices[i];
+			auto x = static_cast<std::uint32_t>((p.x - low.x) * scale_x);
+			auto y = static_cast<std::uint32_t>((p.y - low.y) * scale_y);
+			order[i] = {hilbert_index(std::min(x, 65535u), std::min(y, 65535u)), static_cast<std::uint32_t>(i)};
+		}
+		std::uint32_t random = 0x9e3779b9;
+		for (std::size_t i = count - 1; i > 0; --i) {
+			random ^= random << 13;
+			random ^= random >> 17;
+			random ^= random << 5;
+			std::swap(order[i], order[random % (i + 1)]);
+		}
+		for (std::size_t end = count, begin; end > 0; end = begin) {
+			begin = end > 64 ? end / 2 : 0;
+			std::sort(order.begin() + static_cast<std::ptrdiff_t>(begin), order.begin() + static_cast<std::ptrdiff_t>(end));
+		}
+		for (const auto& o : order)
+			insert_vertex(o.second);
+	}
+
+	for (std::size_t r = 0; r < shape.size(); ++r) {
+		std::size_t first = shape.offsets[r];
+		std::size_t n = shape.offsets[r + 1] - first;
+		for (std::size_t i = 0; i < n; ++i) {
+			std::uint32_t a = vertex_ids[first + i];
+			std::uint32_t b = vertex_ids[first + (i + 1 == n ? 0 : i + 1)];
+			if (a != b && !insert_constraint(a, b))
+				return false;
+		}
+	}
+
+	collect_inside(result);
+	return true;
+}
+
+std::uint32_t delaunay::index_of(std::uint32_t t, std::uint32_t v) const {
+	const triangle& tri = triangles[t];
+	return tri.v[0] == v ? 0 : tri.v[1] == v ? 1 : 2;
+}
+
+std::uint32_t delaunay::opposite(std::uint32_t t, std::uint32_t e) const {
+	std::uint32_t u = triangles[t].n[e];
+	return triangles[u].v[prev(index_of(u, triangles[t].v[next(e)]))];
+}
+
+std::uint32_t delaunay::locate(dvec2 p, std::uint32_t t) const {
+	// Visibility walk, which terminates in any Delaunay triangulation.
+	while (true) {
+		const triangle& tri = triangles[t];
+		std::uint32_t e = 0;
+		while (e < 3 && orient2d(points[tri.v[e]], points[tri.v[next(e)]], p) >= 0.0)
+			++e;
+		if (e == 3)
+			return t;
+		t = tri.n[e];
+	}
+}
+
+bool delaunay::find_edge(std::uint32_t a, std::uint32_t b, std::uint32_t* t, std::uint32_t* e) const {
+	// Triangles around an input vertex form a closed fan.
+	std::uint32_t start = vertex_triangles[a];
+	std::uint32_t current = start;
+	do {
+		std::uint32_t i = index_of(current, a);
+		if (triangles[current].v[next(i)] == b) {
+			*t = current;
+			*e = i;
+			return true;
+		}
+		current = triangles[current].n[prev(i)];
+	} while (current != start);
+	return false;
+}
+
+bool delaunay::crosses(std::uint32_t a, std::uint32_t b, std::uint32_t c, std::uint32_t d) const {
+	if (c == a || c == b || d == a || d == b)
+		return false;
+	double c_side = orient2d(points[a], points[b], points[c]);
+	double d_side = orient2d(points[a], points[b], points[d]);
+	double a_side = orient2d(points[c], points[d], points[a]);
+	double b_side = orient2d(points[c], points[d], points[b]);
+	return ((c_side > 0.0 && d_side < 0.0) || (c_side < 0.0 && d_side > 0.0))
+		&& ((a_side > 0.0 && b_side < 0.0) || (a_side < 0.0 && b_side > 0.0));
+}
+
+void delaunay::replace_neighbor(std::uint32_t t, std::uint32_t from, std::uint32_t to) {
+	if (t == no_triangle)
+		return;
+	triangle& tri = triangles[t];
+	for (std::uint32_t& n : tri.n) {
+		if (n == from)
+			n = to;
+	}
+}
+
+void delaunay::insert_vertex(std::uint32_t v) {
+	dvec2 p = points[v];
+	std::uint32_t t = locate(p, vertex_triangles[last_vertex]);
+	const triangle& tri = triangles[t];
+	for (std::uint32_t k : tri.v) {
+		if (points[k] == p) {
+			vertex_ids[v] = k;
+			return;
+		}
+	}
+	vertex_ids[v] = v;
+
+	std::uint32_t on_edge = 3;
+	for (std::uint32_t e = 0; e < 3; ++e) {
+		if (orient2d(points[tri.v[e]], points[tri.v[next(e)]], p) == 0.0)
+			on_edge = e;
+	}
+	stack.clear();
+	if (on_edge == 3)
+		split_triangle(t, v);
+	else
+		split_edge(t, on_edge, v);
+	legalize();
+	last_vertex = v;
+}
+
+// Splits triangle (a, b, c) into (a, b, v), (b, c, v) and (c, a, v).
+void delaunay::split_triangle(std::uint32_t t, std::uint32_t v) {
+	triangle old = triangles[t];
+	auto t2 = static_cast<std::uint32_t>(triangles.size());
+	std::uint32_t t3 = t2 + 1;
+	std::uint32_t a = old.v[0];
+	std::uint32_t b = old.v[1];
+	std::uint32_t c = old.v[2];
+	triangles[t] = {{a, b, v}, {old.n[0], t2, t3}, static_cast<std::uint8_t>(old.constrained & 1), static_cast<std::uint8_t>(old.parity & 1)};
+	triangles.push_back({{b, c, v}, {old.n[1], t3, t}, static_cast<std::uint8_t>(old.constrained >> 1 & 1), static_cast<std::uint8_t>(old.parity >> 1 & 1)});
+	triangles.push_back({{c, a, v}, {old.n[2], t, t2}, static_cast<std::uint8_t>(old.constrained >> 2 & 1), static_cast<std::uint8_t>(old.parity >> 2 & 1)});
+	replace_neighbor(old.n[1], t, t2);
+	replace_neighbor(old.n[2], t, t3);
+	vertex_triangles[a] = t;
+	vertex_triangles[b] = t;
+	vertex_triangles[c] = t2;
+	vertex_triangles[v] = t;
+	stack.push_back({t, 0});
+	stack.push_back({t2, 0});
+	stack.push_back({t3, 0});
+}
+
+// Splits edge (a, b) of triangle (a, b, c) and of its neighbor (b, a, d) into (c, a, v), (b, c, v), (a, d, v) and (d, b, v).
+void delaunay::split_edge(std::uint32_t t, std::uint32_t e, std::uint32_t v) {
+	triangle old_t = triangles[t];
+	std::uint32_t u = old_t.n[e];
+	triangle old_u = triangles[u];
+	std::uint32_t a = old_t.v[e];
+	std::uint32_t b = old_t.v[next(e)];
+	std::uint32_t c = old_t.v[prev(e)];
+	std::uint32_t j = index_of(u, b);
+	std::uint32_t d = old_u.v[prev(j)];
+	auto t2 = static_cast<std::uint32_t>(triangles.size());
+	std::uint32_t u2 = t2 + 1;
+
+	// Both halves of a split polygon edge remain polygon edges.
+	auto flags = [](std::uint8_t bits, std::uint32_t first, std::uint32_t split, std::uint32_t second) {
+		return static_cast<std::uint8_t>((bits >> first & 1) | (bits >> split & 1) << 1 | (bits >> second & 1) << 2);
+	};
+	triangles[t] = {{c, a, v}, {old_t.n[prev(e)], u, t2}, flags(old_t.constrained, prev(e), e, 3), flags(old_t.parity, prev(e), e, 3)};
+	triangles.push_back({{b, c, v}, {old_t.n[next(e)], t, u2}, flags(old_t.constrained, next(e), 3, e), flags(old_t.parity, next(e), 3, e)});
+	triangles[u] = {{a, d, v}, {old_u.n[next(j)], u2, t}, flags(old_u.constrained, next(j), 3, j), flags(old_u.parity, next(j), 3, j)};
+	triangles.push_back({{d, b, v}, {old_u.n[prev(j)], t2, u}, flags(old_u.constrained, prev(j), j, 3), flags(old_u.parity, prev(j), j, 3)});
+	replace_neighbor(old_t.n[next(e)], t, t2);
+	replace_neighbor(old_u.n[prev(j)], u, u2);
+	vertex_triangles[a] = t;
+	vertex_triangles[b] = t2;
+	vertex_triangles[c] = t;
+	vertex_triangles[d] = u;
+	vertex_triangles[v] = t;
+	stack.push_back({t, 0});
+	stack.push_back({t2, 0});
+	stack.push_back({u, 0});
+	stack.push_back({u2, 0});
+}
+
+// Replaces triangles (a, b, c) and (b, a, d), sharing edge e of the first one, with (c, a, d) and (d, b, c).
+void delaunay::flip(std::uint32_t t, std::uint32_t e) {
+	triangle old_t = triangles[t];
+	std::uint32_t u = old_t.n[e];
+	triangle old_u = triangles[u];
+	std::uint32_t a = old_t.v[e];
+	std::uint32_t b = old_t.v[next(e)];
+	std::uint32_t c = old_t.v[prev(e)];
+	std::uint32_t j = index_of(u, b);
+	std::uint32_t d = old_u.v[prev(j)];
+
+	auto flags = [](std::uint8_t t_bits, std::uint32_t t_edge, std::uint8_t u_bits, std::uint32_t u_edge) {
+		return static_cast<std::uint8_t>((t_bits >> t_edge & 1) | (u_bits >> u_edge & 1) << 1);
+	};
+	triangles[t] = {{c, a, d}, {old_t.n[prev(e)], old_u.n[next(j)], u},
+		flags(old_t.constrained, prev(e), old_u.constrained, next(j)), flags(old_t.parity, prev(e), old_u.parity, next(j))};
+	triangles[u] = {{d, b, c}, {old_u.n[prev(j)], old_t.n[next(e)], t},
+		flags(old_u.constrained, prev(j), old_t.constrained, next(e)), flags(old_u.parity, prev(j), old_t.parity, next(e))};
+	replace_neighbor(old_u.n[next(j)], u, t);
+	replace_neighbor(old_t.n[next(e)], t, u);
+	vertex_triangles[a] = t;
+	vertex_triangles[b] = u;
+	vertex_triangles[c] = t;
+	vertex_triangles[d] = t;
+}
+
+// Restores the Delaunay property around a new vertex. Stack entries are edges opposite to it.
+void delaunay::legalize() {
+	while (!stack.empty()) {
+		std::uint32_t t = stack.back().first;
+		std::uint32_t e = stack.back().second;
+		stack.pop_back();
+		const triangle& tri = triangles[t];
+		if (tri.n[e] == no_triangle || (tri.constrained >> e & 1))
+			continue;
+		std::uint32_t d = opposite(t, e);
+		if (incircle(points[tri.v[0]], points[tri.v[1]], points[tri.v[2]], points[d]) <= 0.0)
+			continue;
+		std::uint32_t u = tri.n[e];
+		flip(t, e);
+		stack.push_back({t, 1});
+		stack.push_back({u, 0});
+	}
+}
+
+void delaunay::add_constraint(std::uint32_t t, std::uint32_t e) {
+	triangle& tri = triangles[t];
+	triangle& other = triangles[tri.n[e]];
+	std::uint32_t j = index_of(tri.n[e], tri.v[next(e)]);
+	tri.constrained |= 1 << e;
+	tri.parity ^= 1 << e;
+	other.constrained |= 1 << j;
+	other.parity ^= 1 << j;
+}
+
+bool delaunay::insert_constraint(std::uint32_t a, std::uint32_t b) {
+	while (a != b) {
+		// Most polygon edges are already edges of the Delaunay triangulation.
+		std::uint32_t t;
+		std::uint32_t e;
+		if (find_edge(a, b, &t, &e)) {
+			add_constraint(t, e);
+			return true;
+		}
+
+		// Find the triangle around a, which the constraint leaves through, or an edge running along it.
+		dvec2 pa = points[a];
+		dvec2 pb = points[b];
+		t = vertex_triangles[a];
+		e = 3;
+		while (true) {
+			std::uint32_t i = index_of(t, a);
+			std::uint32_t p = triangles[t].v[next(i)];
+			std::uint32_t q = triangles[t].v[prev(i)];
+			double p_side = orient2d(pa, pb, points[p]);
+			if (p_side == 0.0 && dot(points[p] - pa, pb - pa) > 0.0) {
+				add_constraint(t, i);
+				a = p;
+				break;
+			}
+			if (p_side < 0.0 && orient2d(pa, pb, points[q]) > 0.0) {
+				e = next(i);
+				break;
+			}
+			t = triangles[t].n[prev(i)];
+		}
+		if (e == 3)
+			continue;
+
+		// Walk along the constraint, collecting crossed edges, until reaching b or a vertex lying on it.
+		// Each crossed edge runs from its vertex right of the constraint to the one left of it.
+		crossed.clear();
+		std::uint32_t c;
+		while (true) {
+			const triangle& tri = triangles[t];
+			if (tri.constrained >> e & 1)
+				return false;
+			crossed.push_back({tri.v[e], tri.v[next(e)]});
+			std::uint32_t u = tri.n[e];
+			std::uint32_t j = index_of(u, tri.v[next(e)]);
+			std::uint32_t r = triangles[u].v[prev(j)];
+			if (r == b) {
+				c = b;
+				break;
+			}
+			double side = orient2d(pa, pb, points[r]);
+			if (side == 0.0) {
+				c = r;
+				break;
+			}
+			t = u;
+			e = side < 0.0 ? prev(j) : next(j);
+		}
+
+		// Flip crossed edges until none is left (S. W. Sloan, A fast algorithm for generating constrained Delaunay triangulations, 1993).
+		// Edges, which can not be flipped yet because their quadrilateral is not convex, are retried later.
+		created.clear();
+		std::size_t head = 0;
+		while (head < crossed.size()) {
+			edge current = crossed[head++];
+			std::uint32_t ct;
+			std::uint32_t ce;
+			if (!find_edge(current.first, current.second, &ct, &ce))
+				return false;
+			std::uint32_t x = triangles[ct].v[prev(ce)];
+			std::uint32_t y = opposite(ct, ce);
+			if (!crosses(x, y, current.first, current.second)) {
+				crossed.push_back(current);
+				continue;
+			}
+			flip(ct, ce);
+			if (crosses(a, c, x, y))
+				crossed.push_back({x, y});
+			else
+				created.push_back({x, y});
+			if (head > 1024 && head * 2 > crossed.size()) {
+				crossed.erase(crossed.begin(), crossed.begin() + static_cast<std::ptrdiff_t>(head));
+				head = 0;
+			}
+		}
+
+		std::uint32_t ct;
+		std::uint32_t ce;
+		if (!find_edge(a, c, &ct, &ce))
+			return false;
+		add_constraint(ct, ce);
+
+		// Restore the Delaunay property of the new edges.
+		bool flipped = true;
+		while (flipped) {
+			flipped = false;
+			for (edge& current : created) {
+				if (!find_edge(current.first, current.second, &ct, &ce))
+					continue;
+				const triangle& tri = triangles[ct];
+				if (tri.constrained >> ce & 1)
+					continue;
+				std::uint32_t x = tri.v[prev(ce)];
+				std::uint32_t y = opposite(ct, ce);
+				if (incircle(points[tri.v[0]], points[tri.v[1]], points[tri.v[2]], points[y]) > 0.0) {
+					flip(ct, ce);
+					current = {x, y};
+					flipped = true;
+				}
+			}
+		}
+		a = c;
+	}
+	return true;
+}
+
+void delaunay::collect_inside(std::vector<std::uint32_t>* result) {
+	// Flood fill from the outside. Crossing a polygon edge leads one level deeper, and odd levels are inside.
+	arena_vector<std::int32_t> depths(triangles.size(), -1, arena_allocator<std::int32_t>(scratch));
+	arena_allocator<std::uint32_t> alloc(scratch);
+	arena_vector<std::uint32_t> current(alloc);
+	arena_vector<std::uint32_t> deeper(alloc);
+	std::uint32_t start = vertex_triangles[shape.vertices.size()];
+	depths[start] = 0;
+	current.push_back(start);
+	for (std::int32_t depth = 0; !current.empty(); ++depth) {
+		while (!current.empty()) {
+			const triangle& tri = triangles[current.back()];
+			current.pop_back();
+			for (std::uint32_t e = 0; e < 3; ++e) {
+				std::uint32_t u = tri.n[e];
+				if (u == no_triangle || depths[u] >= 0)
+					continue;
+				if (tri.parity >> e & 1) {
+					deeper.push_back(u);
+				}
+				else {
+					depths[u] = depth;
+					current.push_back(u);
+				}
+			}
+		}
+		for (std::uint32_t u : deeper) {
+			if (depths[u] < 0) {
+				depths[u] = depth + 1;
+				current.push_back(u);
+			}
+		}
+		deeper.clear();
+	}
+
+	for (std::size_t t = 0; t < triangles.size(); ++t) {
+		if (depths[t] % 2 == 1)
+			result->insert(result->end(), triangles[t].v, triangles[t].v + 3);
+	}
+}
+
+// Check if no other vertex of the remaining polygon is inside or on the triangle (a, b, c), running counter-clockwise.
+bool is_ear(const fvec2* vertices, const arena_vector<std::uint32_t>& nexts, std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+	fvec2 pa = vertices[a];
+	fvec2 pb = vertices[b];
+	fvec2 pc = vertices[c];
+	for (std::uint32_t i = nexts[c]; i != a; i = nexts[i]) {
+		fvec2 p = vertices[i];
+		if (p == pa || p == pb || p == pc)
+			continue;
+		if (orient2d(pa, pb, p) >= 0.0 && orient2d(pb, pc, p) >= 0.0 && orient2d(pc, pa, p) >= 0.0)
+			return false;
+	}
+	return true;
+}
+
+}
+
+bool glm_plus::triangulate(const polygon_list& shape, std::vector<std::uint32_t>* result, arena* scratch) {
+	if (shape.size() == 1 && shape.vertices.size() <= ear_clipping_limit
+			&& triangulate_ear_clipping(shape.vertices.data(), shape.vertices.size(), result, scratch))
+		return true;
+	return triangulate_delaunay(shape, result, scratch);
+}
+
+bool glm_plus::triangulate_delaunay(const polygon_list& shape, std::vector<std::uint32_t>* result, arena* scratch) {
+	arena_scope scope(scratch);
+	delaunay triangulation(shape, scratch);
+	if (triangulation.run(result))
+		return true;
+	result->clear();
+	return false;
+}
+
+bool glm_plus::triangulate_ear_clipping(const fvec2* vertices, std::size_t count, std::vector<std::uint32_t>* result, arena* scratch) {
+	result->clear();
+	if (count < 3)
+		return true;
+
+	// Link vertices counter-clockwise.
+	double area = 0.0;
+	for (std::size_t i = 0, j = count - 1; i < count; j = i++)
+		area += (static_cast<double>(vertices[j].x) - vertices[i].x) * (static_cast<double>(vertices[j].y) + vertices[i].y);
+	arena_scope scope(scratch);
+	arena_vector<std::uint32_t> nexts(count, 0, arena_allocator<std::uint32_t>(scratch));
+	arena_vector<std::uint32_t> prevs(count, 0, arena_allocator<std::uint32_t>(scratch));
+	for (std::uint32_t i = 0; i < count; ++i) {
+		std::uint32_t forward = i + 1 == count ? 0 : i + 1;
+		std::uint32_t backward = i == 0 ? static_cast<std::uint32_t>(count - 1) : i - 1;
+		nexts[i] = area >= 0.0 ? forward : backward;
+		prevs[i] = area >= 0.0 ? backward : forward;
+	}
+
+	// Remove duplicate vertices and spikes first, since other vertices at the same position are not tested by ears.
+	auto unlink = [&nexts, &prevs](std::uint32_t v) {
+		nexts[prevs[v]] = nexts[v];
+		prevs[nexts[v]] = prevs[v];
+	};
+	auto has_area = [vertices](std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+		return orient2d(vertices[a], vertices[b], vertices[c]) != 0.0 || dot(vertices[b] - vertices[a], vertices[c] - vertices[b]) > 0.0f;
+	};
+	std::size_t remaining = count;
+	std::uint32_t b = 0;
+	for (std::size_t checked = 0; checked < remaining && remaining >= 3;) {
+		if (has_area(prevs[b], b, nexts[b])) {
+			b = nexts[b];
+			++checked;
+		}
+		else {
+			unlink(b);
+			--remaining;
+			b = prevs[b];
+			checked = 0;
+		}
+	}
+	if (remaining < 3)
+		return true;
+
+	result->reserve(3 * (remaining - 2));
+	std::size_t stall = 0;
+	while (remaining > 3) {
+		std::uint32_t a = prevs[b];
+		std::uint32_t c = nexts[b];
+		// Vertices lying on a straight part of the boundary are only removed when nothing else can be clipped,
+		// since removing them leaves a T-junction.
+		double side = orient2d(vertices[a], vertices[b], vertices[c]);
+		bool clip = side == 0.0 && (stall >= remaining || !has_area(a, b, c));
+		if (side > 0.0 && is_ear(vertices, nexts, a, b, c)) {
+			result->push_back(a);
+			result->push_back(b);
+			result->push_back(c);
+			clip = true;
+		}
+		if (clip) {
+			unlink(b);
+			--remaining;
+			stall = 0;
+		}
+		else if (++stall > 2 * remaining) {
+			result->clear();
+			return false;
+		}
+		b = c;
+	}
+
+	std::uint32_t a = prevs[b];
+	std::uint32_t c = nexts[b];
+	if (orient2d(vertices[a], vertices[b], vertices[c]) > 0.0) {
+		result->push_back(a);
+		result->push_back(b);
+		result->push_back(c);
+	}
+	return true;
+}
@@ -0,0 +1,68 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+/**
+ * @file triangulation.h
+ * This header contains functions for splitting polygons into triangles.
+ * Results are indexed triangle lists: three vertex indices per triangle, referring to the input vertex array.
+ * Triangles run counter-clockwise in a coordinate system with y pointing up, so @ref orient2d of each triangle is positive,
+ * regardless of the orientation of the input.
+ * Orientation and incircle tests are exact, see @ref predicates.h.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "arena.h"
+#include "glm/gtc/type_precision.hpp"
+#include "polygon.h"
+
+namespace glm_plus {
+
+/**
+ * Splits a polygon with holes into triangles.
+ * Single polygons with few vertices use @ref triangulate_ear_clipping, which is faster for them,
+ * everything else uses @ref triangulate_delaunay.
+ * @param shape Polygons, see @ref triangulate_delaunay.
+ * @param result Vertex indices, three per triangle, referring to <tt>shape.vertices</tt>. Previous contents are replaced.
+ * @param scratch Arena for intermediate buffers. Heap is used if @c nullptr.
+ * @return @c True on success, @c false if polygon edges cross, in which case @p result is empty.
+ * Crossing edges of small polygons are not always detected.
+ */
+bool triangulate(const polygon_list& shape, std::vector<std::uint32_t>* result, arena* scratch = nullptr);
+
+/**
+ * Calculates the constrained Delaunay triangulation of a polygon with holes.
+ * All polygon edges are edges of the result, and other edges are chosen so that triangles are as close to equilateral as possible.
+ * Vertices are inserted in rounds of random vertices, each twice as large as the previous one, and sorted along a Hilbert curve
+ * within a round. Each vertex is located by walking from the previous one,
+ * and polygon edges are then inserted by flipping the edges they cross, which runs in O(n log n) for typical inputs.
+ * Area inside an odd number of polygons is triangulated, so holes and islands inside holes can be given in any order and orientation.
+ * Polygons may touch each other in vertices, and vertices lying exactly on an edge split it.
+ * Duplicate vertices are merged, so triangles use the index of the first one.
+ * @param shape Polygons. Typically the outer boundary, followed by holes.
+ * @param result Vertex indices, three per triangle, referring to <tt>shape.vertices</tt>. Previous contents are replaced.
+ * @param scratch Arena for intermediate buffers, about 100 bytes per vertex. Heap is used if @c nullptr.
+ * @return @c True on success, @c false if polygon edges cross, in which case @p result is empty.
+ */
+bool triangulate_delaunay(const polygon_list& shape, std::vector<std::uint32_t>* result, arena* scratch = nullptr);
+
+/**
+ * Splits a simple polygon without holes into triangles by clipping ears.
+ * Runs in O(n^2), but without any setup, so it is faster than @ref triangulate_delaunay for small polygons.
+ * Vertices, which would only produce triangles with zero area, are skipped,
+ * so the result may have fewer than <tt>count - 2</tt> triangles.
+ * @param vertices Polygon vertices, in any orientation.
+ * @param count Number of vertices.
+ * @param result Vertex indices, three per triangle, referring to @p vertices. Previous contents are replaced.
+ * @param scratch Arena for intermediate buffers, 8 bytes per vertex. Heap is used if @c nullptr.
+ * @return @c True on success, @c false if no ear was found, in which case @p result is empty.
+ * This can only happen when polygon edges cross, but crossing edges are not always detected.
+ */
+bool triangulate_ear_clipping(const glm::fvec2* vertices, std::size_t count, std::vector<std::uint32_t>* result, arena* scratch = nullptr);
+
+}
@@ -10,7 +10,10 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "glm/glm.hpp"
+#include "util.h"
 
 namespace glm_plus {
 
@@ -22,10 +25,10 @@ template<typename T>
 struct size : public glm::vec<2, T> {
 	size() = default;
 	explicit constexpr size(T x) : glm::vec<2, T>(x) {};
-	explicit size(glm::vec<2, T> vec) : glm::vec<2, T>(vec) {}
-	size(T x, T y) : glm::vec<2, T>(x, y) {};
-	size<T> operator+(const glm::vec<2, T>& other) { return size<T>(this->x + other.x, this->y + other.y); }
-	size<T> operator-(const glm::vec<2, T>& other) { return size<T>(this->x - other.x, this->y - other.y); }
+	explicit constexpr size(glm::vec<2, T> vec) : glm::vec<2, T>(vec) {}
+	constexpr size(T x, T y) : glm::vec<2, T>(x, y) {};
+	constexpr size<T> operator+(const glm::vec<2, T>& other) const { return size<T>(this->x + other.x, this->y + other.y); }
+	constexpr size<T> operator-(const glm::vec<2, T>& other) const { return size<T>(this->x - other.x, this->y - other.y); }
 };
 
 /**
@@ -35,24 +38,27 @@ struct size : public glm::vec<2, T> {
 template<typename T>
 struct pos : public glm::vec<2, T> {
 	pos() = default;
-	explicit pos(T x) : glm::vec<2, T>(x) {};
-	explicit pos(glm::vec<2, T> vec) : glm::vec<2, T>(vec) {}
-	pos(T x, T y) : glm::vec<2, T>(x, y) {}
-	pos<T> operator+(const glm::vec<2, T>& other) { return pos<T>(this->x + other.x, this->y + other.y); }
-	pos<T> operator-(const glm::vec<2, T>& other) { return pos<T>(this->x - other.x, this->y - other.y); }
+	explicit constexpr pos(T x) : glm::vec<2, T>(x) {};
+	explicit constexpr pos(glm::vec<2, T> vec) : glm::vec<2, T>(vec) {}
+	constexpr pos(T x, T y) : glm::vec<2, T>(x, y) {}
+	constexpr pos<T> operator+(const glm::vec<2, T>& other) const { return pos<T>(this->x + other.x, this->y + other.y); }
+	constexpr pos<T> operator-(const glm::vec<2, T>& other) const { return pos<T>(this->x - other.x, this->y - other.y); }
 };
 
+template<typename T> struct area;
+
 /**
  * Represents a rectangle by its location (corner with smallest coordinates) and size.
  */
 template<typename T>
 struct rect {
 	rect() = default;
-	explicit rect(const size<T> size) :
+	explicit constexpr rect(const size<T> size) :
 			size(size) {}
-	rect(const pos<T> location, const size<T> size) :
+	constexpr rect(const pos<T> location, const size<T> size) :
 			location(location),
 			size(size) {}
+	explicit constexpr rect(const area<T>& area);
 	
 	pos<T> location = {};
 	glm_plus::size<T> size = {};
@@ -64,55 +70,214 @@ struct rect {
 template<typename T>
 struct area {
 	area() = default;
-	area(const pos<T> tl, const pos<T> br) :
+	constexpr area(const pos<T> tl, const pos<T> br) :
 			topleft(tl),
 			bottomright(br) {}
-	area(const pos<T> tl, const size<T> sz) :
+	constexpr area(const pos<T> tl, const size<T> sz) :
 			topleft(tl),
 			bottomright(tl + sz) {}
+	explicit constexpr area(const rect<T>& rect) :
+			topleft(rect.location),
+			bottomright(rect.location + rect.size) {}
 			
 	pos<T> topleft = {};
 	pos<T> bottomright = {};
-	[[nodiscard]] pos<T> get_topright() { return {bottomright.x, topleft.y}; }
-	[[nodiscard]] pos<T> get_bottomleft() { return {topleft.x, bottomright.y}; }
+	[[nodiscard]] constexpr pos<T> get_topright() const { return {bottomright.x, topleft.y}; }
+	[[nodiscard]] constexpr pos<T> get_bottomleft() const { return {topleft.x, bottomright.y}; }
 };
 
+template<typename T>
+constexpr rect<T>::rect(const area<T>& area) :
+		location(area.topleft),
+		size(area.bottomright - area.topleft) {}
+
 /**
  * Represents a rectangle by it's opposite corners and size.
  */
 template<typename T>
 struct box {
 	box() = default;
-	box(const pos<T> tl, const pos<T> br) :
+	constexpr box(const pos<T> tl, const pos<T> br) :
 			topleft(tl),
 			bottomright(br),
-			size(bottomright - topleft) {}
-	box(const pos<T> tl, const size<T> sz) :
+			size(br - tl) {}
+	constexpr box(const pos<T> tl, const size<T> sz) :
 			topleft(tl),
 			bottomright(tl + sz),
 			size(sz) {}
-	explicit box(const size<T> sz) :
-			topleft(0.0f),
+	explicit constexpr box(const size<T> sz) :
+			topleft(T(0)),
 			bottomright(sz),
 			size(sz) {}
+	explicit constexpr box(const area<T>& area) :
+			box(area.topleft, area.bottomright) {}
 	
-	operator rect<T>() const { return rect<T>(topleft, size); }
-	operator area<T>() const { return area<T>(topleft, bottomright); }
+	constexpr operator rect<T>() const { return rect<T>(topleft, size); }
+	constexpr operator area<T>() const { return area<T>(topleft, bottomright); }
 	
 	pos<T> topleft = {};
 	pos<T> bottomright = {};
 	glm_plus::size<T> size = {};
 };
 
-inline bool inside_rect(glm::fvec2 pos, glm::fvec2 topleft, glm::fvec2 bottomright) {
+/**
+ * Represents a rectangle by its corners with smallest and largest coordinates, like @ref area.
+ * Aligned to its own size, which is 16 bytes for float and int, so arrays of boxes never straddle cache lines
+ * and each box can be loaded with a single vector load.
+ * Prefer it over @ref box for large arrays, since box also stores the size, which is redundant.
+ * Converts to @ref area implicitly, and to @ref rect and @ref box through their constructors from area.
+ */
+template<typename T>
+struct alignas(4 * sizeof(T)) aabb {
+	aabb() = default;
+	constexpr aabb(const pos<T> min, const pos<T> max) :
+			min(min),
+			max(max) {}
+	explicit constexpr aabb(const area<T>& area) :
+			min(area.topleft),
+			max(area.bottomright) {}
+	explicit constexpr aabb(const rect<T>& rect) :
+			min(rect.location),
+			max(rect.location + rect.size) {}
+	explicit constexpr aabb(const box<T>& box) :
+			min(box.topleft),
+			max(box.bottomright) {}
+	
+	constexpr operator area<T>() const { return area<T>(min, max); }
+	
+	pos<T> min = {};
+	pos<T> max = {};
+};
+
+/**
+ * Represents a line segment by its end points.
+ */
+template<typename T>
+struct segment {
+	segment() = default;
+	segment(const glm::vec<2, T> p1, const glm::vec<2, T> p2) :
+			p1(p1),
+			p2(p2) {}
+	
+	glm::vec<2, T> p1 = {};
+	glm::vec<2, T> p2 = {};
+};
+
+constexpr bool inside_rect(glm::fvec2 pos, glm::fvec2 topleft, glm::fvec2 bottomright) {
 	return pos.x >= topleft.x && pos.x <= bottomright.x && pos.y >= topleft.y && pos.y <= bottomright.y;
 }
 
 template<typename T>
-bool inside_rect(glm::vec<2, T> pos, area<T> area) {
+constexpr bool inside_rect(glm::vec<2, T> pos, area<T> area) {
 	return pos.x >= area.topleft.x && pos.x <= area.bottomright.x && pos.y >= area.topleft.y && pos.y <= area.bottomright.y;
 }
 
+/**
+ * Check if an area has no points, because its bottom right corner is above or left of its top left corner.
+ * Areas with zero width or height are not empty, since points on their edges are inside.
+ * @param a Area.
+ * @return @c True if the area is empty, @c false otherwise.
+ */
+template<typename T>
+constexpr bool is_empty(const area<T>& a) {
+	return a.bottomright.x < a.topleft.x || a.bottomright.y < a.topleft.y;
+}
+
+/**
+ * Check if two areas have any common points. Areas touching at an edge overlap.
+ * @param a First area.
+ * @param b Second area.
+ * @return @c True if the areas overlap, @c false otherwise.
+ */
+template<typename T>
+constexpr bool overlaps(const area<T>& a, const area<T>& b) {
+	return a.topleft.x <= b.bottomright.x && b.topleft.x <= a.bottomright.x && a.topleft.y <= b.bottomright.y && b.topleft.y <= a.bottomright.y;
+}
+
+/**
+ * Check if an area lies entirely inside another one. Edges may touch.
+ * @param outer Outer area.
+ * @param inner Inner area.
+ * @return @c True if @p inner is inside @p outer, @c false otherwise.
+ */
+template<typename T>
+constexpr bool contains(const area<T>& outer, const area<T>& inner) {
+	return outer.topleft.x <= inner.topleft.x && inner.bottomright.x <= outer.bottomright.x
+		&& outer.topleft.y <= inner.topleft.y && inner.bottomright.y <= outer.bottomright.y;
+}
+
+/**
+ * Calculates the common part of two areas.
+ * @param a First area.
+ * @param b Second area.
+ * @return Common area, which is empty if the areas do not overlap, see @ref is_empty.
+ */
+template<typename T>
+constexpr area<T> intersect(const area<T>& a, const area<T>& b) {
+	return area<T>(pos<T>(std::max(a.topleft.x, b.topleft.x), std::max(a.topleft.y, b.topleft.y)),
+		pos<T>(std::min(a.bottomright.x, b.bottomright.x), std::min(a.bottomright.y, b.bottomright.y)));
+}
+
+/**
+ * Calculates the smallest area, which contains both areas.
+ * @param a First area.
+ * @param b Second area.
+ * @return Bounding area.
+ */
+template<typename T>
+constexpr area<T> unite(const area<T>& a, const area<T>& b) {
+	return area<T>(pos<T>(std::min(a.topleft.x, b.topleft.x), std::min(a.topleft.y, b.topleft.y)),
+		pos<T>(std::max(a.bottomright.x, b.bottomright.x), std::max(a.bottomright.y, b.bottomright.y)));
+}
+
+/**
+ * Calculates the smallest area, which contains an area and a point.
+ * @param a Area.
+ * @param x Point.
+ * @return Bounding area.
+ */
+template<typename T>
+constexpr area<T> expand(const area<T>& a, glm::vec<2, T> x) {
+	return area<T>(pos<T>(std::min(a.topleft.x, x.x), std::min(a.topleft.y, x.y)),
+		pos<T>(std::max(a.bottomright.x, x.x), std::max(a.bottomright.y, x.y)));
+}
+
+/**
+ * Grows an area by a margin on each side. A negative margin shrinks it.
+ * @param a Area.
+ * @param margin Margin.
+ * @return Grown area.
+ */
+template<typename T>
+constexpr area<T> expand(const area<T>& a, type_identity_t<T> margin) {
+	return area<T>(pos<T>(a.topleft.x - margin, a.topleft.y - margin), pos<T>(a.bottomright.x + margin, a.bottomright.y + margin));
+}
+
+// Versions for rect, box and aabb, which work the same as for area.
+
+template<typename T> constexpr bool overlaps(const rect<T>& a, const rect<T>& b) { return overlaps(area<T>(a), area<T>(b)); }
+template<typename T> constexpr bool contains(const rect<T>& outer, const rect<T>& inner) { return contains(area<T>(outer), area<T>(inner)); }
+template<typename T> constexpr rect<T> intersect(const rect<T>& a, const rect<T>& b) { return rect<T>(intersect(area<T>(a), area<T>(b))); }
+template<typename T> constexpr rect<T> unite(const rect<T>& a, const rect<T>& b) { return rect<T>(unite(area<T>(a), area<T>(b))); }
+template<typename T> constexpr rect<T> expand(const rect<T>& a, glm::vec<2, T> x) { return rect<T>(expand(area<T>(a), x)); }
+template<typename T> constexpr rect<T> expand(const rect<T>& a, type_identity_t<T> margin) { return rect<T>(expand(area<T>(a), margin)); }
+
+template<typename T> constexpr bool overlaps(const box<T>& a, const box<T>& b) { return overlaps(area<T>(a.topleft, a.bottomright), area<T>(b.topleft, b.bottomright)); }
+template<typename T> constexpr bool contains(const box<T>& outer, const box<T>& inner) { return contains(area<T>(outer.topleft, outer.bottomright), area<T>(inner.topleft, inner.bottomright)); }
+template<typename T> constexpr box<T> intersect(const box<T>& a, const box<T>& b) { return box<T>(intersect(area<T>(a.topleft, a.bottomright), area<T>(b.topleft, b.bottomright))); }
+template<typename T> constexpr box<T> unite(const box<T>& a, const box<T>& b) { return box<T>(unite(area<T>(a.topleft, a.bottomright), area<T>(b.topleft, b.bottomright))); }
+template<typename T> constexpr box<T> expand(const box<T>& a, glm::vec<2, T> x) { return box<T>(expand(area<T>(a.topleft, a.bottomright), x)); }
+template<typename T> constexpr box<T> expand(const box<T>& a, type_identity_t<T> margin) { return box<T>(expand(area<T>(a.topleft, a.bottomright), margin)); }
+
+template<typename T> constexpr bool inside_rect(glm::vec<2, T> pos, const aabb<T>& a) { return inside_rect(pos, area<T>(a)); }
+template<typename T> constexpr bool is_empty(const aabb<T>& a) { return is_empty(area<T>(a)); }
+template<typename T> constexpr bool overlaps(const aabb<T>& a, const aabb<T>& b) { return overlaps(area<T>(a), area<T>(b)); }
+template<typename T> constexpr bool contains(const aabb<T>& outer, const aabb<T>& inner) { return contains(area<T>(outer), area<T>(inner)); }
+template<typename T> constexpr aabb<T> intersect(const aabb<T>& a, const aabb<T>& b) { return aabb<T>(intersect(area<T>(a), area<T>(b))); }
+template<typename T> constexpr aabb<T> unite(const aabb<T>& a, const aabb<T>& b) { return aabb<T>(unite(area<T>(a), area<T>(b))); }
+template<typename T> constexpr aabb<T> expand(const aabb<T>& a, glm::vec<2, T> x) { return aabb<T>(expand(area<T>(a), x)); }
+template<typename T> constexpr aabb<T> expand(const aabb<T>& a, type_identity_t<T> margin) { return aabb<T>(expand(area<T>(a), margin)); }
+
 typedef size<float> fsize;
 typedef size<int> isize;
 typedef pos<float> fpos;
@@ -122,5 +287,9 @@ typedef rect<int> irect;
 typedef area<float> farea;
 typedef area<int> iarea;
 typedef box<float> fbox;
+typedef box<int> ibox;
+typedef aabb<float> faabb;
+typedef aabb<int> iaabb;
+typedef segment<float> fsegment;
 
 }
\ No newline at end of file
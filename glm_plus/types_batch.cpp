@@ -0,0 +1,91 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "types_batch.h"
+
+#include <algorithm>
+
+using namespace glm_plus;
+using namespace glm;
+
+namespace {
+
+template<typename T>
+void inside_rect_mask(const T* xs, const T* ys, std::size_t count, const area<T>& a, std::uint32_t* result) {
+	T left = a.topleft.x;
+	T top = a.topleft.y;
+	T right = a.bottomright.x;
+	T bottom = a.bottomright.y;
+	detail::write_mask(count, result, [=](std::size_t i) {
+		return static_cast<std::uint32_t>((xs[i] >= left) & (xs[i] <= right) & (ys[i] >= top) & (ys[i] <= bottom));
+	});
+}
+
+template<typename T>
+void overlaps_mask(const T* x1s, const T* y1s, const T* x2s, const T* y2s, std::size_t count, const area<T>& a, std::uint32_t* result) {
+	T left = a.topleft.x;
+	T top = a.topleft.y;
+	T right = a.bottomright.x;
+	T bottom = a.bottomright.y;
+	detail::write_mask(count, result, [=](std::size_t i) {
+		return static_cast<std::uint32_t>((x1s[i] <= right) & (left <= x2s[i]) & (y1s[i] <= bottom) & (top <= y2s[i]));
+	});
+}
+
+template<typename T>
+void contains_mask(const area<T>& a, const T* x1s, const T* y1s, const T* x2s, const T* y2s, std::size_t count, std::uint32_t* result) {
+	T left = a.topleft.x;
+	T top = a.topleft.y;
+	T right = a.bottomright.x;
+	T bottom = a.bottomright.y;
+	detail::write_mask(count, result, [=](std::size_t i) {
+		return static_cast<std::uint32_t>((left <= x1s[i]) & (x2s[i] <= right) & (top <= y1s[i]) & (y2s[i] <= bottom));
+	});
+}
+
+template<typename T>
+void pairwise_overlaps_mask(const T* ax1s, const T* ay1s, const T* ax2s, const T* ay2s, std::size_t a_count,
+		const T* bx1s, const T* by1s, const T* bx2s, const T* by2s, std::size_t b_count, std::uint32_t* result) {
+	std::size_t row_words = mask_words(b_count);
+	for (std::size_t i = 0; i < a_count; ++i) {
+		area<T> a(pos<T>(ax1s[i], ay1s[i]), pos<T>(ax2s[i], ay2s[i]));
+		overlaps_mask(bx1s, by1s, bx2s, by2s, b_count, a, result + i * row_words);
+	}
+}
+
+}
+
+void glm_plus::inside_rect(const float* xs, const float* ys, std::size_t count, const farea& area, std::uint32_t* result) {
+	inside_rect_mask(xs, ys, count, area, result);
+}
+
+void glm_plus::inside_rect(const int* xs, const int* ys, std::size_t count, const iarea& area, std::uint32_t* result) {
+	inside_rect_mask(xs, ys, count, area, result);
+}
+
+void glm_plus::overlaps(const float* x1s, const float* y1s, const float* x2s, const float* y2s, std::size_t count, const farea& area, std::uint32_t* result) {
+	overlaps_mask(x1s, y1s, x2s, y2s, count, area, result);
+}
+
+void glm_plus::overlaps(const int* x1s, const int* y1s, const int* x2s, const int* y2s, std::size_t count, const iarea& area, std::uint32_t* result) {
+	overlaps_mask(x1s, y1s, x2s, y2s, count, area, result);
+}
+
+void glm_plus::contains(const farea& outer, const float* x1s, const float* y1s, const float* x2s, const float* y2s, std::size_t count, std::uint32_t* result) {
+	contains_mask(outer, x1s, y1s, x2s, y2s, count, result);
+}
+
+void glm_plus::contains(const iarea& outer, const int* x1s, const int* y1s, const int* x2s, const int* y2s, std::size_t count, std::uint32_t* result) {
+	contains_mask(outer, x1s, y1s, x2s, y2s, count, result);
+}
+
+void glm_plus::overlaps(const float* ax1s, const float* ay1s, const float* ax2s, const float* ay2s, std::size_t a_count,
+		const float* bx1s, const float* by1s, const float* bx2s, const float* by2s, std::size_t b_count, std::uint32_t* result) {
+	pairwise_overlaps_mask(ax1s, ay1s, ax2s, ay2s, a_count, bx1s, by1s, bx2s, by2s, b_count, result);
+}
+
+void glm_plus::overlaps(const int* ax1s, const int* ay1s, const int* ax2s, const int* ay2s, std::size_t a_count,
+		const int* bx1s, const int* by1s, const int* bx2s, const int* by2s, std::size_t b_count, std::uint32_t* result) {
+	pairwise_overlaps_mask(ax1s, ay1s, ax2s, ay2s, a_count, bx1s, by1s, bx2s, by2s, b_count, result);
+}
@@ -0,0 +1,140 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+/**
+ * @file types_batch.h
+ * This header contains batched versions of the area functions in @ref types.h,
+ * which test many points or areas at once.
+ * Points are passed as separate x and y coordinate arrays, and areas as separate arrays
+ * of top left (@c x1s, @c y1s) and bottom right (@c x2s, @c y2s) corner coordinates,
+ * which lets the compiler vectorize the loops.
+ * Results are written as bitmasks, see @ref mask_words. Unused bits of the last word are cleared.
+ * Areas can also be kept in a @ref box_soa, which the functions take directly.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "types.h"
+#include "util.h"
+
+namespace glm_plus {
+
+/**
+ * List of axis aligned boxes, stored as separate arrays of corner coordinates.
+ * Corners with smallest coordinates are in @c min_x and @c min_y, and corners with largest coordinates in @c max_x and @c max_y.
+ */
+template<typename T>
+struct box_soa {
+	void push_back(const aabb<T>& b) {
+		min_x.push_back(b.min.x);
+		min_y.push_back(b.min.y);
+		max_x.push_back(b.max.x);
+		max_y.push_back(b.max.y);
+	}
+	void reserve(std::size_t count) {
+		min_x.reserve(count);
+		min_y.reserve(count);
+		max_x.reserve(count);
+		max_y.reserve(count);
+	}
+	void clear() {
+		min_x.clear();
+		min_y.clear();
+		max_x.clear();
+		max_y.clear();
+	}
+	[[nodiscard]] aabb<T> operator[](std::size_t i) const { return aabb<T>(pos<T>(min_x[i], min_y[i]), pos<T>(max_x[i], max_y[i])); }
+	[[nodiscard]] std::size_t size() const { return min_x.size(); }
+	[[nodiscard]] bool empty() const { return min_x.empty(); }
+	
+	std::vector<T> min_x;
+	std::vector<T> min_y;
+	std::vector<T> max_x;
+	std::vector<T> max_y;
+};
+
+typedef box_soa<float> fbox_soa;
+typedef box_soa<int> ibox_soa;
+
+/**
+ * Check if the points are inside an area. Points on the area edge are inside.
+ * Batched version of @ref inside_rect.
+ * @param xs X coordinates of the points to test.
+ * @param ys Y coordinates of the points to test.
+ * @param count Number of points.
+ * @param area Area.
+ * @param result Bitmask of <tt>mask_words(count)</tt> words.
+ */
+void inside_rect(const float* xs, const float* ys, std::size_t count, const farea& area, std::uint32_t* result);
+void inside_rect(const int* xs, const int* ys, std::size_t count, const iarea& area, std::uint32_t* result);
+
+/**
+ * Check if the areas overlap an area. Areas touching at an edge overlap.
+ * Batched version of @ref overlaps.
+ * @param x1s X coordinates of the top left corners of the areas to test.
+ * @param y1s Y coordinates of the top left corners of the areas to test.
+ * @param x2s X coordinates of the bottom right corners of the areas to test.
+ * @param y2s Y coordinates of the bottom right corners of the areas to test.
+ * @param count Number of areas.
+ * @param area Area to test against.
+ * @param result Bitmask of <tt>mask_words(count)</tt> words.
+ */
+void overlaps(const float* x1s, const float* y1s, const float* x2s, const float* y2s, std::size_t count, const farea& area, std::uint32_t* result);
+void overlaps(const int* x1s, const int* y1s, const int* x2s, const int* y2s, std::size_t count, const iarea& area, std::uint32_t* result);
+
+/**
+ * Check if the areas lie entirely inside an area. Edges may touch.
+ * Batched version of @ref contains.
+ * @param outer Outer area.
+ * @param x1s X coordinates of the top left corners of the areas to test.
+ * @param y1s Y coordinates of the top left corners of the areas to test.
+ * @param x2s X coordinates of the bottom right corners of the areas to test.
+ * @param y2s Y coordinates of the bottom right corners of the areas to test.
+ * @param count Number of areas.
+ * @param result Bitmask of <tt>mask_words(count)</tt> words.
+ */
+void contains(const farea& outer, const float* x1s, const float* y1s, const float* x2s, const float* y2s, std::size_t count, std::uint32_t* result);
+void contains(const iarea& outer, const int* x1s, const int* y1s, const int* x2s, const int* y2s, std::size_t count, std::uint32_t* result);
+
+/**
+ * Check which areas of one list overlap which areas of another list.
+ * Runs in O(n * m), so it is meant for small lists, or as a stage after coarser culling.
+ * @param ax1s X coordinates of the top left corners of the first list.
+ * @param ay1s Y coordinates of the top left corners of the first list.
+ * @param ax2s X coordinates of the bottom right corners of the first list.
+ * @param ay2s Y coordinates of the bottom right corners of the first list.
+ * @param a_count Number of areas in the first list.
+ * @param bx1s X coordinates of the top left corners of the second list.
+ * @param by1s Y coordinates of the top left corners of the second list.
+ * @param bx2s X coordinates of the bottom right corners of the second list.
+ * @param by2s Y coordinates of the bottom right corners of the second list.
+ * @param b_count Number of areas in the second list.
+ * @param result Bit matrix of @p a_count rows with <tt>mask_words(b_count)</tt> words each.
+ * Bit @c j of row @c i is set if area @c i of the first list overlaps area @c j of the second list.
+ */
+void overlaps(const float* ax1s, const float* ay1s, const float* ax2s, const float* ay2s, std::size_t a_count,
+		const float* bx1s, const float* by1s, const float* bx2s, const float* by2s, std::size_t b_count, std::uint32_t* result);
+void overlaps(const int* ax1s, const int* ay1s, const int* ax2s, const int* ay2s, std::size_t a_count,
+		const int* bx1s, const int* by1s, const int* bx2s, const int* by2s, std::size_t b_count, std::uint32_t* result);
+
+// Versions for box_soa, which work the same as for separate arrays.
+template<typename T>
+void overlaps(const box_soa<T>& boxes, const area<T>& area, std::uint32_t* result) {
+	overlaps(boxes.min_x.data(), boxes.min_y.data(), boxes.max_x.data(), boxes.max_y.data(), boxes.size(), area, result);
+}
+template<typename T>
+void contains(const area<T>& outer, const box_soa<T>& boxes, std::uint32_t* result) {
+	contains(outer, boxes.min_x.data(), boxes.min_y.data(), boxes.max_x.data(), boxes.max_y.data(), boxes.size(), result);
+}
+template<typename T>
+void overlaps(const box_soa<T>& a, const box_soa<T>& b, std::uint32_t* result) {
+	overlaps(a.min_x.data(), a.min_y.data(), a.max_x.data(), a.max_y.data(), a.size(),
+		b.min_x.data(), b.min_y.data(), b.max_x.data(), b.max_y.data(), b.size(), result);
+}
+
+}
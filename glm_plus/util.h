@@ -10,10 +10,99 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @def GLM_PLUS_INLINE
+ * Specifier for functions, which are compiled into the library, or defined inline in header-only mode.
+ * @def GLM_PLUS_CONSTEXPR
+ * Specifier for functions, which are compiled into the library, or defined constexpr in header-only mode.
+ */
+#ifdef GLM_PLUS_HEADER_ONLY
+#define GLM_PLUS_INLINE inline
+#define GLM_PLUS_CONSTEXPR constexpr
+#else
+#define GLM_PLUS_INLINE
+#define GLM_PLUS_CONSTEXPR
+#endif
+
 namespace glm_plus {
 
-const float tiny_margin = 1.0e-5f;
+/**
+ * Default margin for comparisons, which must tolerate rounding errors, for scalar type @p T.
+ * It is 1.0e-5 for @c float, about 84 times its machine epsilon, and 1.0e-12 for @c double, about 4500 times its machine epsilon.
+ */
+template<typename T> constexpr T tiny_margin_v = T(1.0e-5);
+template<> constexpr double tiny_margin_v<double> = 1.0e-12;
+
+constexpr float tiny_margin = tiny_margin_v<float>;
+
+/**
+ * Wraps a type, so it is not used to deduce template arguments.
+ * Lets scalar parameters, like margins, accept any arithmetic type, once the vector arguments have deduced @p T.
+ */
+template<typename T> struct type_identity { typedef T type; };
+template<typename T> using type_identity_t = typename type_identity<T>::type;
+
+template<typename T> constexpr T square(T x) { return x * x; }
+
+/**
+ * Calculates the number of 32-bit words needed to store a bitmask with one bit per item.
+ * Bit @c i of the mask is stored as bit <tt>i % 32</tt> of word <tt>i / 32</tt>.
+ * @param count Number of items.
+ * @return Number of mask words.
+ */
+constexpr std::size_t mask_words(std::size_t count) { return (count + 31) / 32; }
+
+/**
+ * Reads a single bit from a bitmask.
+ * @param mask Bitmask.
+ * @param i Item index.
+ * @return @c True if the bit is set, @c false otherwise.
+ */
+inline bool mask_test(const std::uint32_t* mask, std::size_t i) { return (mask[i / 32] >> (i % 32)) & 1u; }
+
+namespace detail {
+
+/**
+ * Packs up to 32 tests, starting with item @p first, into one mask word.
+ * Tests are evaluated into a flag array first, so both loops can be vectorized. Bits are selected with a table lookup
+ * instead of a variable shift, which SSE2 can not vectorize. Tests should return 0 or 1 and should not branch.
+ */
+template<typename Test>
+std::uint32_t mask_word(std::size_t first, std::uint32_t count, Test test) {
+	static constexpr std::uint32_t bit_values[32] = {
+		1u << 0, 1u << 1, 1u << 2, 1u << 3, 1u << 4, 1u << 5, 1u << 6, 1u << 7,
+		1u << 8, 1u << 9, 1u << 10, 1u << 11, 1u << 12, 1u << 13, 1u << 14, 1u << 15,
+		1u << 16, 1u << 17, 1u << 18, 1u << 19, 1u << 20, 1u << 21, 1u << 22, 1u << 23,
+		1u << 24, 1u << 25, 1u << 26, 1u << 27, 1u << 28, 1u << 29, 1u << 30, 1u << 31};
+
+	std::uint32_t flags[32];
+	for (std::uint32_t j = 0; j < count; ++j)
+		flags[j] = test(first + j);
+
+	std::uint32_t bits = 0;
+	for (std::uint32_t j = 0; j < count; ++j)
+		bits |= (0u - flags[j]) & bit_values[j];
+	return bits;
+}
+
+/**
+ * Writes a bitmask of a test for each item, see @ref mask_words. Unused bits of the last word are cleared.
+ * Full words are packed with a constant count, which lets the compiler unroll the packing loop.
+ */
+template<typename Test>
+void write_mask(std::size_t count, std::uint32_t* result, Test test) {
+	std::size_t full_words = count / 32;
+	for (std::size_t w = 0; w < full_words; ++w)
+		result[w] = mask_word(w * 32, 32, test);
+
+	std::size_t rest = count % 32;
+	if (rest != 0)
+		result[full_words] = mask_word(full_words * 32, static_cast<std::uint32_t>(rest), test);
+}
 
-template<typename T> T square(T x) { return x * x; }
+}
 
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 /**
  * @file vector.h
  * This header contains functions relating to vectors.
+ * All functions are templated on the scalar type @c T of the vectors.
  */
 
 #pragma once
@@ -23,7 +24,8 @@ namespace glm_plus {
  * @param margin Max distance.
  * @return @c True if points overlap, @c false otherwise.
  */
-inline bool is_overlapping(glm::fvec2 p1, glm::fvec2 p2, float margin = tiny_margin);  // TODO: Make it constexpr if glm lib makes distance2 constexpr.
+template<typename T>
+inline bool is_overlapping(glm::vec<2, T> p1, glm::vec<2, T> p2, type_identity_t<T> margin = tiny_margin_v<T>);  // TODO: Make it constexpr if glm lib makes distance2 constexpr.
 
 /**
  * Calculates tangent vector.
@@ -32,7 +34,8 @@ inline bool is_overlapping(glm::fvec2 p1, glm::fvec2 p2, float margin = tiny_mar
  * @param vec Vector.
  * @return Tangent vector. 
  */
-constexpr glm::fvec2 calc_tangent(glm::fvec2 vec);
+template<typename T>
+constexpr glm::vec<2, T> calc_tangent(glm::vec<2, T> vec);
 
 /**
  * Returns a vector with same direction as input @p vec
@@ -41,7 +44,8 @@ constexpr glm::fvec2 calc_tangent(glm::fvec2 vec);
  * @param length Length.
  * @return Vector with length @p length.
  */
-constexpr glm::fvec2 set_length(glm::fvec2 vec, float length);
+template<typename T>
+constexpr glm::vec<2, T> set_length(glm::vec<2, T> vec, type_identity_t<T> length);
 
 /**
  * Calculates a vector, as if it were mirrored
@@ -51,23 +55,28 @@ constexpr glm::fvec2 set_length(glm::fvec2 vec, float length);
  * @param normal Mirror plane normal. Expected to be normalized.
  * @return Mirrored vector. Has the same magnitude as input @p vec.
  */
-constexpr glm::fvec2 mirror(glm::fvec2 vec, glm::fvec2 normal);
+template<typename T>
+constexpr glm::vec<2, T> mirror(glm::vec<2, T> vec, glm::vec<2, T> normal);
 
-inline bool is_overlapping(glm::fvec2 p1, glm::fvec2 p2, float margin) {
+template<typename T>
+inline bool is_overlapping(glm::vec<2, T> p1, glm::vec<2, T> p2, type_identity_t<T> margin) {
 	return glm::distance2(p1, p2) <= margin * margin;
 }
 
-constexpr glm::fvec2 calc_tangent(glm::fvec2 vec) {
-	return glm::fvec2(-vec.y, vec.x);
+template<typename T>
+constexpr glm::vec<2, T> calc_tangent(glm::vec<2, T> vec) {
+	return glm::vec<2, T>(-vec.y, vec.x);
 }
 
-constexpr glm::fvec2 set_length(glm::fvec2 vec, float length) {
+template<typename T>
+constexpr glm::vec<2, T> set_length(glm::vec<2, T> vec, type_identity_t<T> length) {
 	return vec * (length / glm::length(vec));
 }
 
-constexpr glm::fvec2 mirror(glm::fvec2 vec, glm::fvec2 normal) {
-	glm::fvec2 v = normal * dot(vec, normal);
-	return v * -2.0f + vec;
+template<typename T>
+constexpr glm::vec<2, T> mirror(glm::vec<2, T> vec, glm::vec<2, T> normal) {
+	glm::vec<2, T> v = normal * dot(vec, normal);
+	return v * T(-2) + vec;
 }
 
 }
\ No newline at end of file
@@ -0,0 +1,126 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/aabb_tree.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "assertions.h"
+
+namespace glmp = glm_plus;
+
+namespace {
+
+glmp::farea make_area(float x, float y, float w, float h) {
+	return glmp::farea(glmp::fpos(x, y), glmp::fsize(w, h));
+}
+
+bool overlaps(const glmp::farea& a, const glmp::farea& b) {
+	return a.topleft.x <= b.bottomright.x && a.bottomright.x >= b.topleft.x
+		&& a.topleft.y <= b.bottomright.y && a.bottomright.y >= b.topleft.y;
+}
+
+}
+
+TEST(aabb_tree, insert_query) {
+	glmp::faabb_tree tree;
+	std::uint32_t a = tree.insert(make_area(0.0f, 0.0f, 1.0f, 1.0f), 10);
+	std::uint32_t b = tree.insert(make_area(5.0f, 5.0f, 1.0f, 1.0f), 11);
+	std::uint32_t c = tree.insert(make_area(0.5f, 0.5f, 5.0f, 1.0f), 12);
+	
+	ASSERT_EQ(tree.get_size(), 3u);
+	ASSERT_EQ(tree.get_user_id(b), 11u);
+	
+	std::vector<std::uint32_t> r;
+	tree.query(make_area(0.0f, 0.0f, 0.2f, 0.2f), &r);
+	ASSERT_EQ(r, (std::vector<std::uint32_t>{a}));
+	
+	r.clear();
+	tree.query(make_area(4.0f, 0.0f, 2.0f, 10.0f), &r);
+	std::sort(r.begin(), r.end());
+	ASSERT_EQ(r, (std::vector<std::uint32_t>{b, c}));
+}
+
+TEST(aabb_tree, move_remove) {
+	glmp::faabb_tree tree(0.5f);
+	std::uint32_t a = tree.insert(make_area(0.0f, 0.0f, 1.0f, 1.0f));
+	std::uint32_t b = tree.insert(make_area(10.0f, 0.0f, 1.0f, 1.0f));
+	
+	ASSERT_FALSE(tree.move(a, make_area(0.25f, 0.25f, 1.0f, 1.0f)));
+	ASSERT_TRUE(tree.move(a, make_area(9.5f, 0.0f, 1.0f, 1.0f)));
+	
+	std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs;
+	tree.find_overlapping_pairs(&pairs);
+	ASSERT_EQ(pairs.size(), 1u);
+	ASSERT_EQ(pairs[0], std::make_pair(std::min(a, b), std::max(a, b)));
+	
+	tree.remove(b);
+	ASSERT_EQ(tree.get_size(), 1u);
+	ASSERT_EQ(tree.get_height(), 0);
+	tree.remove(a);
+	ASSERT_EQ(tree.get_height(), -1);
+}
+
+TEST(aabb_tree, matches_brute_force) {
+	std::mt19937 rng(11);
+	std::uniform_real_distribution<float> coord(0.0f, 100.0f);
+	std::uniform_real_distribution<float> extent(0.1f, 4.0f);
+	
+	glmp::faabb_tree tree(0.2f);
+	std::vector<std::uint32_t> proxies;
+	std::vector<glmp::farea> bounds;
+	for (int i = 0; i < 500; ++i) {
+		glmp::farea b = make_area(coord(rng), coord(rng), extent(rng), extent(rng));
+		proxies.push_back(tree.insert(b, static_cast<std::uint32_t>(i)));
+		bounds.push_back(b);
+	}
+	for (int i = 0; i < 500; i += 2) {
+		glmp::farea b = make_area(coord(rng), coord(rng), extent(rng), extent(rng));
+		tree.move(proxies[i], b);
+		bounds[i] = b;
+	}
+	ASSERT_LT(tree.get_height(), 30);
+	
+	for (int q = 0; q < 20; ++q) {
+		glmp::farea range = make_area(coord(rng), coord(rng), 10.0f, 10.0f);
+		std::vector<std::uint32_t> r;
+		tree.query(range, &r);
+		for (std::size_t i = 0; i < bounds.size(); ++i) {
+			bool found = std::find(r.begin(), r.end(), proxies[i]) != r.end();
+			if (overlaps(bounds[i], range)) {
+				ASSERT_TRUE(found);
+			}
+			else if (found) {
+				ASSERT_TRUE(overlaps(tree.get_fat_bounds(proxies[i]), range));
+			}
+		}
+		
+		glm::fvec2 x(coord(rng), coord(rng));
+		std::uint32_t nearest;
+		float d2;
+		ASSERT_TRUE(tree.nearest(x, &nearest, &d2));
+		for (const glmp::farea& b : bounds) {
+			float dx = std::max(std::max(b.topleft.x - x.x, x.x - b.bottomright.x), 0.0f);
+			float dy = std::max(std::max(b.topleft.y - x.y, x.y - b.bottomright.y), 0.0f);
+			ASSERT_GE(dx * dx + dy * dy, d2);
+		}
+	}
+}
+
+TEST(aabb_tree, raycast_circles) {
+	glmp::faabb_tree tree;
+	tree.insert(make_area(6.0f, 6.0f, 4.0f, 4.0f));
+	std::uint32_t near = tree.insert(make_area(2.0f, 7.0f, 2.0f, 2.0f));
+	tree.insert(make_area(20.0f, 20.0f, 2.0f, 2.0f));
+	
+	std::uint32_t proxy;
+	glm::fvec2 r;
+	ASSERT_TRUE(tree.raycast_circles(glm::fvec2(0.0f, 8.0f), glm::fvec2(12.0f, 8.0f), &proxy, &r));
+	ASSERT_EQ(proxy, near);
+	ASSERT_VEC2_EQ(r, 2.0f, 8.0f);
+	ASSERT_FALSE(tree.raycast_circles(glm::fvec2(0.0f, 0.0f), glm::fvec2(12.0f, 0.0f), &proxy, &r));
+}
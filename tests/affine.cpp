@@ -0,0 +1,69 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/affine.h"
+
+#include <vector>
+
+#include "glm_plus/matrix.h"
+
+#include "gtest/gtest.h"
+#include "assertions.h"
+
+namespace glmp = glm_plus;
+
+namespace {
+
+glm::fvec2 mat_transform(const glm::fmat3& mat, glm::fvec2 x) {
+	glm::fvec3 r = mat * glm::fvec3(x.x, x.y, 1.0f);
+	return {r.x, r.y};
+}
+
+}
+
+TEST(affine, mat3_conversion) {
+	constexpr glmp::affine2 t(glmp::scale_move_mat(glm::fvec2(4.0f, 5.0f), glm::fvec2(2.0f, 3.0f)));
+	static_assert(t.x_axis.x == 4.0f && t.y_axis.y == 5.0f && t.translation.x == 2.0f && t.translation.y == 3.0f, "");
+	ASSERT_EQ(glmp::to_mat3(t), glmp::scale_move_mat(glm::fvec2(4.0f, 5.0f), glm::fvec2(2.0f, 3.0f)));
+	ASSERT_EQ(glmp::to_mat3(glmp::affine2()), glm::fmat3(1.0f));
+}
+
+TEST(affine, transform) {
+	glmp::affine2 t({0.0f, 1.0f}, {-2.0f, 0.0f}, {10.0f, 20.0f});
+	ASSERT_VEC2_EQ(glmp::transform(t, glm::fvec2(1.0f, 0.0f)), 10.0f, 21.0f);
+	ASSERT_VEC2_EQ(glmp::transform(t, glm::fvec2(0.0f, 1.0f)), 8.0f, 20.0f);
+	ASSERT_EQ(glmp::transform(t, glm::fvec2(3.0f, -4.0f)), mat_transform(glmp::to_mat3(t), glm::fvec2(3.0f, -4.0f)));
+}
+
+TEST(affine, compose) {
+	glm::fmat3 m1 = glmp::screen_project_mat(glm::fvec2(800.0f, 600.0f), glm::fvec2(40.0f, 30.0f));
+	glm::fmat3 m2 = glmp::scale_move_mat(glm::fvec2(2.0f, 0.5f), glm::fvec2(-16.0f, 8.0f));
+	glmp::affine2 t = glmp::affine2(m1) * glmp::affine2(m2);
+	ASSERT_EQ(glmp::to_mat3(t), m1 * m2);
+	ASSERT_EQ(glmp::affine2() * t, t);
+	ASSERT_EQ(t * glmp::affine2(), t);
+	ASSERT_NE(glmp::affine2(m2) * glmp::affine2(m1), t);
+}
+
+TEST(affine, transform_batch) {
+	std::vector<glm::fvec2> points;
+	for (int i = 0; i < 37; ++i)
+		points.emplace_back(static_cast<float>(i) * 1.5f - 20.0f, static_cast<float>(i * i % 11) - 3.0f);
+
+	glmp::affine2 transforms[] = {
+		glmp::affine2(glmp::screen_project_mat(glm::fvec2(800.0f, 600.0f))),
+		glmp::affine2({0.5f, 0.25f}, {-0.75f, 2.0f}, {3.0f, -1.0f})};
+	for (const glmp::affine2& t : transforms) {
+		for (std::size_t count : {0u, 1u, 2u, 36u, 37u}) {
+			std::vector<glm::fvec2> result(count, glm::fvec2(-1.0f, -1.0f));
+			glmp::transform(t, points.data(), count, result.data());
+			for (std::size_t i = 0; i < count; ++i)
+				ASSERT_EQ(result[i], glmp::transform(t, points[i]));
+
+			std::vector<glm::fvec2> in_place(points.begin(), points.begin() + count);
+			glmp::transform(t, in_place.data(), count);
+			ASSERT_EQ(in_place, result);
+		}
+	}
+}
@@ -0,0 +1,173 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/arena.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "glm_plus/hull.h"
+#include "glm_plus/kd_tree.h"
+#include "glm_plus/polyline.h"
+#include "glm_plus/segment_index.h"
+#include "glm_plus/sweep.h"
+
+#include "gtest/gtest.h"
+
+namespace glmp = glm_plus;
+
+TEST(arena, allocate) {
+	glmp::arena a(1024);
+	ASSERT_EQ(a.get_capacity(), 1024);
+	ASSERT_EQ(a.get_used(), 0);
+
+	auto* c = a.allocate<char>(3);
+	auto* d = a.allocate<double>(2);
+	ASSERT_EQ(reinterpret_cast<std::uintptr_t>(d) % alignof(double), 0);
+	ASSERT_GT(reinterpret_cast<char*>(d), c);
+	ASSERT_GE(a.get_used(), 3 + 2 * sizeof(double));
+
+	auto* aligned = a.allocate(16, 64);
+	ASSERT_EQ(reinterpret_cast<std::uintptr_t>(aligned) % 64, 0);
+	ASSERT_EQ(a.get_overflow_count(), 0);
+}
+
+TEST(arena, reset) {
+	glmp::arena a(1024);
+	ASSERT_NE(a.allocate(100), nullptr);
+	glmp::arena::marker m = a.mark();
+	std::size_t used = a.get_used();
+	void* p = a.allocate(200);
+	ASSERT_NE(a.allocate(300), nullptr);
+	ASSERT_EQ(a.get_peak(), a.get_used());
+
+	a.reset(m);
+	ASSERT_EQ(a.get_used(), used);
+	ASSERT_EQ(a.allocate(200), p);
+
+	std::size_t peak = a.get_peak();
+	a.reset();
+	ASSERT_EQ(a.get_used(), 0);
+	ASSERT_EQ(a.get_peak(), peak);
+	a.reset_peak();
+	ASSERT_EQ(a.get_peak(), 0);
+
+	{
+		glmp::arena_scope scope(&a);
+		ASSERT_NE(a.allocate(500), nullptr);
+	}
+	ASSERT_EQ(a.get_used(), 0);
+}
+
+TEST(arena, deallocate_last) {
+	glmp::arena a(1024);
+	void* p = a.allocate(64);
+	void* q = a.allocate(64);
+	a.deallocate(p, 64);
+	ASSERT_NE(a.get_used(), 0);
+	a.deallocate(q, 64);
+	a.deallocate(p, 64);
+	ASSERT_EQ(a.get_used(), 0);
+}
+
+TEST(arena, overflow) {
+	glmp::arena a(256);
+	ASSERT_NE(a.allocate(200), nullptr);
+	glmp::arena::marker m = a.mark();
+	void* p = a.allocate(1000, 32);
+	ASSERT_NE(p, nullptr);
+	ASSERT_EQ(reinterpret_cast<std::uintptr_t>(p) % 32, 0);
+	ASSERT_NE(a.allocate(1000), nullptr);
+	ASSERT_EQ(a.get_overflow_count(), 2);
+	ASSERT_GE(a.get_peak(), 2200);
+
+	a.reset(m);
+	ASSERT_EQ(a.get_used(), 200);
+	ASSERT_EQ(a.get_overflow_count(), 2);
+}
+
+TEST(arena, external_buffer) {
+	alignas(16) char buffer[128];
+	glmp::arena a(buffer, sizeof(buffer));
+	void* p = a.allocate(64, 16);
+	ASSERT_EQ(p, buffer);
+}
+
+TEST(arena, allocator) {
+	glmp::arena a(4096);
+	{
+		glmp::arena_vector<int> v{glmp::arena_allocator<int>(&a)};
+		v.reserve(100);
+		for (int i = 0; i < 100; ++i)
+			v.push_back(i);
+		ASSERT_EQ(v[99], 99);
+		ASSERT_GE(a.get_used(), 100 * sizeof(int));
+	}
+	ASSERT_EQ(a.get_used(), 0);
+
+	// Without an arena, memory comes from the heap.
+	glmp::arena_vector<int> heap;
+	heap.resize(1000);
+	ASSERT_EQ(heap.get_allocator().get_arena(), nullptr);
+}
+
+TEST(arena, algorithms) {
+	std::mt19937 rng(5);
+	std::uniform_real_distribution<float> coord(-100.0f, 100.0f);
+	std::vector<glm::fvec2> points(2000);
+	for (glm::fvec2& p : points)
+		p = glm::fvec2(coord(rng), coord(rng));
+
+	glmp::arena a(1 << 20);
+	std::vector<glm::fvec2> expected;
+	std::vector<glm::fvec2> hull;
+	glmp::convex_hull(points.data(), points.size(), &expected);
+	glmp::convex_hull(points.data(), points.size(), &hull, &a);
+	ASSERT_EQ(hull, expected);
+	glmp::executor pool(4);
+	glmp::convex_hull(pool, points.data(), points.size(), &hull, &a);
+	ASSERT_EQ(hull, expected);
+	ASSERT_EQ(a.get_used(), 0);
+	ASSERT_GE(a.get_peak(), points.size() * sizeof(glm::fvec2));
+
+	std::vector<glmp::fsegment> segments;
+	for (std::size_t i = 0; i + 1 < points.size() && i < 200; i += 2)
+		segments.emplace_back(points[i] * 0.1f, points[i + 1] * 0.1f);
+	std::vector<glmp::segment_intersection> expected_pairs;
+	std::vector<glmp::segment_intersection> pairs;
+	glmp::find_line_segment_intersections(segments.data(), segments.size(), &expected_pairs);
+	glmp::find_line_segment_intersections(segments.data(), segments.size(), &pairs, &a);
+	ASSERT_EQ(pairs.size(), expected_pairs.size());
+	ASSERT_EQ(a.get_used(), 0);
+	ASSERT_EQ(a.get_overflow_count(), 0);
+
+	// Builders give the same results with temporary buffers from the arena.
+	glmp::kd_tree tree;
+	tree.build(points.data(), points.size(), &a);
+	glmp::kd_tree parallel_tree;
+	parallel_tree.build(pool, points.data(), points.size(), &a);
+	glmp::polyline_index index;
+	index.build(points.data(), points.size(), true, 16, &a);
+	ASSERT_EQ(a.get_used(), 0);
+	ASSERT_EQ(a.get_overflow_count(), 0);
+	std::vector<std::uint8_t> data;
+	std::vector<std::uint8_t> expected_data;
+	glmp::build_segment_index(segments.data(), segments.size(), &data, 4, &a);
+	glmp::build_segment_index(segments.data(), segments.size(), &expected_data, 4);
+	ASSERT_EQ(data, expected_data);
+	for (std::size_t i = 0; i < 50; ++i) {
+		glm::fvec2 q = points[i] * 0.5f;
+		glmp::kd_neighbor n1;
+		glmp::kd_neighbor n2;
+		ASSERT_TRUE(tree.nearest(q, &n1));
+		ASSERT_TRUE(parallel_tree.nearest(q, &n2));
+		ASSERT_EQ(n1.id, n2.id);
+		glmp::segment_point closest;
+		glmp::segment_point expected_closest;
+		ASSERT_TRUE(index.closest(q, &closest));
+		ASSERT_TRUE(glmp::closest_point_on_polyline(q, points.data(), points.size(), &expected_closest, true));
+		ASSERT_EQ(closest.id, expected_closest.id);
+	}
+}
@@ -0,0 +1,238 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/clip.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "glm_plus/hull.h"
+
+#include "gtest/gtest.h"
+
+namespace glmp = glm_plus;
+
+namespace {
+
+float signed_area(const glm::fvec2* v, std::size_t count) {
+	float a = 0.0f;
+	for (std::size_t i = 0, j = count - 1; i < count; j = i++)
+		a += v[j].x * v[i].y - v[i].x * v[j].y;
+	return a * 0.5f;
+}
+
+float area(const std::vector<glm::fvec2>& v) {
+	return std::abs(signed_area(v.data(), v.size()));
+}
+
+float total_area(const glmp::polygon_list& list) {
+	float a = 0.0f;
+	for (std::size_t i = 0; i < list.size(); ++i)
+		a += signed_area(list.vertices.data() + list.offsets[i], list.offsets[i + 1] - list.offsets[i]);
+	return std::abs(a);
+}
+
+float ring_area(const glmp::polygon_list& list, std::size_t i) {
+	return signed_area(list.vertices.data() + list.offsets[i], list.offsets[i + 1] - list.offsets[i]);
+}
+
+glmp::polygon reversed(const glmp::polygon& poly) {
+	return glmp::polygon(std::vector<glm::fvec2>(poly.vertices.rbegin(), poly.vertices.rend()));
+}
+
+glmp::polygon square(float x, float y, float size) {
+	return glmp::polygon({{x, y}, {x + size, y}, {x + size, y + size}, {x, y + size}});
+}
+
+}
+
+TEST(clip, rectangle) {
+	glmp::clip_workspace workspace;
+	std::vector<glm::fvec2> result;
+	glmp::farea bounds(glmp::fpos(0, 0), glmp::fpos(10, 10));
+
+	std::vector<glm::fvec2> inside = {{1, 1}, {9, 1}, {5, 9}};
+	glmp::clip(inside.data(), inside.size(), bounds, &result, &workspace);
+	ASSERT_EQ(result, inside);
+
+	std::vector<glm::fvec2> outside = {{11, 1}, {19, 1}, {15, 9}};
+	glmp::clip(outside.data(), outside.size(), bounds, &result, &workspace);
+	ASSERT_TRUE(result.empty());
+
+	std::vector<glm::fvec2> overlapping = {{5, 5}, {15, 5}, {15, 15}, {5, 15}};
+	glmp::clip(overlapping.data(), overlapping.size(), bounds, &result, &workspace);
+	ASSERT_EQ(result.size(), 4);
+	ASSERT_FLOAT_EQ(area(result), 25.0f);
+
+	std::vector<glm::fvec2> covering = {{-5, -5}, {15, -5}, {15, 15}, {-5, 15}};
+	glmp::clip(covering.data(), covering.size(), bounds, &result, &workspace);
+	ASSERT_FLOAT_EQ(area(result), 100.0f);
+	for (glm::fvec2 p : result)
+		ASSERT_TRUE(glmp::inside_rect(p, bounds));
+
+	// U shape, with both arms crossing the top side.
+	std::vector<glm::fvec2> concave = {{1, 5}, {9, 5}, {9, 15}, {7, 15}, {7, 7}, {3, 7}, {3, 15}, {1, 15}};
+	glmp::clip(concave.data(), concave.size(), bounds, &result, &workspace);
+	ASSERT_FLOAT_EQ(area(result), 8.0f * 5.0f - 4.0f * 3.0f);
+}
+
+TEST(clip, convex) {
+	glmp::clip_workspace workspace;
+	std::vector<glm::fvec2> result;
+
+	std::vector<glm::fvec2> points = {{0, 0}, {10, 0}, {10, 10}, {0, 10}, {5, 5}};
+	std::vector<glm::fvec2> hull;
+	glmp::convex_hull(points.data(), points.size(), &hull);
+
+	std::vector<glm::fvec2> subject = {{5, -5}, {15, 5}, {5, 15}, {-5, 5}};
+	glmp::clip_convex(subject.data(), subject.size(), hull.data(), hull.size(), &result, &workspace);
+	ASSERT_FLOAT_EQ(area(result), 100.0f);
+
+	std::vector<glm::fvec2> triangle = {{0, 0}, {10, 0}, {0, 10}};
+	glmp::clip_convex(hull.data(), hull.size(), triangle.data(), triangle.size(), &result, &workspace);
+	ASSERT_FLOAT_EQ(area(result), 50.0f);
+
+	std::vector<glm::fvec2> outside = {{20, 20}, {30, 20}, {30, 30}};
+	glmp::clip_convex(outside.data(), outside.size(), hull.data(), hull.size(), &result, &workspace);
+	ASSERT_TRUE(result.empty());
+}
+
+TEST(clip, boolean) {
+	glmp::clip_workspace workspace;
+	glmp::polygon_list result;
+	glmp::polygon a = square(0, 0, 10);
+	glmp::polygon b = square(5, 5, 10);
+
+	glmp::polygon_boolean(a, b, glmp::boolean_op::intersection, &result, &workspace);
+	ASSERT_EQ(result.size(), 1);
+	ASSERT_NEAR(total_area(result), 25.0f, 1e-4f);
+
+	glmp::polygon_boolean(a, b, glmp::boolean_op::union_, &result, &workspace);
+	ASSERT_EQ(result.size(), 1);
+	ASSERT_NEAR(total_area(result), 175.0f, 1e-4f);
+
+	glmp::polygon_boolean(a, b, glmp::boolean_op::difference, &result, &workspace);
+	ASSERT_EQ(result.size(), 1);
+	ASSERT_NEAR(total_area(result), 75.0f, 1e-4f);
+
+	glmp::polygon_boolean(b, a, glmp::boolean_op::difference, &result, &workspace);
+	ASSERT_EQ(result.size(), 1);
+	ASSERT_NEAR(total_area(result), 75.0f, 1e-4f);
+}
+
+TEST(clip, boolean_disjoint_and_nested) {
+	glmp::clip_workspace workspace;
+	glmp::polygon_list result;
+	glmp::polygon outer = square(0, 0, 10);
+	glmp::polygon inner = square(2, 2, 4);
+	glmp::polygon far = square(20, 20, 4);
+
+	glmp::polygon_boolean(outer, far, glmp::boolean_op::intersection, &result, &workspace);
+	ASSERT_EQ(result.size(), 0);
+	glmp::polygon_boolean(outer, far, glmp::boolean_op::union_, &result, &workspace);
+	ASSERT_EQ(result.size(), 2);
+
+	glmp::polygon_boolean(outer, inner, glmp::boolean_op::intersection, &result, &workspace);
+	ASSERT_EQ(result.size(), 1);
+	ASSERT_FLOAT_EQ(total_area(result), 16.0f);
+	glmp::polygon_boolean(inner, outer, glmp::boolean_op::union_, &result, &workspace);
+	ASSERT_EQ(result.size(), 1);
+	ASSERT_FLOAT_EQ(total_area(result), 100.0f);
+	glmp::polygon_boolean(inner, outer, glmp::boolean_op::difference, &result, &workspace);
+	ASSERT_EQ(result.size(), 0);
+
+	// The hole has opposite orientation, so signed areas add up to the area of the difference.
+	glmp::polygon_boolean(outer, inner, glmp::boolean_op::difference, &result, &workspace);
+	ASSERT_EQ(result.size(), 2);
+	ASSERT_FLOAT_EQ(total_area(result), 84.0f);
+	ASSERT_FLOAT_EQ(ring_area(result, 0), 100.0f);
+	ASSERT_FLOAT_EQ(ring_area(result, 1), -16.0f);
+	glmp::polygon_boolean(outer, reversed(inner), glmp::boolean_op::difference, &result, &workspace);
+	ASSERT_EQ(result.size(), 2);
+	ASSERT_FLOAT_EQ(ring_area(result, 0), 100.0f);
+	ASSERT_FLOAT_EQ(ring_area(result, 1), -16.0f);
+	glmp::polygon_boolean(outer, reversed(far), glmp::boolean_op::union_, &result, &workspace);
+	ASSERT_EQ(result.size(), 2);
+	ASSERT_FLOAT_EQ(ring_area(result, 0), 100.0f);
+	ASSERT_FLOAT_EQ(ring_area(result, 1), 16.0f);
+}
+
+TEST(clip, boolean_orientation) {
+	glmp::clip_workspace workspace;
+	glmp::polygon_list result;
+
+	// Outer rings run like the subject polygon.
+	glmp::polygon a = square(0, 0, 10);
+	glmp::polygon band({{-1, 4}, {11, 4}, {11, 6}, {-1, 6}});
+	glmp::polygon_boolean(a, band, glmp::boolean_op::difference, &result, &workspace);
+	ASSERT_EQ(result.size(), 2);
+	ASSERT_NEAR(ring_area(result, 0), 40.0f, 1e-4f);
+	ASSERT_NEAR(ring_area(result, 1), 40.0f, 1e-4f);
+	glmp::polygon_boolean(reversed(a), band, glmp::boolean_op::difference, &result, &workspace);
+	ASSERT_EQ(result.size(), 2);
+	ASSERT_NEAR(ring_area(result, 0), -40.0f, 1e-4f);
+	ASSERT_NEAR(ring_area(result, 1), -40.0f, 1e-4f);
+	glmp::polygon_boolean(a, reversed(band), glmp::boolean_op::intersection, &result, &workspace);
+	ASSERT_EQ(result.size(), 1);
+	ASSERT_NEAR(ring_area(result, 0), 20.0f, 1e-4f);
+
+	// A bar across the arms of a U closes a hole, which runs the opposite way.
+	glmp::polygon u({{0, 0}, {10, 0}, {10, 10}, {7, 10}, {7, 3}, {3, 3}, {3, 10}, {0, 10}});
+	glmp::polygon bar({{-1, 8}, {11, 8}, {11, 9}, {-1, 9}});
+	for (bool reverse : {false, true}) {
+		glmp::polygon_boolean(reverse ? reversed(u) : u, bar, glmp::boolean_op::union_, &result, &workspace);
+		ASSERT_EQ(result.size(), 2);
+		float sign = reverse ? -1.0f : 1.0f;
+		float a0 = ring_area(result, 0) * sign;
+		float a1 = ring_area(result, 1) * sign;
+		ASSERT_NEAR(std::max(a0, a1), 98.0f, 1e-4f);
+		ASSERT_NEAR(std::min(a0, a1), -20.0f, 1e-4f);
+	}
+}
+
+TEST(clip, boolean_degenerate) {
+	glmp::clip_workspace workspace;
+	glmp::polygon_list result;
+
+	// Shared edge and shared vertices.
+	glmp::polygon a = square(0, 0, 10);
+	glmp::polygon b = square(0, 5, 10);
+	glmp::polygon_boolean(a, b, glmp::boolean_op::intersection, &result, &workspace);
+	ASSERT_EQ(result.size(), 1);
+	ASSERT_NEAR(total_area(result), 50.0f, 1e-3f);
+
+	glmp::polygon_boolean(a, b, glmp::boolean_op::union_, &result, &workspace);
+	ASSERT_EQ(result.size(), 1);
+	ASSERT_NEAR(total_area(result), 150.0f, 1e-3f);
+
+	// Vertex exactly on an edge.
+	glmp::polygon diamond({{5, 0}, {10, 5}, {5, 10}, {0, 5}});
+	glmp::polygon_boolean(a, diamond, glmp::boolean_op::intersection, &result, &workspace);
+	ASSERT_EQ(result.size(), 1);
+	ASSERT_NEAR(total_area(result), 50.0f, 1e-3f);
+	glmp::polygon_boolean(a, reversed(diamond), glmp::boolean_op::difference, &result, &workspace);
+	ASSERT_FLOAT_EQ(total_area(result), 50.0f);
+	for (std::size_t i = 0; i < result.size(); ++i)
+		ASSERT_GT(ring_area(result, i), 0.0f);
+
+	// Identical polygons, where every vertex lies on the other polygon.
+	glmp::polygon_boolean(a, a, glmp::boolean_op::intersection, &result, &workspace);
+	ASSERT_EQ(result.size(), 1);
+	ASSERT_FLOAT_EQ(ring_area(result, 0), 100.0f);
+	glmp::polygon_boolean(a, reversed(a), glmp::boolean_op::union_, &result, &workspace);
+	ASSERT_EQ(result.size(), 1);
+	ASSERT_FLOAT_EQ(ring_area(result, 0), 100.0f);
+	glmp::polygon_boolean(a, a, glmp::boolean_op::difference, &result, &workspace);
+	ASSERT_EQ(result.size(), 0);
+
+	// Polygons touching from outside only along an edge or in a vertex.
+	for (glmp::polygon b2 : {square(10, 2, 5), square(-5, 3, 5), square(10, 10, 3)}) {
+		glmp::polygon_boolean(a, b2, glmp::boolean_op::intersection, &result, &workspace);
+		ASSERT_EQ(result.size(), 0);
+		glmp::polygon_boolean(a, b2, glmp::boolean_op::difference, &result, &workspace);
+		ASSERT_EQ(result.size(), 1);
+		ASSERT_FLOAT_EQ(ring_area(result, 0), 100.0f);
+	}
+}
@@ -0,0 +1,108 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/executor.h"
+#include "glm_plus/parallel.h"
+#include "glm_plus/line_batch.h"
+#include "glm_plus/types_batch.h"
+
+#include <atomic>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace glmp = glm_plus;
+
+TEST(executor, thread_count) {
+	glmp::executor pool(3);
+	ASSERT_EQ(pool.get_thread_count(), 3u);
+	ASSERT_GE(glmp::executor::get_default().get_thread_count(), 1u);
+}
+
+TEST(executor, parallel_for_covers_range) {
+	glmp::executor pool(4);
+	for (std::size_t count : {0u, 1u, 63u, 1000u, 100000u}) {
+		std::vector<std::atomic<int>> visits(count);
+		for (auto& v : visits)
+			v = 0;
+		pool.parallel_for(count, 100, [&](std::size_t begin, std::size_t end) {
+			for (std::size_t i = begin; i < end; ++i)
+				++visits[i];
+		});
+		for (std::size_t i = 0; i < count; ++i)
+			ASSERT_EQ(visits[i], 1);
+	}
+}
+
+TEST(executor, nested_parallel_for) {
+	glmp::executor pool(4);
+	std::atomic<std::size_t> total(0);
+	pool.parallel_for(64, 1, [&](std::size_t, std::size_t) {
+		pool.parallel_for(1000, 10, [&](std::size_t begin, std::size_t end) {
+			total += end - begin;
+		});
+	});
+	ASSERT_EQ(total, 64000u);
+}
+
+TEST(executor, parallel_matches_serial) {
+	glmp::executor pool(4);
+	std::vector<float> xs;
+	std::vector<float> ys;
+	std::vector<float> x2s;
+	std::vector<float> y2s;
+	for (int i = 0; i < 20000; ++i) {
+		xs.push_back(static_cast<float>(i % 101) - 50.0f);
+		ys.push_back(static_cast<float>(i % 37) * 2.0f - 37.0f);
+		x2s.push_back(xs.back() + static_cast<float>(i % 7) - 3.0f);
+		y2s.push_back(ys.back() + static_cast<float>(i % 11) - 5.0f);
+	}
+	// Odd size, so the last chunk ends in the middle of a mask word.
+	std::size_t count = xs.size() - 13;
+	glm::fvec2 a1(-40.0f, -30.0f);
+	glm::fvec2 a2(45.0f, 35.0f);
+
+	std::vector<float> d1(count);
+	std::vector<float> d2(count);
+	glmp::dist_to_line_signed(xs.data(), ys.data(), count, a1, a2, d1.data());
+	glmp::dist_to_line_signed(pool, xs.data(), ys.data(), count, a1, a2, d2.data());
+	ASSERT_EQ(d1, d2);
+
+	std::vector<std::uint32_t> m1(glmp::mask_words(count));
+	std::vector<std::uint32_t> m2(glmp::mask_words(count));
+	glmp::is_right_of_line(xs.data(), ys.data(), count, a1, a2, m1.data());
+	glmp::is_right_of_line(pool, xs.data(), ys.data(), count, a1, a2, m2.data());
+	ASSERT_EQ(m1, m2);
+
+	glmp::farea area(glmp::fpos(-20.0f, -10.0f), glmp::fpos(30.0f, 15.0f));
+	glmp::inside_rect(xs.data(), ys.data(), count, area, m1.data());
+	glmp::inside_rect(pool, xs.data(), ys.data(), count, area, m2.data());
+	ASSERT_EQ(m1, m2);
+
+	std::vector<std::uint32_t> h1(count);
+	std::vector<std::uint32_t> h2(count);
+	std::vector<float> t1(count);
+	std::vector<float> t2(count);
+	std::size_t n1 = glmp::line_segments_intersect(a1, a2, xs.data(), ys.data(), x2s.data(), y2s.data(), count, h1.data(), t1.data());
+	std::size_t n2 = glmp::line_segments_intersect(pool, a1, a2, xs.data(), ys.data(), x2s.data(), y2s.data(), count, h2.data(), t2.data());
+	ASSERT_GT(n1, 0u);
+	ASSERT_EQ(n1, n2);
+	h1.resize(n1);
+	h2.resize(n2);
+	t1.resize(n1);
+	t2.resize(n2);
+	ASSERT_EQ(h1, h2);
+	ASSERT_EQ(t1, t2);
+
+	// Chunk hit counts come from the arena.
+	glmp::arena a(1 << 12);
+	h2.assign(count, 0);
+	std::size_t n3 = glmp::line_segments_intersect(pool, a1, a2, xs.data(), ys.data(), x2s.data(), y2s.data(), count, h2.data(), t2.data(), &a);
+	ASSERT_EQ(n3, n1);
+	h2.resize(n3);
+	ASSERT_EQ(h1, h2);
+	ASSERT_EQ(a.get_used(), 0u);
+	ASSERT_GT(a.get_peak(), 0u);
+	ASSERT_EQ(a.get_overflow_count(), 0u);
+}
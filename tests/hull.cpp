@@ -0,0 +1,128 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/hull.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "glm_plus/predicates.h"
+
+#include "gtest/gtest.h"
+
+namespace glmp = glm_plus;
+
+namespace {
+
+std::vector<glm::fvec2> random_points(std::size_t count, unsigned seed) {
+	std::mt19937 rng(seed);
+	std::normal_distribution<float> coord(0.0f, 100.0f);
+	std::vector<glm::fvec2> points(count);
+	for (glm::fvec2& p : points)
+		p = glm::fvec2(coord(rng), coord(rng));
+	return points;
+}
+
+// Rotates the hull, so it starts with the same vertex as convex_hull.
+std::vector<glm::fvec2> canonical(std::vector<glm::fvec2> hull) {
+	auto first = std::min_element(hull.begin(), hull.end(), [](glm::fvec2 a, glm::fvec2 b) {
+		return a.x < b.x || (a.x == b.x && a.y < b.y);
+	});
+	std::rotate(hull.begin(), first, hull.end());
+	return hull;
+}
+
+void assert_convex_hull_of(const std::vector<glm::fvec2>& hull, const std::vector<glm::fvec2>& points) {
+	std::size_t n = hull.size();
+	ASSERT_GE(n, 3u);
+	for (std::size_t i = 0; i < n; ++i) {
+		ASSERT_GT(glmp::orient2d(hull[i], hull[(i + 1) % n], hull[(i + 2) % n]), 0.0);
+		for (glm::fvec2 p : points)
+			ASSERT_GE(glmp::orient2d(hull[i], hull[(i + 1) % n], p), 0.0);
+	}
+}
+
+}
+
+TEST(hull, convex_hull) {
+	std::vector<glm::fvec2> points = {
+		{0.0f, 0.0f}, {1.0f, 1.0f}, {2.0f, 0.0f}, {2.0f, 2.0f}, {0.0f, 2.0f},
+		{1.0f, 0.0f}, {2.0f, 2.0f}, {0.5f, 1.5f}, {0.0f, 1.0f}};
+	std::vector<glm::fvec2> hull;
+	glmp::convex_hull(points.data(), points.size(), &hull);
+	ASSERT_EQ(hull, (std::vector<glm::fvec2>{{0.0f, 0.0f}, {2.0f, 0.0f}, {2.0f, 2.0f}, {0.0f, 2.0f}}));
+}
+
+TEST(hull, convex_hull_degenerate) {
+	std::vector<glm::fvec2> hull;
+	glmp::convex_hull(nullptr, 0, &hull);
+	ASSERT_TRUE(hull.empty());
+
+	std::vector<glm::fvec2> same = {{1.0f, 2.0f}, {1.0f, 2.0f}, {1.0f, 2.0f}};
+	glmp::convex_hull(same.data(), same.size(), &hull);
+	ASSERT_EQ(hull, (std::vector<glm::fvec2>{{1.0f, 2.0f}}));
+
+	std::vector<glm::fvec2> line = {{2.0f, 2.0f}, {0.0f, 0.0f}, {3.0f, 3.0f}, {1.0f, 1.0f}};
+	glmp::convex_hull(line.data(), line.size(), &hull);
+	ASSERT_EQ(hull, (std::vector<glm::fvec2>{{0.0f, 0.0f}, {3.0f, 3.0f}}));
+}
+
+TEST(hull, convex_hull_random) {
+	std::vector<glm::fvec2> points = random_points(2000, 1);
+	std::vector<glm::fvec2> hull;
+	glmp::convex_hull(points.data(), points.size(), &hull);
+	assert_convex_hull_of(hull, points);
+}
+
+TEST(hull, convex_hull_parallel) {
+	std::vector<glm::fvec2> points = random_points(300000, 2);
+	// Points on a grid have many collinear hull points.
+	for (int i = 0; i < 1000; ++i)
+		points.emplace_back(static_cast<float>(i % 40) * 10.0f - 200.0f, static_cast<float>(i / 40) * 20.0f - 250.0f);
+
+	std::vector<glm::fvec2> expected;
+	glmp::convex_hull(points.data(), points.size(), &expected);
+	for (unsigned threads : {1u, 3u, 8u}) {
+		glmp::executor pool(threads);
+		std::vector<glm::fvec2> hull;
+		glmp::convex_hull(pool, points.data(), points.size(), &hull);
+		ASSERT_EQ(hull, expected);
+	}
+
+	std::vector<glm::fvec2> small = {{0.0f, 0.0f}, {1.0f, 0.0f}, {0.0f, 1.0f}, {0.2f, 0.2f}};
+	std::vector<glm::fvec2> hull;
+	glmp::convex_hull(glmp::executor::get_default(), small.data(), small.size(), &hull);
+	ASSERT_EQ(hull, (std::vector<glm::fvec2>{{0.0f, 0.0f}, {1.0f, 0.0f}, {0.0f, 1.0f}}));
+}
+
+TEST(hull, incremental_hull) {
+	glmp::incremental_hull h;
+	ASSERT_TRUE(h.insert(glm::fvec2(0.0f, 0.0f)));
+	ASSERT_FALSE(h.insert(glm::fvec2(0.0f, 0.0f)));
+	ASSERT_TRUE(h.insert(glm::fvec2(2.0f, 0.0f)));
+	ASSERT_FALSE(h.insert(glm::fvec2(1.0f, 0.0f)));
+	ASSERT_TRUE(h.insert(glm::fvec2(3.0f, 0.0f)));
+	ASSERT_EQ(h.get_vertices().size(), 2u);
+	ASSERT_TRUE(h.insert(glm::fvec2(0.0f, 3.0f)));
+	ASSERT_TRUE(h.contains(glm::fvec2(1.0f, 1.0f)));
+	ASSERT_TRUE(h.contains(glm::fvec2(1.5f, 1.5f)));
+	ASSERT_FALSE(h.contains(glm::fvec2(2.0f, 2.0f)));
+	// Makes the vertex at (3, 0) collinear.
+	ASSERT_TRUE(h.insert(glm::fvec2(6.0f, 0.0f)));
+	ASSERT_EQ(canonical(h.get_vertices()), (std::vector<glm::fvec2>{{0.0f, 0.0f}, {6.0f, 0.0f}, {0.0f, 3.0f}}));
+}
+
+TEST(hull, incremental_hull_random) {
+	std::vector<glm::fvec2> points = random_points(5000, 3);
+	glmp::incremental_hull h;
+	for (std::size_t i = 0; i < points.size(); i += 500) {
+		h.insert(points.data() + i, 500);
+		std::vector<glm::fvec2> expected;
+		glmp::convex_hull(points.data(), i + 500, &expected);
+		ASSERT_EQ(canonical(h.get_vertices()), expected);
+	}
+	for (glm::fvec2 p : points)
+		ASSERT_TRUE(h.contains(p));
+}
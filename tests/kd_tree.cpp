@@ -0,0 +1,205 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/kd_tree.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "glm_plus/vector.h"
+
+#include "gtest/gtest.h"
+
+namespace glmp = glm_plus;
+
+namespace {
+
+// Random points on a coarse grid, so there are many duplicates and equal distances.
+std::vector<glm::fvec2> random_points(std::size_t count, unsigned seed) {
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<int> coord(-50, 50);
+	std::vector<glm::fvec2> points;
+	for (std::size_t i = 0; i < count; ++i)
+		points.emplace_back(static_cast<float>(coord(rng)) * 0.5f, static_cast<float>(coord(rng)) * 0.25f);
+	return points;
+}
+
+// Closest k points by linear search, with ties broken by index.
+std::vector<glmp::kd_neighbor> linear_k_nearest(const std::vector<glm::fvec2>& points, glm::fvec2 query, std::size_t k) {
+	std::vector<glmp::kd_neighbor> all;
+	for (std::size_t i = 0; i < points.size(); ++i) {
+		glm::fvec2 d = points[i] - query;
+		all.push_back({static_cast<std::uint32_t>(i), d.x * d.x + d.y * d.y});
+	}
+	std::sort(all.begin(), all.end(), [](const glmp::kd_neighbor& a, const glmp::kd_neighbor& b) {
+		return a.distance2 < b.distance2 || (a.distance2 == b.distance2 && a.id < b.id);
+	});
+	all.resize(std::min(k, all.size()));
+	return all;
+}
+
+void assert_same(const glmp::kd_neighbor* a, const glmp::kd_neighbor* b, std::size_t count) {
+	for (std::size_t i = 0; i < count; ++i) {
+		ASSERT_EQ(a[i].id, b[i].id);
+		ASSERT_EQ(a[i].distance2, b[i].distance2);
+	}
+}
+
+}
+
+TEST(kd_tree, nearest) {
+	std::vector<glm::fvec2> points = random_points(2000, 1);
+	std::vector<glm::fvec2> queries = random_points(500, 2);
+	glmp::kd_tree tree;
+	tree.build(points.data(), points.size());
+	ASSERT_EQ(tree.size(), points.size());
+
+	for (glm::fvec2 q : queries) {
+		glmp::kd_neighbor found;
+		ASSERT_TRUE(tree.nearest(q, &found));
+		assert_same(&found, linear_k_nearest(points, q, 1).data(), 1);
+	}
+
+	// Nothing is found far from all points, and the result is left unchanged.
+	glmp::kd_neighbor found = {7, 1.0f};
+	ASSERT_FALSE(tree.nearest(glm::fvec2(100.0f, 100.0f), &found, 10.0f));
+	ASSERT_EQ(found.id, 7u);
+	ASSERT_TRUE(tree.nearest(points[5], &found, 0.0f));
+	ASSERT_EQ(found.distance2, 0.0f);
+	ASSERT_EQ(points[found.id], points[5]);
+	ASSERT_LE(found.id, 5u);
+
+	std::vector<glmp::kd_neighbor> batch(queries.size());
+	tree.nearest(queries.data(), queries.size(), batch.data(), 1.0f);
+	for (std::size_t i = 0; i < queries.size(); ++i) {
+		glmp::kd_neighbor single = {glmp::kd_tree::none, 0.0f};
+		if (tree.nearest(queries[i], &single, 1.0f))
+			assert_same(&batch[i], &single, 1);
+		else
+			ASSERT_EQ(batch[i].id, glmp::kd_tree::none);
+	}
+}
+
+TEST(kd_tree, k_nearest) {
+	std::vector<glm::fvec2> points = random_points(1500, 3);
+	std::vector<glm::fvec2> queries = random_points(200, 4);
+	glmp::kd_tree tree;
+	tree.build(points.data(), points.size());
+
+	std::vector<glmp::kd_neighbor> found;
+	for (glm::fvec2 q : queries) {
+		tree.k_nearest(q, 10, &found);
+		ASSERT_EQ(found.size(), 10u);
+		assert_same(found.data(), linear_k_nearest(points, q, 10).data(), 10);
+	}
+
+	std::vector<glmp::kd_neighbor> batch(queries.size() * 10);
+	tree.k_nearest(queries.data(), queries.size(), 10, batch.data());
+	for (std::size_t i = 0; i < queries.size(); ++i)
+		assert_same(batch.data() + i * 10, linear_k_nearest(points, queries[i], 10).data(), 10);
+
+	// Fewer points than requested.
+	glmp::kd_tree small;
+	small.build(points.data(), 3);
+	small.k_nearest(queries.data(), 1, 5, batch.data());
+	assert_same(batch.data(), linear_k_nearest(std::vector<glm::fvec2>(points.begin(), points.begin() + 3), queries[0], 3).data(), 3);
+	ASSERT_EQ(batch[3].id, glmp::kd_tree::none);
+	ASSERT_EQ(batch[4].id, glmp::kd_tree::none);
+
+	glmp::kd_tree empty;
+	empty.build(points.data(), 0);
+	empty.k_nearest(queries[0], 3, &found);
+	ASSERT_TRUE(found.empty());
+	glmp::kd_neighbor nearest;
+	ASSERT_FALSE(empty.nearest(queries[0], &nearest));
+}
+
+TEST(kd_tree, radius_search) {
+	std::vector<glm::fvec2> points = random_points(3000, 5);
+	std::vector<glm::fvec2> queries = random_points(300, 6);
+	glmp::kd_tree tree;
+	tree.build(points.data(), points.size());
+
+	std::vector<std::uint32_t> offsets;
+	std::vector<std::uint32_t> found;
+	tree.radius_search(queries.data(), queries.size(), 1.5f, &offsets, &found);
+	ASSERT_EQ(offsets.size(), queries.size() + 1);
+	for (std::size_t i = 0; i < queries.size(); ++i) {
+		std::vector<std::uint32_t> expected;
+		for (std::size_t j = 0; j < points.size(); ++j) {
+			if (glmp::is_overlapping(queries[i], points[j], 1.5f))
+				expected.push_back(static_cast<std::uint32_t>(j));
+		}
+		std::vector<std::uint32_t> ids(found.begin() + offsets[i], found.begin() + offsets[i + 1]);
+		std::sort(ids.begin(), ids.end());
+		ASSERT_EQ(ids, expected);
+	}
+
+	// Exact duplicates with the default margin of is_overlapping.
+	std::vector<std::uint32_t> duplicates;
+	tree.radius_search(points[10], glmp::tiny_margin, &duplicates);
+	for (std::uint32_t id : duplicates)
+		ASSERT_EQ(points[id], points[10]);
+	ASSERT_NE(std::find(duplicates.begin(), duplicates.end(), 10u), duplicates.end());
+}
+
+TEST(kd_tree, coincident_points) {
+	// Most points are at a few locations, which merge into single nodes, so queries do not scan all of them.
+	std::vector<glm::fvec2> points(30000, glm::fvec2(1.0f, 2.0f));
+	for (std::size_t i = 0; i < points.size(); i += 3)
+		points[i] = glm::fvec2(-4.0f, 0.5f);
+	std::vector<glm::fvec2> others = random_points(500, 9);
+	points.insert(points.begin() + 2000, others.begin(), others.end());
+	std::vector<glm::fvec2> queries = random_points(300, 10);
+	queries.push_back(glm::fvec2(1.0f, 2.0f));
+	glmp::kd_tree tree;
+	tree.build(points.data(), points.size());
+	ASSERT_EQ(tree.size(), points.size());
+
+	std::vector<glmp::kd_neighbor> batch(queries.size() * 5);
+	tree.nearest(queries.data(), queries.size(), batch.data());
+	for (std::size_t i = 0; i < queries.size(); ++i)
+		assert_same(&batch[i], linear_k_nearest(points, queries[i], 1).data(), 1);
+	tree.k_nearest(queries.data(), queries.size(), 5, batch.data());
+	for (std::size_t i = 0; i < queries.size(); ++i)
+		assert_same(batch.data() + i * 5, linear_k_nearest(points, queries[i], 5).data(), 5);
+
+	std::vector<std::uint32_t> found;
+	tree.radius_search(glm::fvec2(1.0f, 2.0f), 0.0f, &found);
+	std::sort(found.begin(), found.end());
+	std::vector<std::uint32_t> expected;
+	for (std::size_t j = 0; j < points.size(); ++j) {
+		if (points[j] == glm::fvec2(1.0f, 2.0f))
+			expected.push_back(static_cast<std::uint32_t>(j));
+	}
+	ASSERT_EQ(found, expected);
+
+	glmp::executor pool(3);
+	glmp::kd_tree parallel;
+	parallel.build(pool, points.data(), points.size());
+	std::vector<glmp::kd_neighbor> parallel_found(queries.size() * 5);
+	parallel.k_nearest(pool, queries.data(), queries.size(), 5, parallel_found.data());
+	assert_same(parallel_found.data(), batch.data(), batch.size());
+}
+
+TEST(kd_tree, parallel) {
+	std::vector<glm::fvec2> points = random_points(20000, 7);
+	std::vector<glm::fvec2> queries = random_points(5000, 8);
+	glmp::kd_tree serial;
+	serial.build(points.data(), points.size());
+	glmp::executor pool(3);
+	glmp::kd_tree parallel;
+	parallel.build(pool, points.data(), points.size());
+
+	std::vector<glmp::kd_neighbor> expected(queries.size() * 4);
+	std::vector<glmp::kd_neighbor> found(queries.size() * 4);
+	serial.k_nearest(queries.data(), queries.size(), 4, expected.data());
+	parallel.k_nearest(pool, queries.data(), queries.size(), 4, found.data());
+	assert_same(found.data(), expected.data(), found.size());
+
+	serial.nearest(queries.data(), queries.size(), expected.data());
+	parallel.nearest(pool, queries.data(), queries.size(), found.data());
+	assert_same(found.data(), expected.data(), queries.size());
+}
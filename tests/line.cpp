@@ -4,6 +4,8 @@
 
 #include "glm_plus/line.h"
 
+#include <cmath>
+
 #include "gtest/gtest.h"
 #include "assertions.h"
 
@@ -20,6 +22,19 @@ TEST(line, closest_point_on_line) {
 	ASSERT_EQ(glmp::closest_point_on_line(glm::fvec2(4.0f, 3.0f), glm::fvec2(0.0f, 0.0f), glm::fvec2(1.0f, 0.0f)), glm::fvec2(4.0f, 0.0f));
 }
 
+TEST(line, closest_point_on_line_segment) {
+	glm::fvec2 a1(1.0f, 0.0f);
+	glm::fvec2 a2(5.0f, 0.0f);
+	ASSERT_EQ(glmp::closest_param_on_line_segment(glm::fvec2(2.0f, 3.0f), a1, a2), 0.25f);
+	ASSERT_EQ(glmp::closest_point_on_line_segment(glm::fvec2(2.0f, 3.0f), a1, a2), glm::fvec2(2.0f, 0.0f));
+	ASSERT_EQ(glmp::closest_point_on_line_segment(glm::fvec2(-2.0f, 3.0f), a1, a2), a1);
+	ASSERT_EQ(glmp::closest_point_on_line_segment(glm::fvec2(9.0f, -3.0f), a1, a2), a2);
+	ASSERT_EQ(glmp::closest_param_on_line_segment(glm::fvec2(9.0f, -3.0f), a1, a1), 0.0f);
+	ASSERT_EQ(glmp::dist_to_line_segment(glm::fvec2(2.0f, 3.0f), a1, a2), 3.0f);
+	ASSERT_EQ(glmp::dist_to_line_segment(glm::fvec2(8.0f, 4.0f), a1, a2), 5.0f);
+	ASSERT_DOUBLE_EQ(glmp::dist_to_line_segment(glm::dvec2(-2.0, -4.0), glm::dvec2(1.0, 0.0), glm::dvec2(1.0, 0.0)), 5.0);
+}
+
 TEST(line, is_between_two_points) {
 	glm::fvec2 p1(0.0f, 0.0f);
 	glm::fvec2 p2(2.0f, 0.0f);
@@ -102,6 +117,28 @@ TEST(line, line_segments_intersect) {
 	ASSERT_FALSE(glmp::line_segments_intersect(p1, p2, p1, p5, &r));
 }
 
+TEST(line, line_segments_intersect_parametric) {
+	float t;
+	float u;
+	ASSERT_TRUE(glmp::line_segments_intersect_parametric(glm::fvec2(0.0f, 0.0f), glm::fvec2(4.0f, 0.0f), glm::fvec2(1.0f, -1.0f), glm::fvec2(1.0f, 3.0f), &t, &u));
+	ASSERT_EQ(t, 0.25f);
+	ASSERT_EQ(u, 0.25f);
+	ASSERT_TRUE(glmp::line_segments_intersect_parametric(glm::fvec2(0.0f, 0.0f), glm::fvec2(4.0f, 0.0f), glm::fvec2(4.0f, 0.0f), glm::fvec2(5.0f, 3.0f), &t, &u));
+	ASSERT_EQ(t, 1.0f);
+	ASSERT_EQ(u, 0.0f);
+	ASSERT_FALSE(glmp::line_segments_intersect_parametric(glm::fvec2(0.0f, 0.0f), glm::fvec2(4.0f, 0.0f), glm::fvec2(5.0f, -1.0f), glm::fvec2(5.0f, 3.0f), &t, &u));
+	ASSERT_EQ(t, 1.25f);
+	ASSERT_FALSE(glmp::line_segments_intersect_parametric(glm::fvec2(0.0f, 0.0f), glm::fvec2(4.0f, 0.0f), glm::fvec2(1.0f, 1.0f), glm::fvec2(1.0f, 3.0f), &t, &u));
+	ASSERT_FALSE(glmp::line_segments_intersect_parametric(glm::fvec2(0.0f, 0.0f), glm::fvec2(4.0f, 0.0f), glm::fvec2(1.0f, 0.0f), glm::fvec2(3.0f, 0.0f), &t, &u));
+	ASSERT_FALSE(glmp::line_segments_intersect_parametric(glm::fvec2(0.0f, 0.0f), glm::fvec2(4.0f, 0.0f), glm::fvec2(1.0f, 1.0f), glm::fvec2(3.0f, 1.0f), &t, &u));
+
+	double td;
+	double ud;
+	ASSERT_TRUE(glmp::line_segments_intersect_parametric(glm::dvec2(0.0, 0.0), glm::dvec2(2.0, 2.0), glm::dvec2(2.0, 0.0), glm::dvec2(0.0, 2.0), &td, &ud));
+	ASSERT_EQ(td, 0.5);
+	ASSERT_EQ(ud, 0.5);
+}
+
 TEST(line, horizontal_ray_intersect) {
 	glm::fvec2 c(5.0f, 5.0f);
 	
@@ -158,3 +195,222 @@ TEST(line, line_segment_circle_intersect) {
 	ASSERT_FALSE(glmp::line_segment_circle_intersect(c, 2.0f, glm::fvec2(0.0f, 8.0f), glm::fvec2(5.0f, 8.0f), &r));
 	ASSERT_FALSE(glmp::line_segment_circle_intersect(c, 2.0f, glm::fvec2(0.0f, 8.0f), glm::fvec2(2.0f, 10.0f), &r));
 }
+
+TEST(line, moving_circle_line_segment_impact) {
+	glm::fvec2 a1(0.0f, 0.0f);
+	glm::fvec2 a2(10.0f, 0.0f);
+	float t;
+	glm::fvec2 n;
+
+	// Flat side, including a motion fast enough to pass through the segment.
+	ASSERT_TRUE(glmp::moving_circle_line_segment_impact(glm::fvec2(5.0f, 5.0f), 1.0f, glm::fvec2(0.0f, -10.0f), a1, a2, &t, &n));
+	ASSERT_FLOAT_EQ(t, 0.4f);
+	ASSERT_VEC2_EQ(n, 0.0f, 1.0f);
+	ASSERT_TRUE(glmp::moving_circle_line_segment_impact(glm::fvec2(5.0f, -5.0f), 1.0f, glm::fvec2(0.0f, 100.0f), a1, a2, &t, &n));
+	ASSERT_FLOAT_EQ(t, 0.04f);
+	ASSERT_VEC2_EQ(n, 0.0f, -1.0f);
+	ASSERT_FALSE(glmp::moving_circle_line_segment_impact(glm::fvec2(5.0f, 5.0f), 1.0f, glm::fvec2(0.0f, -3.0f), a1, a2, &t, &n));
+	ASSERT_FALSE(glmp::moving_circle_line_segment_impact(glm::fvec2(5.0f, 5.0f), 1.0f, glm::fvec2(0.0f, 10.0f), a1, a2, &t, &n));
+
+	// Rounded end.
+	ASSERT_TRUE(glmp::moving_circle_line_segment_impact(glm::fvec2(-5.0f, 0.5f), 1.0f, glm::fvec2(10.0f, 0.0f), a1, a2, &t, &n));
+	ASSERT_NEAR(t, (5.0f - std::sqrt(0.75f)) / 10.0f, 1.0e-6f);
+	ASSERT_NEAR(n.x, -std::sqrt(0.75f), 1.0e-6f);
+	ASSERT_NEAR(n.y, 0.5f, 1.0e-6f);
+	ASSERT_FALSE(glmp::moving_circle_line_segment_impact(glm::fvec2(-5.0f, 1.5f), 1.0f, glm::fvec2(10.0f, 0.0f), a1, a2, &t, &n));
+
+	// Already touching.
+	ASSERT_TRUE(glmp::moving_circle_line_segment_impact(glm::fvec2(5.0f, 0.5f), 1.0f, glm::fvec2(0.0f, -1.0f), a1, a2, &t, &n));
+	ASSERT_EQ(t, 0.0f);
+	ASSERT_VEC2_EQ(n, 0.0f, 1.0f);
+	ASSERT_FALSE(glmp::moving_circle_line_segment_impact(glm::fvec2(5.0f, 0.5f), 1.0f, glm::fvec2(0.0f, 1.0f), a1, a2, &t, &n));
+	ASSERT_FALSE(glmp::moving_circle_line_segment_impact(glm::fvec2(5.0f, 1.0f), 1.0f, glm::fvec2(1.0f, 0.0f), a1, a2, &t, &n));
+
+	// Center on the segment.
+	ASSERT_TRUE(glmp::moving_circle_line_segment_impact(glm::fvec2(5.0f, 0.0f), 1.0f, glm::fvec2(0.0f, 1.0f), a1, a2, &t, &n));
+	ASSERT_EQ(t, 0.0f);
+	ASSERT_VEC2_EQ(n, 0.0f, -1.0f);
+	ASSERT_TRUE(glmp::moving_circle_line_segment_impact(a2, 1.0f, glm::fvec2(0.0f, 0.0f), a1, a2, &t, &n));
+	ASSERT_EQ(t, 0.0f);
+	ASSERT_FLOAT_EQ(glm::length(n), 1.0f);
+	ASSERT_TRUE(glmp::moving_circle_line_segment_impact(a1, 1.0f, glm::fvec2(0.0f, 0.0f), a1, a1, &t, &n));
+	ASSERT_EQ(t, 0.0f);
+	ASSERT_FLOAT_EQ(glm::length(n), 1.0f);
+
+	// Zero-length segment behaves like a point.
+	ASSERT_TRUE(glmp::moving_circle_line_segment_impact(glm::fvec2(-4.0f, 0.0f), 2.0f, glm::fvec2(4.0f, 0.0f), a1, a1, &t, &n));
+	ASSERT_FLOAT_EQ(t, 0.5f);
+	ASSERT_VEC2_EQ(n, -1.0f, 0.0f);
+
+	double td;
+	glm::dvec2 nd;
+	ASSERT_TRUE(glmp::moving_circle_line_segment_impact(glm::dvec2(5.0, 5.0), 1.0, glm::dvec2(0.0, -10.0), glm::dvec2(0.0, 0.0), glm::dvec2(10.0, 0.0), &td, &nd));
+	ASSERT_DOUBLE_EQ(td, 0.4);
+}
+
+TEST(line, moving_circles_impact) {
+	float t;
+	glm::fvec2 n;
+	ASSERT_TRUE(glmp::moving_circles_impact(glm::fvec2(0.0f, 0.0f), 1.0f, glm::fvec2(10.0f, 0.0f), glm::fvec2(5.0f, 0.0f), 1.0f, glm::fvec2(0.0f), &t, &n));
+	ASSERT_FLOAT_EQ(t, 0.3f);
+	ASSERT_VEC2_EQ(n, -1.0f, 0.0f);
+	ASSERT_TRUE(glmp::moving_circles_impact(glm::fvec2(0.0f, 0.0f), 1.0f, glm::fvec2(10.0f, 0.0f),
+		glm::fvec2(5.0f, 0.0f), 1.0f, glm::fvec2(-10.0f, 0.0f), &t, &n));
+	ASSERT_FLOAT_EQ(t, 0.15f);
+	ASSERT_FALSE(glmp::moving_circles_impact(glm::fvec2(0.0f, 0.0f), 1.0f, glm::fvec2(10.0f, 0.0f), glm::fvec2(5.0f, 3.0f), 1.0f, glm::fvec2(0.0f), &t, &n));
+	ASSERT_FALSE(glmp::moving_circles_impact(glm::fvec2(0.0f, 0.0f), 1.0f, glm::fvec2(2.0f, 0.0f), glm::fvec2(5.0f, 0.0f), 1.0f, glm::fvec2(0.0f), &t, &n));
+
+	// Already touching.
+	ASSERT_TRUE(glmp::moving_circles_impact(glm::fvec2(0.0f, 0.0f), 1.0f, glm::fvec2(1.0f, 0.0f), glm::fvec2(2.0f, 0.0f), 1.0f, glm::fvec2(0.0f), &t, &n));
+	ASSERT_EQ(t, 0.0f);
+	ASSERT_VEC2_EQ(n, -1.0f, 0.0f);
+	ASSERT_FALSE(glmp::moving_circles_impact(glm::fvec2(0.0f, 0.0f), 1.0f, glm::fvec2(-1.0f, 0.0f), glm::fvec2(2.0f, 0.0f), 1.0f, glm::fvec2(0.0f), &t, &n));
+	ASSERT_FALSE(glmp::moving_circles_impact(glm::fvec2(0.0f, 0.0f), 1.0f, glm::fvec2(1.0f, 0.0f), glm::fvec2(2.0f, 0.0f), 1.0f, glm::fvec2(1.0f, 0.0f), &t, &n));
+}
+
+TEST(line, moving_line_segment_impact) {
+	glm::fvec2 a1(0.0f, -1.0f);
+	glm::fvec2 a2(0.0f, 1.0f);
+	float t;
+	glm::fvec2 n;
+
+	// End points of the moving segment hit the static one.
+	ASSERT_TRUE(glmp::moving_line_segment_impact(a1, a2, glm::fvec2(10.0f, 0.0f), glm::fvec2(5.0f, -2.0f), glm::fvec2(5.0f, 2.0f), &t, &n));
+	ASSERT_FLOAT_EQ(t, 0.5f);
+	ASSERT_VEC2_EQ(n, -1.0f, 0.0f);
+
+	// End points of the static segment hit the moving one.
+	ASSERT_TRUE(glmp::moving_line_segment_impact(a1, a2, glm::fvec2(10.0f, 0.0f), glm::fvec2(5.0f, -0.5f), glm::fvec2(6.0f, 0.5f), &t, &n));
+	ASSERT_FLOAT_EQ(t, 0.5f);
+	ASSERT_VEC2_EQ(n, -1.0f, 0.0f);
+
+	// A thin wall, which would be skipped by a static test at the end of the motion.
+	ASSERT_TRUE(glmp::moving_line_segment_impact(glm::fvec2(-1.0f, 0.0f), glm::fvec2(1.0f, 0.0f), glm::fvec2(0.0f, 10.0f),
+		glm::fvec2(5.0f, 5.0f), glm::fvec2(-5.0f, 5.0f), &t, &n));
+	ASSERT_FLOAT_EQ(t, 0.5f);
+	ASSERT_VEC2_EQ(n, 0.0f, -1.0f);
+
+	// Collinear segments.
+	ASSERT_TRUE(glmp::moving_line_segment_impact(glm::fvec2(0.0f, 0.0f), glm::fvec2(1.0f, 0.0f), glm::fvec2(10.0f, 0.0f),
+		glm::fvec2(5.0f, 0.0f), glm::fvec2(6.0f, 0.0f), &t, &n));
+	ASSERT_FLOAT_EQ(t, 0.4f);
+	ASSERT_VEC2_EQ(n, -1.0f, 0.0f);
+
+	// Already crossing.
+	ASSERT_TRUE(glmp::moving_line_segment_impact(a1, a2, glm::fvec2(10.0f, 0.0f), glm::fvec2(-1.0f, 0.0f), glm::fvec2(1.0f, 0.5f), &t, &n));
+	ASSERT_EQ(t, 0.0f);
+
+	ASSERT_FALSE(glmp::moving_line_segment_impact(a1, a2, glm::fvec2(4.0f, 0.0f), glm::fvec2(5.0f, -2.0f), glm::fvec2(5.0f, 2.0f), &t, &n));
+	ASSERT_FALSE(glmp::moving_line_segment_impact(a1, a2, glm::fvec2(10.0f, 0.0f), glm::fvec2(5.0f, 2.0f), glm::fvec2(6.0f, 2.0f), &t, &n));
+}
+
+TEST(line, line2) {
+	glmp::fline2 line(glm::fvec2(1.0f, 1.0f), glm::fvec2(4.0f, 5.0f));
+	ASSERT_VEC2_EQ(line.delta, 3.0f, 4.0f);
+	ASSERT_EQ(line.length, 5.0f);
+	ASSERT_EQ(line.length2, 25.0f);
+	ASSERT_FLOAT_EQ(line.direction.x, 0.6f);
+	ASSERT_FLOAT_EQ(line.direction.y, 0.8f);
+
+	glm::fvec2 r1;
+	glm::fvec2 r2;
+	float t1;
+	float t2;
+	glm::fvec2 n1;
+	glm::fvec2 n2;
+	for (int i = 0; i < 50; ++i) {
+		glm::fvec2 x(static_cast<float>(i % 7) * 1.3f - 3.0f, static_cast<float>(i % 11) * 0.9f - 2.0f);
+		ASSERT_NEAR(glmp::dist_to_line_signed(x, line), glmp::dist_to_line_signed(x, line.p1, line.p2), 1.0e-5f);
+		ASSERT_NEAR(glm::distance(glmp::closest_point_on_line(x, line), glmp::closest_point_on_line(x, line.p1, line.p2)), 0.0f, 1.0e-5f);
+		ASSERT_EQ(glmp::is_right_of_line_with_margin(x, line, 0.5f), glmp::is_right_of_line_with_margin(x, line.p1, line.p2, 0.5f));
+
+		// Overloads, which have no square root to avoid, give the same results.
+		ASSERT_EQ(glmp::closest_param_on_line_segment(x, line), glmp::closest_param_on_line_segment(x, line.p1, line.p2));
+		ASSERT_EQ(glmp::closest_point_on_line_segment(x, line), glmp::closest_point_on_line_segment(x, line.p1, line.p2));
+		ASSERT_EQ(glmp::dist_to_line_segment(x, line), glmp::dist_to_line_segment(x, line.p1, line.p2));
+		ASSERT_EQ(glmp::is_right_of_line(x, line), glmp::is_right_of_line(x, line.p1, line.p2));
+		ASSERT_EQ(glmp::is_between_two_points(x, line), glmp::is_between_two_points(x, line.p1, line.p2));
+		ASSERT_EQ(glmp::horizontal_ray_line_segment_intersect(x, line), glmp::horizontal_ray_line_segment_intersect(x, line.p1, line.p2));
+
+		glmp::fline2 other(x, glm::fvec2(2.0f, -1.0f));
+		bool hit = glmp::line_segments_intersect(line, other, &r1);
+		ASSERT_EQ(hit, glmp::line_segments_intersect(line.p1, line.p2, other.p1, other.p2, &r2));
+		if (hit) {
+			ASSERT_EQ(r1, r2);
+		}
+		ASSERT_EQ(glmp::line_segments_intersect_parametric(line, other, &t1, &t2),
+			glmp::line_segments_intersect_parametric(line.p1, line.p2, other.p1, other.p2, &t1, &t2));
+		ASSERT_EQ(glmp::line_segments_coincide(line, other), glmp::line_segments_coincide(line.p1, line.p2, other.p1, other.p2));
+
+		hit = glmp::line_segment_circle_intersect(x, 1.5f, line, &r1);
+		ASSERT_EQ(hit, glmp::line_segment_circle_intersect(x, 1.5f, line.p1, line.p2, &r2));
+		if (hit) {
+			ASSERT_NEAR(glm::distance(r1, r2), 0.0f, 1.0e-5f);
+		}
+
+		glm::fvec2 velocity(3.0f - static_cast<float>(i % 5), 2.0f - static_cast<float>(i % 4));
+		hit = glmp::moving_circle_line_segment_impact(x, 0.5f, velocity, line, &t1, &n1);
+		ASSERT_EQ(hit, glmp::moving_circle_line_segment_impact(x, 0.5f, velocity, line.p1, line.p2, &t2, &n2));
+		if (hit) {
+			ASSERT_EQ(t1, t2);
+			ASSERT_EQ(n1, n2);
+		}
+	}
+
+	ASSERT_TRUE(glmp::lines_intersect(line, glmp::fline2(glm::fvec2(1.0f, 5.0f), glm::fvec2(4.0f, 1.0f)), &r1));
+	ASSERT_VEC2_EQ(r1, 2.5f, 3.0f);
+	ASSERT_TRUE(glmp::lines_coincide(line, glmp::fline2(glm::fvec2(7.0f, 9.0f), glm::fvec2(10.0f, 13.0f))));
+
+	// Equal points have no direction.
+	glmp::fline2 point(glm::fvec2(2.0f, 3.0f), glm::fvec2(2.0f, 3.0f));
+	ASSERT_VEC2_EQ(point.direction, 0.0f, 0.0f);
+	ASSERT_EQ(glmp::closest_param_on_line_segment(glm::fvec2(5.0f, 3.0f), point), 0.0f);
+	ASSERT_EQ(glmp::dist_to_line_segment(glm::fvec2(5.0f, 7.0f), point), 5.0f);
+	ASSERT_FALSE(glmp::line_circle_intersect(glm::fvec2(2.0f, 3.0f), 1.0f, point, &r1));
+
+	glmp::dline2 dline(glm::dvec2(500000.25, 4000000.5), glm::dvec2(500010.25, 4000010.5));
+	ASSERT_NEAR(glmp::dist_to_line_signed(glm::dvec2(500000.25, 4000000.5 + 1.0e-6), dline), -1.0e-6 * std::sqrt(0.5), 1.0e-9);
+}
+
+TEST(line, double_precision) {
+	// Projected coordinates in meters, where float can not represent the fractional part.
+	glm::dvec2 a1(500000.25, 4000000.5);
+	glm::dvec2 a2(500010.25, 4000010.5);
+	glm::dvec2 b1(500000.25, 4000010.5);
+	glm::dvec2 b2(500010.25, 4000000.5);
+	glm::dvec2 r;
+
+	ASSERT_TRUE(glmp::lines_intersect(a1, a2, b1, b2, &r));
+	ASSERT_VEC2_EQ(r, 500005.25, 4000005.5);
+	ASSERT_TRUE(glmp::line_segments_intersect(a1, a2, b1, b2, &r));
+	ASSERT_TRUE(glmp::is_right_of_line(b1, a1, a2));
+	ASSERT_FALSE(glmp::is_right_of_line(b2, a1, a2));
+	ASSERT_NEAR(glmp::dist_to_line_signed(glm::dvec2(500000.25, 4000000.5 + 1.0e-6), a1, a2), -1.0e-6 * std::sqrt(0.5), 1.0e-9);
+
+	// Default margin is scaled to double precision.
+	ASSERT_TRUE(glmp::lines_coincide(a1, a2, a1 + glm::dvec2(1.0, 1.0), a2 + glm::dvec2(2.0, 2.0)));
+	ASSERT_FALSE(glmp::lines_coincide(a1, a2, a1 + glm::dvec2(1.0, 1.0), a2 + glm::dvec2(2.0, 2.0 + 1.0e-9)));
+	ASSERT_TRUE(glmp::lines_coincide(a1, a2, a1 + glm::dvec2(1.0, 1.0), a2 + glm::dvec2(2.0, 2.0 + 1.0e-9), 1.0e-5));
+	ASSERT_TRUE(glmp::is_right_of_line_with_margin(b1, a1, a2, 1));
+}
+
+#ifdef GLM_PLUS_HEADER_ONLY
+namespace {
+
+constexpr glm::fvec2 constexpr_intersection() {
+	glm::fvec2 r(0.0f, 0.0f);
+	glmp::line_segments_intersect(glm::fvec2(0.0f, 0.0f), glm::fvec2(2.0f, 2.0f), glm::fvec2(0.0f, 2.0f), glm::fvec2(2.0f, 0.0f), &r);
+	return r;
+}
+
+}
+
+TEST(line, constexpr_header_only) {
+	static_assert(!glmp::is_right_of_line(glm::fvec2(1.0f, -1.0f), glm::fvec2(0.0f, 0.0f), glm::fvec2(1.0f, 0.0f)), "");
+	static_assert(glmp::is_between_two_points(glm::fvec2(1.0f, 10.0f), glm::fvec2(0.0f, 0.0f), glm::fvec2(2.0f, 0.0f)), "");
+	static_assert(glmp::horizontal_ray_line_segment_intersect(glm::fvec2(0.0f, 1.0f), glm::fvec2(2.0f, 0.0f), glm::fvec2(2.0f, 2.0f)), "");
+	static_assert(glmp::lines_coincide(glm::fvec2(0.0f, 0.0f), glm::fvec2(1.0f, 1.0f), glm::fvec2(2.0f, 2.0f), glm::fvec2(3.0f, 3.0f)), "");
+	static_assert(constexpr_intersection().x == 1.0f && constexpr_intersection().y == 1.0f, "");
+	ASSERT_VEC2_EQ(constexpr_intersection(), 1.0f, 1.0f);
+}
+#endif
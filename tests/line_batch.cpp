@@ -0,0 +1,453 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/line_batch.h"
+#include "glm_plus/line.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace glmp = glm_plus;
+
+TEST(line_batch, dist_to_line_signed) {
+	float xs[] = {2.0f, 2.0f, -7.0f};
+	float ys[] = {5.0f, -3.0f, 0.0f};
+	float r[3];
+	glmp::dist_to_line_signed(xs, ys, 3, glm::fvec2(0.0f, 0.0f), glm::fvec2(1.0f, 0.0f), r);
+	ASSERT_EQ(r[0], -5.0f);
+	ASSERT_EQ(r[1], 3.0f);
+	ASSERT_EQ(r[2], 0.0f);
+}
+
+TEST(line_batch, dist_to_line_signed_matches_scalar) {
+	glm::fvec2 a1(1.5f, -2.0f);
+	glm::fvec2 a2(-3.0f, 4.25f);
+	std::vector<float> xs;
+	std::vector<float> ys;
+	for (int i = 0; i < 100; ++i) {
+		xs.push_back(static_cast<float>(i % 13) - 6.5f);
+		ys.push_back(static_cast<float>(i % 7) * 1.5f - 4.0f);
+	}
+
+	std::vector<float> r(xs.size());
+	glmp::dist_to_line_signed(xs.data(), ys.data(), xs.size(), a1, a2, r.data());
+	for (std::size_t i = 0; i < xs.size(); ++i)
+		ASSERT_NEAR(r[i], glmp::dist_to_line_signed(glm::fvec2(xs[i], ys[i]), a1, a2), 1.0e-5f);
+}
+
+TEST(line_batch, is_right_of_line) {
+	glm::fvec2 a1(0.0f, 0.0f);
+	glm::fvec2 a2(1.0f, 1.0f);
+	std::vector<float> xs;
+	std::vector<float> ys;
+	for (int i = 0; i < 70; ++i) {
+		xs.push_back(static_cast<float>(i % 5));
+		ys.push_back(static_cast<float>(i % 9));
+	}
+
+	std::vector<std::uint32_t> mask(glmp::mask_words(xs.size()), 0xffffffffu);
+	glmp::is_right_of_line(xs.data(), ys.data(), xs.size(), a1, a2, mask.data());
+	ASSERT_EQ(mask.size(), 3u);
+	for (std::size_t i = 0; i < xs.size(); ++i)
+		ASSERT_EQ(glmp::mask_test(mask.data(), i), glmp::is_right_of_line(glm::fvec2(xs[i], ys[i]), a1, a2));
+	ASSERT_EQ(mask[2] >> 6, 0u);
+}
+
+TEST(line_batch, line_segments_intersect) {
+	glm::fvec2 a1(-1.0f, 0.5f);
+	glm::fvec2 a2(9.0f, 3.0f);
+	std::vector<float> x1s;
+	std::vector<float> y1s;
+	std::vector<float> x2s;
+	std::vector<float> y2s;
+	for (int i = 0; i < 75; ++i) {
+		x1s.push_back(static_cast<float>(i % 11) - 2.0f);
+		y1s.push_back(static_cast<float>(i % 5) - 1.0f);
+		x2s.push_back(static_cast<float>(i % 7) * 1.5f - 1.0f);
+		y2s.push_back(static_cast<float>(i % 3) * 2.0f);
+	}
+
+	std::vector<std::uint32_t> hits(x1s.size());
+	std::vector<float> ts(x1s.size());
+	std::size_t n = glmp::line_segments_intersect(a1, a2, x1s.data(), y1s.data(), x2s.data(), y2s.data(), x1s.size(), hits.data(), ts.data());
+
+	std::size_t expected = 0;
+	for (std::size_t i = 0; i < x1s.size(); ++i) {
+		float t;
+		float u;
+		if (!glmp::line_segments_intersect_parametric(a1, a2, glm::fvec2(x1s[i], y1s[i]), glm::fvec2(x2s[i], y2s[i]), &t, &u))
+			continue;
+		ASSERT_LT(expected, n);
+		ASSERT_EQ(hits[expected], i);
+		ASSERT_EQ(ts[expected], t);
+		++expected;
+	}
+	ASSERT_EQ(n, expected);
+	ASSERT_GT(n, 10u);
+}
+
+TEST(line_batch, line_segment_circle_intersect_first_hit) {
+	float cxs[] = {10.0f, 7.0f, 6.0f, 0.0f, 20.0f};
+	float cys[] = {0.0f, 1.0f, 0.0f, 0.0f, 0.0f};
+	float rs[] = {1.0f, 2.0f, 2.0f, 1.0f, 1.0f};
+	glm::fvec2 a1(0.0f, 0.0f);
+	glm::fvec2 a2(16.0f, 0.0f);
+
+	std::uint32_t index;
+	float t;
+	glm::fvec2 entry;
+	glm::fvec2 exit;
+	// Circle 3 contains the segment start, so it is not hit. Circle 4 is past the segment end.
+	ASSERT_TRUE(glmp::line_segment_circle_intersect(cxs, cys, rs, 5, a1, a2, &index, &t, &entry, &exit));
+	ASSERT_EQ(index, 2u);
+	ASSERT_EQ(t, 0.25f);
+	ASSERT_EQ(entry, glm::fvec2(4.0f, 0.0f));
+	ASSERT_EQ(exit, glm::fvec2(8.0f, 0.0f));
+
+	ASSERT_TRUE(glmp::line_segment_circle_intersect(cxs, cys, rs, 2, a1, a2, &index, &t));
+	ASSERT_EQ(index, 1u);
+	ASSERT_NEAR(t, (7.0f - std::sqrt(3.0f)) / 16.0f, 1.0e-6f);
+	ASSERT_FALSE(glmp::line_segment_circle_intersect(cxs + 3, cys + 3, rs + 3, 2, a1, a2, &index, &t));
+}
+
+TEST(line_batch, line_segment_circle_intersect_matches_scalar) {
+	std::vector<float> cxs;
+	std::vector<float> cys;
+	std::vector<float> rs;
+	for (int i = 0; i < 100; ++i) {
+		cxs.push_back(static_cast<float>(i % 17) - 8.25f);
+		cys.push_back(static_cast<float>(i % 13) * 0.75f - 4.5f);
+		rs.push_back(static_cast<float>(i % 5) * 0.5f + 0.3f);
+	}
+
+	for (int k = 0; k < 20; ++k) {
+		glm::fvec2 a1(static_cast<float>(k % 7) - 9.5f, static_cast<float>(k % 3) * 2.0f - 2.5f);
+		glm::fvec2 a2(static_cast<float>(k % 5) + 4.5f, static_cast<float>(k % 4) * 1.5f - 2.0f);
+
+		// Circle vs many segments of the same shape, shifted by the circle offsets.
+		std::vector<float> x1s;
+		std::vector<float> y1s;
+		std::vector<float> x2s;
+		std::vector<float> y2s;
+		bool any = false;
+		std::uint32_t first = 0;
+		float first_t = 0.0f;
+		for (std::size_t i = 0; i < cxs.size(); ++i) {
+			glm::fvec2 c(cxs[i], cys[i]);
+			glm::fvec2 hit(0.0f);
+			bool scalar = glmp::line_segment_circle_intersect(c, rs[i], a1, a2, &hit);
+			float t = glm::length(hit - a1) / glm::length(a2 - a1);
+			if (scalar && (!any || t < first_t)) {
+				any = true;
+				first = static_cast<std::uint32_t>(i);
+				first_t = t;
+			}
+			x1s.push_back(a1.x - c.x);
+			y1s.push_back(a1.y - c.y);
+			x2s.push_back(a2.x - c.x);
+			y2s.push_back(a2.y - c.y);
+		}
+
+		std::uint32_t index = 0;
+		float t = 0.0f;
+		ASSERT_EQ(glmp::line_segment_circle_intersect(cxs.data(), cys.data(), rs.data(), cxs.size(), a1, a2, &index, &t), any);
+		if (any) {
+			ASSERT_EQ(index, first);
+			ASSERT_NEAR(t, first_t, 1.0e-5f);
+		}
+
+		// All segments against a unit circle at the origin.
+		std::vector<std::uint32_t> hits(x1s.size());
+		std::vector<float> ts(x1s.size());
+		std::vector<float> t_exits(x1s.size());
+		std::size_t n = glmp::line_segment_circle_intersect(glm::fvec2(0.0f, 0.0f), 1.0f, x1s.data(), y1s.data(), x2s.data(), y2s.data(), x1s.size(),
+			hits.data(), ts.data(), t_exits.data());
+		std::size_t expected = 0;
+		for (std::size_t i = 0; i < x1s.size(); ++i) {
+			glm::fvec2 p1(x1s[i], y1s[i]);
+			glm::fvec2 p2(x2s[i], y2s[i]);
+			glm::fvec2 hit;
+			if (!glmp::line_segment_circle_intersect(glm::fvec2(0.0f, 0.0f), 1.0f, p1, p2, &hit))
+				continue;
+			ASSERT_LT(expected, n);
+			ASSERT_EQ(hits[expected], i);
+			glm::fvec2 entry = p1 + (p2 - p1) * ts[expected];
+			glm::fvec2 exit = p1 + (p2 - p1) * t_exits[expected];
+			ASSERT_NEAR(entry.x, hit.x, 1.0e-4f);
+			ASSERT_NEAR(entry.y, hit.y, 1.0e-4f);
+			ASSERT_NEAR(glm::length(exit), 1.0f, 1.0e-4f);
+			++expected;
+		}
+		ASSERT_EQ(n, expected);
+	}
+}
+TEST(line_batch, closest_line_segment) {
+	std::vector<float> x1s;
+	std::vector<float> y1s;
+	std::vector<float> x2s;
+	std::vector<float> y2s;
+	for (int i = 0; i < 100; ++i) {
+		x1s.push_back(static_cast<float>(i % 17) - 8.25f);
+		y1s.push_back(static_cast<float>(i % 13) * 0.75f - 4.5f);
+		// Every fifth segment has zero length.
+		x2s.push_back(x1s.back() + static_cast<float>(i % 5) * 0.5f);
+		y2s.push_back(y1s.back() - static_cast<float>(i % 5) * 0.3f);
+	}
+
+	for (int k = 0; k < 40; ++k) {
+		glm::fvec2 x(static_cast<float>(k % 7) * 1.7f - 6.0f, static_cast<float>(k % 9) * 1.3f - 5.0f);
+		std::uint32_t expected = 0;
+		float expected_d2 = 0.0f;
+		for (std::size_t i = 0; i < x1s.size(); ++i) {
+			glm::fvec2 p = glmp::closest_point_on_line_segment(x, glm::fvec2(x1s[i], y1s[i]), glm::fvec2(x2s[i], y2s[i]));
+			float d2 = (x.x - p.x) * (x.x - p.x) + (x.y - p.y) * (x.y - p.y);
+			if (i == 0 || d2 < expected_d2) {
+				expected = static_cast<std::uint32_t>(i);
+				expected_d2 = d2;
+			}
+		}
+
+		std::uint32_t index;
+		float t;
+		float d2;
+		ASSERT_TRUE(glmp::closest_line_segment(x, x1s.data(), y1s.data(), x2s.data(), y2s.data(), x1s.size(), &index, &t, &d2));
+		ASSERT_EQ(index, expected);
+		ASSERT_EQ(d2, expected_d2);
+		ASSERT_EQ(t, glmp::closest_param_on_line_segment(x, glm::fvec2(x1s[index], y1s[index]), glm::fvec2(x2s[index], y2s[index])));
+	}
+
+	std::uint32_t index = 7;
+	float t;
+	float d2;
+	ASSERT_FALSE(glmp::closest_line_segment(glm::fvec2(0.0f), x1s.data(), y1s.data(), x2s.data(), y2s.data(), 0, &index, &t, &d2));
+	ASSERT_EQ(index, 7u);
+}
+
+namespace {
+
+struct segment_soa {
+	std::vector<float> x1s;
+	std::vector<float> y1s;
+	std::vector<float> x2s;
+	std::vector<float> y2s;
+};
+
+// Short segments scattered in a grid, some with zero length.
+segment_soa make_walls() {
+	segment_soa walls;
+	for (int i = 0; i < 150; ++i) {
+		walls.x1s.push_back(static_cast<float>(i % 17) * 1.5f - 12.0f);
+		walls.y1s.push_back(static_cast<float>(i % 11) * 1.25f - 6.5f);
+		walls.x2s.push_back(walls.x1s.back() + static_cast<float>(i % 5) * 0.4f);
+		walls.y2s.push_back(walls.y1s.back() + static_cast<float>(i % 3) * 0.7f - 0.7f);
+	}
+	return walls;
+}
+
+}
+
+TEST(line_batch, moving_circle_line_segment_impact) {
+	segment_soa walls = make_walls();
+	int hits = 0;
+	for (int k = 0; k < 60; ++k) {
+		glm::fvec2 center(static_cast<float>(k % 7) * 3.1f - 10.0f, static_cast<float>(k % 5) * 2.9f - 6.0f);
+		glm::fvec2 velocity(static_cast<float>(k % 9) * 1.3f - 5.0f, static_cast<float>(k % 4) * 2.1f - 3.0f);
+		float r = 0.1f + static_cast<float>(k % 3) * 0.2f;
+
+		bool expected = false;
+		std::uint32_t expected_index = 0;
+		float expected_t = 0.0f;
+		glm::fvec2 expected_normal;
+		for (std::size_t i = 0; i < walls.x1s.size(); ++i) {
+			float ti;
+			glm::fvec2 ni;
+			if (glmp::moving_circle_line_segment_impact(center, r, velocity, glm::fvec2(walls.x1s[i], walls.y1s[i]),
+					glm::fvec2(walls.x2s[i], walls.y2s[i]), &ti, &ni) && (!expected || ti < expected_t)) {
+				expected = true;
+				expected_index = static_cast<std::uint32_t>(i);
+				expected_t = ti;
+				expected_normal = ni;
+			}
+		}
+
+		std::uint32_t index;
+		float t;
+		glm::fvec2 n;
+		ASSERT_EQ(glmp::moving_circle_line_segment_impact(center, r, velocity, walls.x1s.data(), walls.y1s.data(), walls.x2s.data(), walls.y2s.data(),
+			walls.x1s.size(), &index, &t, &n), expected);
+		if (expected) {
+			ASSERT_EQ(index, expected_index);
+			ASSERT_EQ(t, expected_t);
+			ASSERT_EQ(n, expected_normal);
+			++hits;
+		}
+	}
+	ASSERT_GT(hits, 20);
+}
+
+TEST(line_batch, moving_circles_impact) {
+	std::vector<float> cxs;
+	std::vector<float> cys;
+	std::vector<float> rs;
+	std::vector<float> vxs;
+	std::vector<float> vys;
+	for (int i = 0; i < 100; ++i) {
+		cxs.push_back(static_cast<float>(i % 13) * 1.7f - 10.0f);
+		cys.push_back(static_cast<float>(i % 7) * 1.9f - 6.0f);
+		rs.push_back(0.2f + static_cast<float>(i % 4) * 0.1f);
+		vxs.push_back(static_cast<float>(i % 5) - 2.0f);
+		vys.push_back(static_cast<float>(i % 3) - 1.0f);
+	}
+
+	int hits = 0;
+	for (int k = 0; k < 60; ++k) {
+		glm::fvec2 center(static_cast<float>(k % 7) * 3.1f - 10.0f, static_cast<float>(k % 5) * 2.9f - 6.0f);
+		glm::fvec2 velocity(static_cast<float>(k % 9) * 1.3f - 5.0f, static_cast<float>(k % 4) * 2.1f - 3.0f);
+		for (bool moving : {false, true}) {
+			bool expected = false;
+			std::uint32_t expected_index = 0;
+			float expected_t = 0.0f;
+			for (std::size_t i = 0; i < cxs.size(); ++i) {
+				float ti;
+				glm::fvec2 ni;
+				glm::fvec2 vi = moving ? glm::fvec2(vxs[i], vys[i]) : glm::fvec2(0.0f);
+				if (glmp::moving_circles_impact(center, 0.5f, velocity, glm::fvec2(cxs[i], cys[i]), rs[i], vi, &ti, &ni)
+						&& (!expected || ti < expected_t)) {
+					expected = true;
+					expected_index = static_cast<std::uint32_t>(i);
+					expected_t = ti;
+				}
+			}
+
+			std::uint32_t index;
+			float t;
+			glm::fvec2 n;
+			ASSERT_EQ(glmp::moving_circles_impact(center, 0.5f, velocity, cxs.data(), cys.data(), rs.data(),
+				moving ? vxs.data() : nullptr, moving ? vys.data() : nullptr, cxs.size(), &index, &t, &n), expected);
+			if (expected) {
+				ASSERT_EQ(index, expected_index);
+				ASSERT_EQ(t, expected_t);
+				++hits;
+			}
+		}
+	}
+	ASSERT_GT(hits, 20);
+}
+
+TEST(line_batch, moving_line_segment_impact) {
+	segment_soa walls = make_walls();
+	int hits = 0;
+	for (int k = 0; k < 60; ++k) {
+		glm::fvec2 a1(static_cast<float>(k % 7) * 3.1f - 10.0f, static_cast<float>(k % 5) * 2.9f - 6.0f);
+		glm::fvec2 a2 = a1 + glm::fvec2(static_cast<float>(k % 3) * 0.3f, 0.4f - static_cast<float>(k % 4) * 0.2f);
+		glm::fvec2 velocity(static_cast<float>(k % 9) * 1.3f - 5.0f, static_cast<float>(k % 4) * 2.1f - 3.0f);
+
+		bool expected = false;
+		std::uint32_t expected_index = 0;
+		float expected_t = 0.0f;
+		glm::fvec2 expected_normal;
+		for (std::size_t i = 0; i < walls.x1s.size(); ++i) {
+			float ti;
+			glm::fvec2 ni;
+			if (glmp::moving_line_segment_impact(a1, a2, velocity, glm::fvec2(walls.x1s[i], walls.y1s[i]),
+					glm::fvec2(walls.x2s[i], walls.y2s[i]), &ti, &ni) && (!expected || ti < expected_t)) {
+				expected = true;
+				expected_index = static_cast<std::uint32_t>(i);
+				expected_t = ti;
+				expected_normal = ni;
+			}
+		}
+
+		std::uint32_t index;
+		float t;
+		glm::fvec2 n;
+		ASSERT_EQ(glmp::moving_line_segment_impact(a1, a2, velocity, walls.x1s.data(), walls.y1s.data(), walls.x2s.data(), walls.y2s.data(),
+			walls.x1s.size(), &index, &t, &n), expected);
+		if (expected) {
+			ASSERT_EQ(index, expected_index);
+			ASSERT_EQ(t, expected_t);
+			ASSERT_EQ(n, expected_normal);
+			++hits;
+		}
+	}
+	ASSERT_GT(hits, 20);
+}
+
+TEST(line_batch, impact_matches_scalar_non_dyadic) {
+	// Coordinates in steps of 0.1 are not exact in binary, so contacts at the edges of the pre-culling boxes round both ways.
+	std::mt19937 rng(11);
+	std::uniform_int_distribution<int> grid(-20, 20);
+	std::uniform_int_distribution<int> small(0, 4);
+	auto coord = [&]() { return static_cast<float>(grid(rng)) * 0.1f; };
+	auto offset = [&]() { return static_cast<float>(small(rng) - 2) * 0.1f; };
+
+	segment_soa walls;
+	std::vector<float> cxs;
+	std::vector<float> cys;
+	std::vector<float> rs;
+	std::vector<float> vxs;
+	std::vector<float> vys;
+	for (int i = 0; i < 200; ++i) {
+		walls.x1s.push_back(coord());
+		walls.y1s.push_back(coord());
+		walls.x2s.push_back(walls.x1s.back() + offset());
+		walls.y2s.push_back(walls.y1s.back() + offset());
+		cxs.push_back(coord());
+		cys.push_back(coord());
+		rs.push_back(static_cast<float>(small(rng) + 1) * 0.1f);
+		vxs.push_back(offset());
+		vys.push_back(offset());
+	}
+
+	for (int k = 0; k < 500; ++k) {
+		glm::fvec2 center(coord(), coord());
+		glm::fvec2 velocity(coord(), coord());
+		float r = static_cast<float>(small(rng) + 1) * 0.1f;
+		glm::fvec2 a2 = center + glm::fvec2(offset(), offset());
+
+		bool expected[4] = {};
+		std::uint32_t expected_index[4] = {};
+		float expected_t[4] = {};
+		for (std::size_t i = 0; i < walls.x1s.size(); ++i) {
+			glm::fvec2 b1(walls.x1s[i], walls.y1s[i]);
+			glm::fvec2 b2(walls.x2s[i], walls.y2s[i]);
+			glm::fvec2 c(cxs[i], cys[i]);
+			float ti[4] = {};
+			glm::fvec2 ni;
+			bool hit[4] = {
+				glmp::moving_circle_line_segment_impact(center, r, velocity, b1, b2, &ti[0], &ni),
+				glmp::moving_circles_impact(center, r, velocity, c, rs[i], glm::fvec2(0.0f), &ti[1], &ni),
+				glmp::moving_circles_impact(center, r, velocity, c, rs[i], glm::fvec2(vxs[i], vys[i]), &ti[2], &ni),
+				glmp::moving_line_segment_impact(center, a2, velocity, b1, b2, &ti[3], &ni)};
+			for (int q = 0; q < 4; ++q) {
+				if (hit[q] && (!expected[q] || ti[q] < expected_t[q])) {
+					expected[q] = true;
+					expected_index[q] = static_cast<std::uint32_t>(i);
+					expected_t[q] = ti[q];
+				}
+			}
+		}
+
+		std::uint32_t index[4] = {};
+		float t[4] = {};
+		glm::fvec2 n;
+		bool found[4] = {
+			glmp::moving_circle_line_segment_impact(center, r, velocity, walls.x1s.data(), walls.y1s.data(), walls.x2s.data(), walls.y2s.data(),
+				walls.x1s.size(), &index[0], &t[0], &n),
+			glmp::moving_circles_impact(center, r, velocity, cxs.data(), cys.data(), rs.data(), nullptr, nullptr, cxs.size(), &index[1], &t[1], &n),
+			glmp::moving_circles_impact(center, r, velocity, cxs.data(), cys.data(), rs.data(), vxs.data(), vys.data(), cxs.size(), &index[2], &t[2], &n),
+			glmp::moving_line_segment_impact(center, a2, velocity, walls.x1s.data(), walls.y1s.data(), walls.x2s.data(), walls.y2s.data(),
+				walls.x1s.size(), &index[3], &t[3], &n)};
+		for (int q = 0; q < 4; ++q) {
+			ASSERT_EQ(found[q], expected[q]);
+			if (expected[q]) {
+				ASSERT_EQ(index[q], expected_index[q]);
+				ASSERT_EQ(t[q], expected_t[q]);
+			}
+		}
+	}
+}
@@ -0,0 +1,68 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/polygon.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace glmp = glm_plus;
+
+namespace {
+
+// U shape, open at the top, with a vertex exactly at y = 2.
+glmp::polygon u_shape() {
+	return glmp::polygon({
+		{0.0f, 0.0f}, {6.0f, 0.0f}, {6.0f, 6.0f}, {4.0f, 6.0f},
+		{4.0f, 2.0f}, {2.0f, 2.0f}, {2.0f, 6.0f}, {0.0f, 6.0f}});
+}
+
+}
+
+TEST(polygon, polygon_contains) {
+	glmp::polygon p = u_shape();
+	
+	ASSERT_TRUE(glmp::polygon_contains(p, glm::fvec2(1.0f, 1.0f)));
+	ASSERT_TRUE(glmp::polygon_contains(p, glm::fvec2(5.0f, 4.0f)));
+	ASSERT_TRUE(glmp::polygon_contains(p, glm::fvec2(1.0f, 2.0f)));
+	ASSERT_FALSE(glmp::polygon_contains(p, glm::fvec2(3.0f, 4.0f)));
+	ASSERT_FALSE(glmp::polygon_contains(p, glm::fvec2(-1.0f, 2.0f)));
+	ASSERT_FALSE(glmp::polygon_contains(p, glm::fvec2(7.0f, 1.0f)));
+	ASSERT_FALSE(glmp::polygon_contains(p, glm::fvec2(1.0f, 7.0f)));
+}
+
+TEST(polygon, polygon_index_contains) {
+	glmp::polygon p = u_shape();
+	glmp::polygon_index index(p);
+	
+	ASSERT_TRUE(index.contains(glm::fvec2(1.0f, 1.0f)));
+	ASSERT_TRUE(index.contains(glm::fvec2(5.0f, 4.0f)));
+	ASSERT_FALSE(index.contains(glm::fvec2(3.0f, 4.0f)));
+	ASSERT_FALSE(index.contains(glm::fvec2(1.0f, 7.0f)));
+	
+	for (float y = -0.75f; y < 7.0f; y += 0.25f) {
+		for (float x = -0.75f; x < 7.0f; x += 0.5f)
+			ASSERT_EQ(index.contains(glm::fvec2(x, y)), glmp::polygon_contains(p, glm::fvec2(x, y))) << x << ", " << y;
+	}
+}
+
+TEST(polygon, polygon_index_contains_batch) {
+	glmp::polygon p = u_shape();
+	glmp::polygon_index index(p);
+	
+	std::vector<glm::fvec2> points;
+	for (int i = 0; i < 40; ++i)
+		points.emplace_back(static_cast<float>(i % 8) + 0.5f, static_cast<float>(i / 8) + 0.5f);
+	
+	std::vector<std::uint32_t> mask(glmp::mask_words(points.size()));
+	index.contains(points.data(), points.size(), mask.data());
+	for (std::size_t i = 0; i < points.size(); ++i)
+		ASSERT_EQ(glmp::mask_test(mask.data(), i), glmp::polygon_contains(p, points[i]));
+}
+
+TEST(polygon, polygon_index_empty) {
+	glmp::polygon_index index;
+	ASSERT_FALSE(index.contains(glm::fvec2(0.0f, 0.0f)));
+}
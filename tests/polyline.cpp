@@ -0,0 +1,167 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/polyline.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "glm_plus/line.h"
+
+#include "gtest/gtest.h"
+
+namespace glmp = glm_plus;
+
+namespace {
+
+// Random walk, which often runs close to itself.
+std::vector<glm::fvec2> random_walk(std::size_t count, unsigned seed) {
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<float> step(-3.0f, 3.0f);
+	std::vector<glm::fvec2> vertices;
+	glm::fvec2 p(0.0f);
+	for (std::size_t i = 0; i < count; ++i) {
+		vertices.push_back(p);
+		p += glm::fvec2(step(rng), step(rng));
+	}
+	return vertices;
+}
+
+std::vector<glm::fvec2> random_points(std::size_t count, unsigned seed) {
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<float> coord(-40.0f, 40.0f);
+	std::vector<glm::fvec2> points;
+	for (std::size_t i = 0; i < count; ++i)
+		points.emplace_back(coord(rng), coord(rng));
+	return points;
+}
+
+// Closest segment by linear search with the scalar functions.
+std::uint32_t linear_closest(glm::fvec2 x, const std::vector<glm::fvec2>& vertices, bool closed, float* distance) {
+	std::size_t segments = closed ? vertices.size() : vertices.size() - 1;
+	std::uint32_t best = 0;
+	for (std::size_t i = 0; i < segments; ++i) {
+		float d = glmp::dist_to_line_segment(x, vertices[i], vertices[(i + 1) % vertices.size()]);
+		if (i == 0 || d < *distance) {
+			best = static_cast<std::uint32_t>(i);
+			*distance = d;
+		}
+	}
+	return best;
+}
+
+void assert_same(const glmp::segment_point& a, const glmp::segment_point& b) {
+	ASSERT_EQ(a.id, b.id);
+	ASSERT_EQ(a.t, b.t);
+	ASSERT_EQ(a.point, b.point);
+	ASSERT_EQ(a.distance2, b.distance2);
+}
+
+}
+
+TEST(polyline, closest_point) {
+	std::vector<glm::fvec2> line = {{0, 0}, {4, 0}, {4, 4}};
+	glmp::segment_point found;
+	ASSERT_TRUE(glmp::closest_point_on_polyline(glm::fvec2(1.0f, -2.0f), line.data(), line.size(), &found));
+	ASSERT_EQ(found.id, 0u);
+	ASSERT_EQ(found.t, 0.25f);
+	ASSERT_EQ(found.point, glm::fvec2(1.0f, 0.0f));
+	ASSERT_EQ(found.distance2, 4.0f);
+
+	// Closer to the closing segment, which only exists for closed polylines.
+	ASSERT_TRUE(glmp::closest_point_on_polyline(glm::fvec2(1.0f, 2.0f), line.data(), line.size(), &found));
+	ASSERT_EQ(found.id, 0u);
+	ASSERT_TRUE(glmp::closest_point_on_polyline(glm::fvec2(1.0f, 2.0f), line.data(), line.size(), &found, true));
+	ASSERT_EQ(found.id, 2u);
+	ASSERT_EQ(found.t, 0.625f);
+	ASSERT_EQ(found.point, glm::fvec2(1.5f, 1.5f));
+
+	// Vertex shared by two segments is found on the first one.
+	ASSERT_TRUE(glmp::closest_point_on_polyline(glm::fvec2(6.0f, -2.0f), line.data(), line.size(), &found));
+	ASSERT_EQ(found.id, 0u);
+	ASSERT_EQ(found.t, 1.0f);
+
+	ASSERT_TRUE(glmp::closest_point_on_polyline(glm::fvec2(3.0f, 4.0f), line.data(), 1, &found));
+	ASSERT_EQ(found.id, 0u);
+	ASSERT_EQ(found.point, line[0]);
+	ASSERT_EQ(found.distance2, 25.0f);
+
+	found.id = 7;
+	ASSERT_FALSE(glmp::closest_point_on_polyline(glm::fvec2(3.0f, 4.0f), line.data(), 0, &found));
+	ASSERT_EQ(found.id, 7u);
+}
+
+TEST(polyline, matches_linear_search) {
+	std::vector<glm::fvec2> walk = random_walk(500, 1);
+	std::vector<glm::fvec2> xs = random_points(300, 2);
+	for (bool closed : {false, true}) {
+		glmp::polyline_index index;
+		index.build(walk.data(), walk.size(), closed, 8);
+		std::vector<glmp::segment_point> batch(xs.size());
+		glmp::closest_point_on_polyline(xs.data(), xs.size(), walk.data(), walk.size(), batch.data(), closed);
+		for (std::size_t k = 0; k < xs.size(); ++k) {
+			float distance;
+			std::uint32_t expected = linear_closest(xs[k], walk, closed, &distance);
+			glmp::segment_point found;
+			ASSERT_TRUE(glmp::closest_point_on_polyline(xs[k], walk.data(), walk.size(), &found, closed));
+			ASSERT_EQ(found.id, expected);
+			ASSERT_NEAR(std::sqrt(found.distance2), distance, 1.0e-4f);
+			assert_same(batch[k], found);
+
+			glmp::segment_point indexed;
+			ASSERT_TRUE(index.closest(xs[k], &indexed));
+			assert_same(indexed, found);
+		}
+	}
+}
+
+TEST(polyline, boundary) {
+	glmp::polygon_list shape;
+	shape.clear();
+	for (glm::fvec2 v : {glm::fvec2(0, 0), glm::fvec2(10, 0), glm::fvec2(10, 10), glm::fvec2(0, 10)})
+		shape.vertices.push_back(v);
+	shape.offsets.push_back(shape.vertices.size());
+	for (glm::fvec2 v : {glm::fvec2(3, 3), glm::fvec2(3, 7), glm::fvec2(7, 7), glm::fvec2(7, 3)})
+		shape.vertices.push_back(v);
+	shape.offsets.push_back(shape.vertices.size());
+
+	glmp::polyline_index index;
+	index.build(shape);
+	glm::fvec2 xs[] = {{5.0f, 2.0f}, {5.0f, 1.0f}, {-1.0f, 5.0f}, {6.0f, 5.5f}, {1.0f, 9.0f}};
+	std::uint32_t expected[] = {7, 0, 3, 6, 2};
+	for (std::size_t k = 0; k < 5; ++k) {
+		glmp::segment_point found;
+		ASSERT_TRUE(glmp::closest_point_on_boundary(xs[k], shape, &found));
+		ASSERT_EQ(found.id, expected[k]);
+		glmp::segment_point indexed;
+		ASSERT_TRUE(index.closest(xs[k], &indexed));
+		assert_same(indexed, found);
+	}
+
+	glmp::segment_point found;
+	ASSERT_TRUE(glmp::closest_point_on_boundary(glm::fvec2(6.0f, 5.5f), shape, &found));
+	ASSERT_EQ(found.point, glm::fvec2(7.0f, 5.5f));
+	ASSERT_EQ(found.t, 0.375f);
+}
+
+TEST(polyline, parallel) {
+	std::vector<glm::fvec2> walk = random_walk(3000, 3);
+	std::vector<glm::fvec2> xs = random_points(5000, 4);
+	glmp::polyline_index index;
+	index.build(walk.data(), walk.size());
+	glmp::executor pool(3);
+
+	std::vector<glmp::segment_point> expected(xs.size());
+	std::vector<glmp::segment_point> found(xs.size());
+	index.closest(xs.data(), xs.size(), expected.data(), 5.0f);
+	index.closest(pool, xs.data(), xs.size(), found.data(), 5.0f);
+	for (std::size_t k = 0; k < xs.size(); ++k)
+		assert_same(found[k], expected[k]);
+
+	glmp::closest_point_on_polyline(xs.data(), 500, walk.data(), walk.size(), expected.data());
+	glmp::closest_point_on_polyline(pool, xs.data(), 500, walk.data(), walk.size(), found.data());
+	for (std::size_t k = 0; k < 500; ++k)
+		assert_same(found[k], expected[k]);
+}
@@ -0,0 +1,117 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/predicates.h"
+
+#include <cmath>
+#include <random>
+
+#include "glm_plus/line.h"
+
+#include "gtest/gtest.h"
+
+namespace glmp = glm_plus;
+
+namespace {
+
+int sign(double x) {
+	return (x > 0.0) - (x < 0.0);
+}
+
+int sign(__int128 x) {
+	return (x > 0) - (x < 0);
+}
+
+}
+
+TEST(predicates, orient2d) {
+	ASSERT_GT(glmp::orient2d(glm::dvec2(0.0, 0.0), glm::dvec2(1.0, 0.0), glm::dvec2(0.0, 1.0)), 0.0);
+	ASSERT_LT(glmp::orient2d(glm::dvec2(0.0, 0.0), glm::dvec2(1.0, 0.0), glm::dvec2(0.0, -1.0)), 0.0);
+	ASSERT_EQ(glmp::orient2d(glm::dvec2(0.0, 0.0), glm::dvec2(1.0, 1.0), glm::dvec2(3.0, 3.0)), 0.0);
+	ASSERT_GT(glmp::orient2d(glm::fvec2(0.0f, 0.0f), glm::fvec2(1.0f, 0.0f), glm::fvec2(0.0f, 1.0f)), 0.0);
+}
+
+TEST(predicates, orient2d_near_collinear) {
+	// Points near the line y = x, offset by a few units in the last place.
+	// The orientation is 12 * (y - x), which double precision evaluation gets wrong for many of them.
+	double ulp = std::ldexp(1.0, -53);
+	for (int i = 0; i < 32; ++i) {
+		for (int j = 0; j < 32; ++j) {
+			glm::dvec2 a(0.5 + i * ulp, 0.5 + j * ulp);
+			double o = glmp::orient2d(a, glm::dvec2(12.0, 12.0), glm::dvec2(24.0, 24.0));
+			ASSERT_EQ(sign(o), (j > i) - (j < i)) << i << " " << j;
+		}
+	}
+}
+
+TEST(predicates, incircle) {
+	glm::dvec2 a(1.0, 0.0);
+	glm::dvec2 b(0.0, 1.0);
+	glm::dvec2 c(-1.0, 0.0);
+	double ulp = std::ldexp(1.0, -52);
+	ASSERT_EQ(glmp::incircle(a, b, c, glm::dvec2(0.0, -1.0)), 0.0);
+	ASSERT_GT(glmp::incircle(a, b, c, glm::dvec2(0.0, -1.0 + ulp)), 0.0);
+	ASSERT_LT(glmp::incircle(a, b, c, glm::dvec2(0.0, -1.0 - 2.0 * ulp)), 0.0);
+	ASSERT_LT(glmp::incircle(a, c, b, glm::dvec2(0.0, -1.0 + ulp)), 0.0);
+	ASSERT_GT(glmp::incircle(a, b, c, glm::dvec2(0.0, 0.0)), 0.0);
+	ASSERT_LT(glmp::incircle(a, b, c, glm::dvec2(5.0, 5.0)), 0.0);
+}
+
+TEST(predicates, large_offset) {
+	// Integer coordinates with a large offset are exact in double, but their determinants are not.
+	// Reference results are calculated exactly from the small integer differences.
+	std::mt19937 rng(7);
+	std::uniform_int_distribution<int> coord(-3, 3);
+	const double offset = std::ldexp(1.0, 40);
+	for (int n = 0; n < 20000; ++n) {
+		long long p[4][2];
+		for (auto& q : p) {
+			q[0] = coord(rng);
+			q[1] = coord(rng);
+		}
+		glm::dvec2 v[4];
+		for (int i = 0; i < 4; ++i)
+			v[i] = glm::dvec2(offset + static_cast<double>(p[i][0]), offset + static_cast<double>(p[i][1]));
+
+		__int128 acx = p[0][0] - p[2][0];
+		__int128 acy = p[0][1] - p[2][1];
+		__int128 bcx = p[1][0] - p[2][0];
+		__int128 bcy = p[1][1] - p[2][1];
+		ASSERT_EQ(sign(glmp::orient2d(v[0], v[1], v[2])), sign(acx * bcy - acy * bcx));
+
+		__int128 d[3][2];
+		for (int i = 0; i < 3; ++i) {
+			d[i][0] = p[i][0] - p[3][0];
+			d[i][1] = p[i][1] - p[3][1];
+		}
+		__int128 lift[3];
+		for (int i = 0; i < 3; ++i)
+			lift[i] = d[i][0] * d[i][0] + d[i][1] * d[i][1];
+		__int128 det = lift[0] * (d[1][0] * d[2][1] - d[2][0] * d[1][1])
+			+ lift[1] * (d[2][0] * d[0][1] - d[0][0] * d[2][1])
+			+ lift[2] * (d[0][0] * d[1][1] - d[1][0] * d[0][1]);
+		ASSERT_EQ(sign(glmp::incircle(v[0], v[1], v[2], v[3])), sign(det));
+	}
+}
+
+TEST(predicates, is_right_of_line_exact) {
+	glm::dvec2 p1(0.1, 0.1);
+	glm::dvec2 p2(0.3, 0.3);
+	ASSERT_TRUE(glmp::is_right_of_line_exact(glm::dvec2(0.2, 0.3), p1, p2));
+	ASSERT_FALSE(glmp::is_right_of_line_exact(glm::dvec2(0.3, 0.2), p1, p2));
+	ASSERT_TRUE(glmp::is_right_of_line_exact(glm::dvec2(0.7, 0.7), p1, p2));
+	ASSERT_EQ(glmp::is_right_of_line_exact(glm::fvec2(0.0f, 1.0f), glm::fvec2(0.0f, 0.0f), glm::fvec2(1.0f, 0.0f)),
+		glmp::is_right_of_line(glm::fvec2(0.0f, 1.0f), glm::fvec2(0.0f, 0.0f), glm::fvec2(1.0f, 0.0f)));
+}
+
+TEST(predicates, lines_coincide_exact) {
+	// Far from the origin, the fixed margin of lines_coincide is smaller than the rounding error.
+	glm::dvec2 a1(1.0e8, 1.0e8);
+	glm::dvec2 a2(1.0e8 + 3.0, 1.0e8 + 1.0);
+	glm::dvec2 b1(1.0e8 + 6.0, 1.0e8 + 2.0);
+	glm::dvec2 b2(1.0e8 + 9.0, 1.0e8 + 3.0);
+	ASSERT_TRUE(glmp::lines_coincide_exact(a1, a2, b1, b2));
+	ASSERT_FALSE(glmp::lines_coincide_exact(a1, a2, b1, b2 + glm::dvec2(0.0, 1.0e-8)));
+	ASSERT_TRUE(glmp::lines_coincide_exact(glm::fvec2(0.0f, 0.0f), glm::fvec2(2.0f, 1.0f), glm::fvec2(4.0f, 2.0f), glm::fvec2(6.0f, 3.0f)));
+}
@@ -0,0 +1,163 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/quantized.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "glm_plus/line.h"
+#include "glm_plus/line_batch.h"
+
+#include "gtest/gtest.h"
+
+namespace glmp = glm_plus;
+
+namespace {
+
+const glmp::farea tile(glmp::fpos(-1000.0f, 500.0f), glmp::fpos(1000.0f, 2500.0f));
+
+std::vector<glmp::fsegment> random_segments(std::size_t count, unsigned seed) {
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<float> x(-1000.0f, 1000.0f);
+	std::uniform_real_distribution<float> y(500.0f, 2500.0f);
+	std::vector<glmp::fsegment> segments;
+	for (std::size_t i = 0; i < count; ++i)
+		segments.emplace_back(glm::fvec2(x(rng), y(rng)), glm::fvec2(x(rng), y(rng)));
+	return segments;
+}
+
+}
+
+TEST(quantized, quantization) {
+	glmp::quantization q(tile);
+	glm::fvec2 error = q.get_max_error();
+	ASSERT_NEAR(error.x, 2000.0f / 65535.0f / 2.0f, 1e-6f);
+
+	glm::u16vec2 corner = q.encode(glm::fvec2(-1000.0f, 500.0f));
+	ASSERT_EQ(corner.x, 0);
+	ASSERT_EQ(corner.y, 0);
+	glm::u16vec2 far = q.encode(glm::fvec2(5000.0f, 2500.0f));
+	ASSERT_EQ(far.x, 65535);
+	ASSERT_EQ(far.y, 65535);
+	glm::u16vec2 invalid = q.encode(glm::fvec2(std::nanf(""), -std::numeric_limits<float>::infinity()));
+	ASSERT_EQ(invalid.x, 0);
+	ASSERT_EQ(invalid.y, 0);
+	glm::u16vec2 infinite = q.encode(glm::fvec2(std::numeric_limits<float>::infinity(), 1000.0f));
+	ASSERT_EQ(infinite.x, 65535);
+
+	glm::fvec2 p(123.456f, 789.012f);
+	glm::u16vec2 g = q.encode(p);
+	glm::fvec2 d = q.decode(g.x, g.y);
+	ASSERT_LE(std::abs(d.x - p.x), error.x * 1.01f);
+	ASSERT_LE(std::abs(d.y - p.y), error.y * 1.01f);
+}
+
+TEST(quantized, segments) {
+	std::vector<glmp::fsegment> segments = random_segments(1000, 1);
+	glmp::quantized_segments storage(segments.data(), segments.size(), tile);
+	glmp::quantized_segment_view view = storage.view();
+	ASSERT_EQ(view.size(), segments.size());
+	ASSERT_EQ(storage.get_data().size() * sizeof(std::uint16_t), segments.size() * sizeof(glmp::fsegment) / 2);
+
+	glm::fvec2 error = storage.get_quantization().get_max_error() * 1.01f;
+	for (std::size_t i = 0; i < segments.size(); ++i) {
+		glmp::fsegment s = view[i];
+		ASSERT_LE(std::abs(s.p1.x - segments[i].p1.x), error.x);
+		ASSERT_LE(std::abs(s.p1.y - segments[i].p1.y), error.y);
+		ASSERT_LE(std::abs(s.p2.x - segments[i].p2.x), error.x);
+		ASSERT_LE(std::abs(s.p2.y - segments[i].p2.y), error.y);
+
+		glmp::farea bounds = view.get_bounds(i);
+		ASSERT_TRUE(glmp::inside_rect(s.p1, bounds));
+		ASSERT_TRUE(glmp::inside_rect(s.p2, bounds));
+	}
+
+	glmp::quantized_segment_view sub = view.subview(100, 10);
+	ASSERT_EQ(sub.size(), 10);
+	ASSERT_EQ(sub[3].p1, view[103].p1);
+	ASSERT_EQ(sub[3].p2, view[103].p2);
+
+	// Zero-copy view over external data.
+	std::vector<std::uint16_t> copy = storage.get_data();
+	glmp::quantized_segment_view external(copy.data(), segments.size(), storage.get_quantization());
+	ASSERT_EQ(external[500].p2, view[500].p2);
+}
+
+TEST(quantized, segments_intersect) {
+	std::vector<glmp::fsegment> segments = random_segments(1000, 2);
+	glmp::quantized_segments storage(segments.data(), segments.size(), tile);
+	glmp::quantized_segment_view view = storage.view();
+	glm::fvec2 a1(-900.0f, 600.0f);
+	glm::fvec2 a2(900.0f, 2400.0f);
+
+	std::vector<std::uint32_t> hits(view.size());
+	std::vector<float> ts(view.size());
+	std::size_t n = glmp::line_segments_intersect(a1, a2, view, hits.data(), ts.data());
+	ASSERT_GT(n, 0);
+
+	std::size_t expected = 0;
+	for (std::size_t i = 0; i < view.size(); ++i) {
+		float t;
+		float u;
+		glmp::fsegment s = view[i];
+		if (glmp::line_segments_intersect_parametric(a1, a2, s.p1, s.p2, &t, &u)) {
+			ASSERT_LT(expected, n);
+			ASSERT_EQ(hits[expected], i);
+			ASSERT_FLOAT_EQ(ts[expected], t);
+			++expected;
+		}
+	}
+	ASSERT_EQ(expected, n);
+}
+
+TEST(quantized, polyline) {
+	// Smooth coastline-like curve, with small steps between points.
+	std::vector<glm::fvec2> points;
+	for (int i = 0; i < 2000; ++i) {
+		float a = static_cast<float>(i) * 0.003f;
+		points.emplace_back(std::cos(a) * 900.0f, 1500.0f + std::sin(a * 3.0f) * 900.0f);
+	}
+	glmp::quantized_polyline storage(points.data(), points.size(), tile);
+	glmp::quantized_polyline_view view = storage.view();
+	ASSERT_EQ(view.size(), points.size());
+	ASSERT_LT(storage.get_data().size(), points.size() * sizeof(glm::fvec2) / 2);
+
+	glm::fvec2 error = storage.get_quantization().get_max_error() * 1.01f;
+	std::size_t i = 0;
+	for (glm::fvec2 p : view) {
+		ASSERT_LE(std::abs(p.x - points[i].x), error.x);
+		ASSERT_LE(std::abs(p.y - points[i].y), error.y);
+		++i;
+	}
+	ASSERT_EQ(i, points.size());
+
+	// Iterators outlive temporary views.
+	glmp::quantized_polyline_view::iterator it = storage.view().begin();
+	++it;
+	ASSERT_LE(std::abs((*it).x - points[1].x), error.x);
+	ASSERT_LE(std::abs((*it).y - points[1].y), error.y);
+
+	std::vector<float> xs(points.size());
+	std::vector<float> ys(points.size());
+	view.decode(xs.data(), ys.data());
+
+	glm::fvec2 a1(0.0f, 600.0f);
+	glm::fvec2 a2(0.0f, 2400.0f);
+	std::vector<std::uint32_t> hits(points.size());
+	std::vector<float> ts(points.size());
+	std::size_t n = glmp::line_segments_intersect(a1, a2, view, hits.data(), ts.data());
+	std::vector<std::uint32_t> expected_hits(points.size());
+	std::vector<float> expected_ts(points.size());
+	std::size_t expected = glmp::line_segments_intersect(a1, a2, xs.data(), ys.data(), xs.data() + 1, ys.data() + 1, points.size() - 1,
+		expected_hits.data(), expected_ts.data());
+	ASSERT_GT(n, 0);
+	ASSERT_EQ(n, expected);
+	for (std::size_t k = 0; k < n; ++k) {
+		ASSERT_EQ(hits[k], expected_hits[k]);
+		ASSERT_FLOAT_EQ(ts[k], expected_ts[k]);
+	}
+}
\ No newline at end of file
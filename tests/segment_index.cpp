@@ -0,0 +1,217 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/segment_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "glm_plus/line.h"
+
+#include "gtest/gtest.h"
+
+namespace glmp = glm_plus;
+
+namespace {
+
+std::vector<glmp::fsegment> random_segments(std::size_t count, unsigned seed) {
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<float> coord(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> offset(-5.0f, 5.0f);
+	std::vector<glmp::fsegment> segments;
+	for (std::size_t i = 0; i < count; ++i) {
+		glm::fvec2 p(coord(rng), coord(rng));
+		segments.emplace_back(p, p + glm::fvec2(offset(rng), offset(rng)));
+	}
+	return segments;
+}
+
+std::vector<std::uint32_t> sorted_ids(const std::vector<glmp::segment_hit>& hits) {
+	std::vector<std::uint32_t> ids;
+	for (const glmp::segment_hit& h : hits)
+		ids.push_back(h.id);
+	std::sort(ids.begin(), ids.end());
+	return ids;
+}
+
+}
+
+TEST(segment_index, query) {
+	std::vector<glmp::fsegment> segments = random_segments(3000, 1);
+	std::vector<std::uint8_t> data;
+	glmp::build_segment_index(segments.data(), segments.size(), &data);
+	glmp::segment_index index;
+	ASSERT_TRUE(glmp::segment_index::open(data.data(), data.size(), &index));
+	ASSERT_EQ(index.size(), segments.size());
+	ASSERT_EQ(index.get_segment(1234).p1, segments[1234].p1);
+	ASSERT_EQ(index.get_segment(1234).p2, segments[1234].p2);
+
+	glmp::farea range(glmp::fpos(-20.0f, 10.0f), glmp::fpos(15.0f, 30.0f));
+	std::vector<std::uint32_t> found;
+	index.query(range, &found);
+	std::sort(found.begin(), found.end());
+	std::vector<std::uint32_t> expected;
+	for (std::size_t i = 0; i < segments.size(); ++i) {
+		const glmp::fsegment& s = segments[i];
+		if (std::min(s.p1.x, s.p2.x) <= range.bottomright.x && std::max(s.p1.x, s.p2.x) >= range.topleft.x
+				&& std::min(s.p1.y, s.p2.y) <= range.bottomright.y && std::max(s.p1.y, s.p2.y) >= range.topleft.y)
+			expected.push_back(static_cast<std::uint32_t>(i));
+	}
+	ASSERT_FALSE(expected.empty());
+	ASSERT_EQ(found, expected);
+}
+
+TEST(segment_index, intersect) {
+	std::vector<glmp::fsegment> segments = random_segments(3000, 2);
+	std::vector<std::uint8_t> data;
+	glmp::build_segment_index(segments.data(), segments.size(), &data, 8);
+	glmp::segment_index index;
+	ASSERT_TRUE(glmp::segment_index::open(data.data(), data.size(), &index));
+
+	glm::fvec2 rays[][2] = {{{-100, -30}, {100, 40}}, {{0, -100}, {0, 100}}, {{-50, 20}, {50, 20}}};
+	for (auto& ray : rays) {
+		std::vector<glmp::segment_hit> hits;
+		index.intersect(ray[0], ray[1], &hits);
+		std::vector<std::uint32_t> expected;
+		for (std::size_t i = 0; i < segments.size(); ++i) {
+			float t;
+			float u;
+			if (glmp::line_segments_intersect_parametric(ray[0], ray[1], segments[i].p1, segments[i].p2, &t, &u))
+				expected.push_back(static_cast<std::uint32_t>(i));
+		}
+		ASSERT_FALSE(expected.empty());
+		ASSERT_EQ(sorted_ids(hits), expected);
+	}
+}
+
+TEST(segment_index, intersect_non_integer_grid) {
+	// End points in steps of 0.1 are not exact in binary, so many hits only touch within rounding errors.
+	std::mt19937 rng(5);
+	std::uniform_int_distribution<int> coord(0, 100);
+	std::uniform_int_distribution<int> offset(-3, 3);
+	auto point = [&]() { return glm::fvec2(static_cast<float>(coord(rng)) * 0.1f, static_cast<float>(coord(rng)) * 0.1f); };
+	std::vector<glmp::fsegment> segments;
+	for (int i = 0; i < 2000; ++i) {
+		glm::fvec2 p = point();
+		segments.emplace_back(p, i % 2 == 0 ? point() : p + glm::fvec2(static_cast<float>(offset(rng)) * 0.1f, static_cast<float>(offset(rng)) * 0.1f));
+	}
+	std::vector<std::uint8_t> data;
+	glmp::build_segment_index(segments.data(), segments.size(), &data, 2);
+	glmp::segment_index index;
+	ASSERT_TRUE(glmp::segment_index::open(data.data(), data.size(), &index));
+
+	for (int k = 0; k < 1000; ++k) {
+		glm::fvec2 a1 = point();
+		glm::fvec2 a2 = point();
+		std::vector<glmp::segment_hit> hits;
+		index.intersect(a1, a2, &hits);
+		std::vector<std::uint32_t> expected;
+		for (std::size_t i = 0; i < segments.size(); ++i) {
+			float t;
+			float u;
+			if (glmp::line_segments_intersect_parametric(a1, a2, segments[i].p1, segments[i].p2, &t, &u))
+				expected.push_back(static_cast<std::uint32_t>(i));
+		}
+		ASSERT_EQ(sorted_ids(hits), expected);
+	}
+}
+
+TEST(segment_index, closest) {
+	std::vector<glmp::fsegment> segments = random_segments(3000, 4);
+	std::vector<std::uint8_t> data;
+	glmp::build_segment_index(segments.data(), segments.size(), &data, 8);
+	glmp::segment_index index;
+	ASSERT_TRUE(glmp::segment_index::open(data.data(), data.size(), &index));
+
+	std::mt19937 rng(5);
+	std::uniform_real_distribution<float> coord(-120.0f, 120.0f);
+	std::vector<glm::fvec2> xs;
+	for (int k = 0; k < 200; ++k)
+		xs.emplace_back(coord(rng), coord(rng));
+	std::vector<glmp::segment_point> batch(xs.size());
+	index.closest(xs.data(), xs.size(), batch.data(), 3.0f);
+
+	for (std::size_t k = 0; k < xs.size(); ++k) {
+		glm::fvec2 x = xs[k];
+		std::size_t expected = 0;
+		float expected_distance = glmp::dist_to_line_segment(x, segments[0].p1, segments[0].p2);
+		for (std::size_t i = 1; i < segments.size(); ++i) {
+			float d = glmp::dist_to_line_segment(x, segments[i].p1, segments[i].p2);
+			if (d < expected_distance) {
+				expected = i;
+				expected_distance = d;
+			}
+		}
+
+		glmp::segment_point found;
+		ASSERT_TRUE(index.closest(x, &found));
+		ASSERT_EQ(found.id, expected);
+		ASSERT_NEAR(std::sqrt(found.distance2), expected_distance, 1.0e-4f);
+		glm::fvec2 p = glmp::closest_point_on_line_segment(x, segments[expected].p1, segments[expected].p2);
+		ASSERT_NEAR(found.point.x, p.x, 1.0e-4f);
+		ASSERT_NEAR(found.point.y, p.y, 1.0e-4f);
+
+		if (expected_distance <= 2.99f) {
+			ASSERT_EQ(batch[k].id, expected);
+		} else if (expected_distance > 3.01f) {
+			ASSERT_EQ(batch[k].id, UINT32_MAX);
+		}
+	}
+}
+
+TEST(segment_index, validation) {
+	std::vector<glmp::fsegment> segments = random_segments(100, 3);
+	std::vector<std::uint8_t> data;
+	glmp::build_segment_index(segments.data(), segments.size(), &data);
+	glmp::segment_index index;
+
+	ASSERT_FALSE(glmp::segment_index::open(data.data(), data.size() - 64, &index));
+	ASSERT_FALSE(glmp::segment_index::open(data.data(), 10, &index));
+
+	std::vector<std::uint8_t> corrupted = data;
+	corrupted[data.size() - 70] ^= 1;
+	ASSERT_FALSE(glmp::segment_index::open(corrupted.data(), corrupted.size(), &index));
+	ASSERT_TRUE(glmp::segment_index::open(corrupted.data(), corrupted.size(), &index, false));
+
+	std::vector<std::uint8_t> wrong_version = data;
+	wrong_version[8] = 99;
+	ASSERT_FALSE(glmp::segment_index::open(wrong_version.data(), wrong_version.size(), &index));
+
+	std::vector<std::uint8_t> empty;
+	glmp::build_segment_index(nullptr, 0, &empty);
+	ASSERT_TRUE(glmp::segment_index::open(empty.data(), empty.size(), &index));
+	std::vector<glmp::segment_hit> hits;
+	index.intersect(glm::fvec2(0, 0), glm::fvec2(1, 1), &hits);
+	ASSERT_TRUE(hits.empty());
+}
+
+TEST(segment_index, mapped_file) {
+	std::vector<glmp::fsegment> segments = random_segments(1000, 4);
+	std::string path = testing::TempDir() + "glm_plus_segment_index.bin";
+	ASSERT_TRUE(glmp::save_segment_index(path, segments.data(), segments.size()));
+
+	glmp::mapped_segment_index mapped;
+	ASSERT_TRUE(mapped.open(path));
+	ASSERT_EQ(mapped.get_index().size(), segments.size());
+	std::vector<glmp::segment_hit> hits;
+	mapped.get_index().intersect(glm::fvec2(-100, -100), glm::fvec2(100, 100), &hits);
+
+	std::vector<std::uint8_t> data;
+	glmp::build_segment_index(segments.data(), segments.size(), &data);
+	glmp::segment_index index;
+	ASSERT_TRUE(glmp::segment_index::open(data.data(), data.size(), &index));
+	std::vector<glmp::segment_hit> expected;
+	index.intersect(glm::fvec2(-100, -100), glm::fvec2(100, 100), &expected);
+	ASSERT_EQ(sorted_ids(hits), sorted_ids(expected));
+
+	glmp::mapped_segment_index moved(std::move(mapped));
+	ASSERT_EQ(mapped.get_index().size(), 0);
+	ASSERT_EQ(moved.get_index().size(), segments.size());
+	moved.close();
+	ASSERT_FALSE(moved.open(path + ".missing"));
+	std::remove(path.c_str());
+}
@@ -0,0 +1,90 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/spatial_hash.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace glmp = glm_plus;
+
+namespace {
+
+std::vector<std::uint32_t> query(const glmp::fspatial_hash& hash, glmp::farea range) {
+	std::vector<std::uint32_t> r;
+	hash.query(range, &r);
+	std::sort(r.begin(), r.end());
+	return r;
+}
+
+std::vector<std::uint32_t> query(const glmp::fspatial_hash& hash, glm::fvec2 center, float radius) {
+	std::vector<std::uint32_t> r;
+	hash.query(center, radius, &r);
+	std::sort(r.begin(), r.end());
+	return r;
+}
+
+}
+
+TEST(spatial_hash, insert_query_area) {
+	glmp::fspatial_hash hash(10.0f, 64);
+	hash.insert(0, glmp::fpos(5.0f, 5.0f));
+	hash.insert(1, glmp::fpos(-15.0f, 25.0f));
+	hash.insert(2, glmp::fbox(glmp::fpos(0.0f, 0.0f), glmp::fpos(35.0f, 12.0f)));
+	
+	ASSERT_TRUE(hash.contains(2));
+	ASSERT_FALSE(hash.contains(3));
+	ASSERT_EQ(query(hash, glmp::farea(glmp::fpos(0.0f, 0.0f), glmp::fpos(6.0f, 6.0f))), (std::vector<std::uint32_t>{0, 2}));
+	ASSERT_EQ(query(hash, glmp::farea(glmp::fpos(30.0f, 10.0f), glmp::fpos(50.0f, 50.0f))), (std::vector<std::uint32_t>{2}));
+	ASSERT_EQ(query(hash, glmp::farea(glmp::fpos(-20.0f, 20.0f), glmp::fpos(-15.0f, 25.0f))), (std::vector<std::uint32_t>{1}));
+	ASSERT_TRUE(query(hash, glmp::farea(glmp::fpos(36.0f, 0.0f), glmp::fpos(40.0f, 5.0f))).empty());
+	ASSERT_EQ(query(hash, glmp::farea(glmp::fpos(-1000.0f, -1000.0f), glmp::fpos(1000.0f, 1000.0f))), (std::vector<std::uint32_t>{0, 1, 2}));
+}
+
+TEST(spatial_hash, query_circle) {
+	glmp::fspatial_hash hash(4.0f, 64);
+	hash.insert(0, glmp::fpos(3.0f, 4.0f));
+	hash.insert(1, glmp::fbox(glmp::fpos(10.0f, -1.0f), glmp::fpos(12.0f, 1.0f)));
+	
+	ASSERT_EQ(query(hash, glm::fvec2(0.0f, 0.0f), 5.0f), (std::vector<std::uint32_t>{0}));
+	ASSERT_TRUE(query(hash, glm::fvec2(0.0f, 0.0f), 4.9f).empty());
+	ASSERT_EQ(query(hash, glm::fvec2(0.0f, 0.0f), 10.0f), (std::vector<std::uint32_t>{0, 1}));
+}
+
+TEST(spatial_hash, move_remove) {
+	glmp::fspatial_hash hash(10.0f, 64);
+	hash.insert(0, glmp::fpos(5.0f, 5.0f));
+	hash.insert(1, glmp::fpos(6.0f, 6.0f));
+	
+	hash.move(0, glmp::fpos(7.0f, 7.0f));
+	ASSERT_EQ(query(hash, glmp::farea(glmp::fpos(6.5f, 6.5f), glmp::fpos(8.0f, 8.0f))), (std::vector<std::uint32_t>{0}));
+	
+	hash.move(0, glmp::fbox(glmp::fpos(55.0f, 55.0f), glmp::fpos(75.0f, 60.0f)));
+	ASSERT_EQ(query(hash, glmp::farea(glmp::fpos(0.0f, 0.0f), glmp::fpos(10.0f, 10.0f))), (std::vector<std::uint32_t>{1}));
+	ASSERT_EQ(query(hash, glmp::farea(glmp::fpos(70.0f, 50.0f), glmp::fpos(80.0f, 60.0f))), (std::vector<std::uint32_t>{0}));
+	
+	hash.remove(1);
+	hash.remove(1);
+	ASSERT_FALSE(hash.contains(1));
+	ASSERT_TRUE(query(hash, glmp::farea(glmp::fpos(0.0f, 0.0f), glmp::fpos(10.0f, 10.0f))).empty());
+	
+	hash.insert(1, glmp::fpos(1.0f, 1.0f));
+	ASSERT_EQ(query(hash, glmp::farea(glmp::fpos(0.0f, 0.0f), glmp::fpos(100.0f, 100.0f))), (std::vector<std::uint32_t>{0, 1}));
+	
+	hash.clear();
+	ASSERT_FALSE(hash.contains(0));
+	ASSERT_TRUE(query(hash, glmp::farea(glmp::fpos(0.0f, 0.0f), glmp::fpos(100.0f, 100.0f))).empty());
+}
+
+TEST(spatial_hash, int_coordinates) {
+	glmp::ispatial_hash hash(8, 16);
+	hash.insert(0, glmp::ipos(-3, -3));
+	hash.insert(1, glmp::ipos(9, 2));
+	
+	std::vector<std::uint32_t> r;
+	hash.query(glmp::iarea(glmp::ipos(-8, -8), glmp::ipos(0, 0)), &r);
+	ASSERT_EQ(r, (std::vector<std::uint32_t>{0}));
+}
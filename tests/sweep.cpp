@@ -0,0 +1,109 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/sweep.h"
+#include "glm_plus/line.h"
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "assertions.h"
+
+namespace glmp = glm_plus;
+
+TEST(sweep, find_line_segment_intersections) {
+	std::vector<glmp::fsegment> segments = {
+		{{0.0f, 0.0f}, {4.0f, 4.0f}},
+		{{0.0f, 4.0f}, {4.0f, 0.0f}},
+		{{2.0f, 0.0f}, {2.0f, 5.0f}},
+		{{5.0f, 5.0f}, {6.0f, 6.0f}}};
+	
+	std::vector<glmp::segment_intersection> r;
+	glmp::find_line_segment_intersections(segments.data(), segments.size(), &r);
+	ASSERT_EQ(r.size(), 3u);
+	ASSERT_EQ(r[0].first, 0u);
+	ASSERT_EQ(r[0].second, 1u);
+	ASSERT_VEC2_EQ(r[0].point, 2.0f, 2.0f);
+	ASSERT_FALSE(r[0].coincide);
+	ASSERT_EQ(r[1].first, 0u);
+	ASSERT_EQ(r[1].second, 2u);
+	ASSERT_EQ(r[2].first, 1u);
+	ASSERT_EQ(r[2].second, 2u);
+}
+
+TEST(sweep, find_line_segment_intersections_coincide) {
+	std::vector<glmp::fsegment> segments = {
+		{{0.0f, 0.0f}, {4.0f, 2.0f}},
+		{{6.0f, 3.0f}, {2.0f, 1.0f}},
+		{{4.0f, 2.0f}, {8.0f, 4.0f}},
+		{{-2.0f, -1.0f}, {0.0f, 0.0f}}};
+	
+	std::vector<glmp::segment_intersection> r;
+	glmp::find_line_segment_intersections(segments.data(), segments.size(), &r);
+	ASSERT_EQ(r.size(), 2u);
+	ASSERT_EQ(r[0].first, 0u);
+	ASSERT_EQ(r[0].second, 1u);
+	ASSERT_TRUE(r[0].coincide);
+	ASSERT_EQ(r[1].first, 1u);
+	ASSERT_EQ(r[1].second, 2u);
+	ASSERT_TRUE(r[1].coincide);
+}
+
+namespace {
+
+void assert_matches_pairwise(float step, float offset) {
+	std::mt19937 rng(7);
+	std::uniform_int_distribution<int> coord(0, 10);
+	std::vector<glmp::fsegment> segments;
+	for (int i = 0; i < 200; ++i) {
+		segments.emplace_back(
+			glm::fvec2(offset + static_cast<float>(coord(rng)) * step, offset + static_cast<float>(coord(rng)) * step),
+			glm::fvec2(offset + static_cast<float>(coord(rng)) * step, offset + static_cast<float>(coord(rng)) * step));
+	}
+	
+	std::vector<glmp::segment_intersection> r;
+	glmp::find_line_segment_intersections(segments.data(), segments.size(), &r);
+	
+	std::size_t k = 0;
+	for (std::size_t i = 0; i < segments.size(); ++i) {
+		for (std::size_t j = i + 1; j < segments.size(); ++j) {
+			const glmp::fsegment& a = segments[i];
+			const glmp::fsegment& b = segments[j];
+			if (a.p1 == a.p2 || b.p1 == b.p2)
+				continue;
+			
+			glm::fvec2 p;
+			bool coincide = glmp::line_segments_coincide(a.p1, a.p2, b.p1, b.p2);
+			if (!coincide && !glmp::line_segments_intersect(a.p1, a.p2, b.p1, b.p2, &p))
+				continue;
+			
+			ASSERT_LT(k, r.size());
+			ASSERT_EQ(r[k].first, i);
+			ASSERT_EQ(r[k].second, j);
+			ASSERT_EQ(r[k].coincide, coincide);
+			++k;
+		}
+	}
+	ASSERT_EQ(k, r.size());
+}
+
+}
+
+TEST(sweep, find_line_segment_intersections_matches_pairwise) {
+	// Integer coordinates produce many shared end points, vertical and collinear segments.
+	assert_matches_pairwise(1.0f, 0.0f);
+}
+
+TEST(sweep, find_line_segment_intersections_matches_pairwise_non_integer) {
+	// Grid points are not exact in binary, so segments touch only within rounding errors.
+	assert_matches_pairwise(0.1f, 0.0f);
+	assert_matches_pairwise(0.37f, 100.0f);
+}
+
+TEST(sweep, find_line_segment_intersections_empty) {
+	std::vector<glmp::segment_intersection> r(1);
+	glmp::find_line_segment_intersections(nullptr, 0, &r);
+	ASSERT_TRUE(r.empty());
+}
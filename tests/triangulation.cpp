@@ -0,0 +1,167 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/triangulation.h"
+
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "glm_plus/predicates.h"
+
+#include "gtest/gtest.h"
+
+namespace glmp = glm_plus;
+
+namespace {
+
+double signed_area(const glm::fvec2* v, std::size_t count) {
+	double a = 0.0;
+	for (std::size_t i = 0, j = count - 1; i < count; j = i++)
+		a += static_cast<double>(v[j].x) * v[i].y - static_cast<double>(v[i].x) * v[j].y;
+	return a * 0.5;
+}
+
+double shape_area(const glmp::polygon_list& shape) {
+	double a = std::abs(signed_area(shape.vertices.data(), shape.offsets[1]));
+	for (std::size_t i = 1; i < shape.size(); ++i)
+		a -= std::abs(signed_area(shape.vertices.data() + shape.offsets[i], shape.offsets[i + 1] - shape.offsets[i]));
+	return a;
+}
+
+// Checks that all triangles run counter-clockwise and returns their total area.
+double triangles_area(const std::vector<glm::fvec2>& vertices, const std::vector<std::uint32_t>& indices) {
+	double a = 0.0;
+	for (std::size_t i = 0; i < indices.size(); i += 3) {
+		double o = glmp::orient2d(vertices[indices[i]], vertices[indices[i + 1]], vertices[indices[i + 2]]);
+		EXPECT_GT(o, 0.0);
+		a += o * 0.5;
+	}
+	return a;
+}
+
+void add_ring(glmp::polygon_list* shape, const std::vector<glm::fvec2>& ring) {
+	shape->vertices.insert(shape->vertices.end(), ring.begin(), ring.end());
+	shape->offsets.push_back(shape->vertices.size());
+}
+
+// Polygon with a wavy boundary, which has many reflex vertices.
+std::vector<glm::fvec2> star(glm::fvec2 center, float radius, std::size_t count, bool clockwise) {
+	std::vector<glm::fvec2> ring;
+	for (std::size_t i = 0; i < count; ++i) {
+		float angle = 6.2831853f * static_cast<float>(i) / static_cast<float>(count) * (clockwise ? -1.0f : 1.0f);
+		float r = radius * (1.0f + 0.3f * std::sin(static_cast<float>(i) * 0.7f));
+		ring.emplace_back(center.x + r * std::cos(angle), center.y + r * std::sin(angle));
+	}
+	return ring;
+}
+
+glmp::polygon_list square_with_hole() {
+	glmp::polygon_list shape;
+	shape.clear();
+	add_ring(&shape, {{0, 0}, {10, 0}, {10, 10}, {0, 10}});
+	add_ring(&shape, {{3, 3}, {3, 7}, {7, 7}, {7, 3}});
+	return shape;
+}
+
+}
+
+TEST(triangulation, ear_clipping) {
+	std::vector<glm::fvec2> square = {{0, 0}, {0, 4}, {4, 4}, {4, 0}};
+	std::vector<std::uint32_t> result;
+	ASSERT_TRUE(glmp::triangulate_ear_clipping(square.data(), square.size(), &result));
+	ASSERT_EQ(result.size(), 6);
+	ASSERT_DOUBLE_EQ(triangles_area(square, result), 16.0);
+
+	std::vector<glm::fvec2> comb = {{0, 0}, {6, 0}, {6, 4}, {5, 4}, {5, 1}, {4, 1}, {4, 4}, {3, 4}, {3, 1}, {2, 1}, {2, 4}, {0, 4}};
+	ASSERT_TRUE(glmp::triangulate_ear_clipping(comb.data(), comb.size(), &result));
+	ASSERT_EQ(result.size(), 3 * (comb.size() - 2));
+	ASSERT_DOUBLE_EQ(triangles_area(comb, result), signed_area(comb.data(), comb.size()));
+
+	// Collinear vertices are kept, but spikes without area are skipped.
+	std::vector<glm::fvec2> collinear = {{0, 0}, {2, 0}, {4, 0}, {4, 4}, {0, 4}};
+	ASSERT_TRUE(glmp::triangulate_ear_clipping(collinear.data(), collinear.size(), &result));
+	ASSERT_EQ(result.size(), 9);
+	ASSERT_DOUBLE_EQ(triangles_area(collinear, result), 16.0);
+
+	std::vector<glm::fvec2> spike = {{0, 0}, {4, 0}, {4, 2}, {6, 2}, {4, 2}, {4, 4}, {0, 4}};
+	ASSERT_TRUE(glmp::triangulate_ear_clipping(spike.data(), spike.size(), &result));
+	ASSERT_DOUBLE_EQ(triangles_area(spike, result), 16.0);
+}
+
+TEST(triangulation, delaunay_hole) {
+	glmp::polygon_list shape = square_with_hole();
+	std::vector<std::uint32_t> result;
+	ASSERT_TRUE(glmp::triangulate_delaunay(shape, &result));
+	ASSERT_EQ(result.size(), 3 * 8);
+	ASSERT_DOUBLE_EQ(triangles_area(shape.vertices, result), 84.0);
+
+	// Same through the dispatching function, which can not use ear clipping for holes.
+	std::vector<std::uint32_t> dispatched;
+	ASSERT_TRUE(glmp::triangulate(shape, &dispatched));
+	ASSERT_EQ(dispatched, result);
+}
+
+TEST(triangulation, delaunay_degenerate) {
+	// Vertex lying on an edge of the hole, and a duplicate vertex.
+	glmp::polygon_list shape;
+	shape.clear();
+	add_ring(&shape, {{0, 0}, {10, 0}, {10, 10}, {5, 10}, {0, 10}});
+	add_ring(&shape, {{2, 2}, {2, 5}, {2, 8}, {8, 8}, {8, 2}, {8, 2}});
+	std::vector<std::uint32_t> result;
+	ASSERT_TRUE(glmp::triangulate_delaunay(shape, &result));
+	ASSERT_DOUBLE_EQ(triangles_area(shape.vertices, result), 64.0);
+	for (std::uint32_t i : result)
+		ASSERT_NE(i, 10u);
+
+	// Polygon with no area.
+	glmp::polygon_list flat;
+	flat.clear();
+	add_ring(&flat, {{0, 0}, {5, 0}, {10, 0}});
+	ASSERT_TRUE(glmp::triangulate_delaunay(flat, &result));
+	ASSERT_TRUE(result.empty());
+
+	glmp::polygon_list bowtie;
+	bowtie.clear();
+	add_ring(&bowtie, {{0, 0}, {4, 4}, {4, 0}, {0, 4}});
+	ASSERT_FALSE(glmp::triangulate_delaunay(bowtie, &result));
+	ASSERT_TRUE(result.empty());
+}
+
+TEST(triangulation, delaunay_large) {
+	glmp::polygon_list shape;
+	shape.clear();
+	add_ring(&shape, star(glm::fvec2(0.0f, 0.0f), 100.0f, 5000, false));
+	add_ring(&shape, star(glm::fvec2(-30.0f, 0.0f), 10.0f, 300, true));
+	add_ring(&shape, star(glm::fvec2(30.0f, 0.0f), 10.0f, 300, false));
+	std::vector<std::uint32_t> result;
+	glmp::arena scratch(1 << 20);
+	ASSERT_TRUE(glmp::triangulate_delaunay(shape, &result, &scratch));
+	ASSERT_EQ(result.size(), 3 * (shape.vertices.size() + 2 * 2 - 2));
+	ASSERT_NEAR(triangles_area(shape.vertices, result), shape_area(shape), 1.0e-3);
+
+	// Every edge, which is not a polygon edge, is shared by two triangles and is locally Delaunay.
+	std::map<std::pair<std::uint32_t, std::uint32_t>, std::uint32_t> opposite;
+	for (std::size_t i = 0; i < result.size(); i += 3) {
+		for (std::size_t k = 0; k < 3; ++k)
+			opposite[{result[i + k], result[i + (k + 1) % 3]}] = result[i + (k + 2) % 3];
+	}
+	for (std::size_t r = 0; r < shape.size(); ++r) {
+		std::size_t first = shape.offsets[r];
+		std::size_t n = shape.offsets[r + 1] - first;
+		for (std::size_t i = 0; i < n; ++i) {
+			auto a = static_cast<std::uint32_t>(first + i);
+			auto b = static_cast<std::uint32_t>(first + (i + 1) % n);
+			ASSERT_TRUE(opposite.count({a, b}) + opposite.count({b, a}) == 1);
+		}
+	}
+	const auto& v = shape.vertices;
+	for (const auto& e : opposite) {
+		auto twin = opposite.find({e.first.second, e.first.first});
+		if (twin == opposite.end())
+			continue;
+		ASSERT_LE(glmp::incircle(v[e.first.first], v[e.first.second], v[e.second], v[twin->second]), 0.0);
+	}
+}
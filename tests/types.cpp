@@ -4,6 +4,8 @@
 
 #include "glm_plus/types.h"
 
+#include <type_traits>
+
 #include "gtest/gtest.h"
 #include "assertions.h"
 
@@ -100,3 +102,75 @@ TEST(types, box_conversion_overloads) {
 	ASSERT_RECT_EQ(r, 1.0f, 2.0f, 4.0f, 8.0f);
 	ASSERT_AREA_EQ(a, 1.0f, 2.0f, 5.0f, 10.0f);
 }
+
+TEST(types, area_overlaps_contains) {
+	constexpr glmp::iarea a(glmp::ipos(0, 0), glmp::ipos(10, 10));
+	constexpr glmp::iarea b(glmp::ipos(5, 5), glmp::ipos(15, 15));
+	constexpr glmp::iarea c(glmp::ipos(10, 0), glmp::ipos(20, 10));
+	constexpr glmp::iarea d(glmp::ipos(11, 0), glmp::ipos(20, 10));
+	constexpr glmp::iarea e(glmp::ipos(2, 3), glmp::ipos(4, 5));
+	static_assert(glmp::overlaps(a, b), "");
+	static_assert(glmp::overlaps(a, c), "");
+	static_assert(!glmp::overlaps(a, d), "");
+	static_assert(glmp::contains(a, e), "");
+	static_assert(glmp::contains(a, a), "");
+	static_assert(!glmp::contains(a, b), "");
+	static_assert(!glmp::contains(e, a), "");
+	static_assert(glmp::is_empty(glmp::intersect(a, d)), "");
+	static_assert(!glmp::is_empty(glmp::intersect(a, c)), "");
+
+	glmp::frect r1(glmp::fpos(0.0f, 0.0f), glmp::fsize(2.0f, 2.0f));
+	glmp::frect r2(glmp::fpos(1.0f, 1.0f), glmp::fsize(2.0f, 2.0f));
+	glmp::fbox b1(glmp::fpos(0.0f, 0.0f), glmp::fpos(1.0f, 1.0f));
+	glmp::fbox b2(glmp::fpos(2.0f, 2.0f), glmp::fpos(3.0f, 3.0f));
+	ASSERT_TRUE(glmp::overlaps(r1, r2));
+	ASSERT_FALSE(glmp::contains(r1, r2));
+	ASSERT_FALSE(glmp::overlaps(b1, b2));
+	ASSERT_TRUE(glmp::contains(glmp::fbox(glmp::fsize(5.0f)), b2));
+}
+
+TEST(types, area_intersect_unite_expand) {
+	constexpr glmp::iarea a(glmp::ipos(0, 0), glmp::ipos(10, 10));
+	constexpr glmp::iarea b(glmp::ipos(5, -5), glmp::ipos(15, 8));
+	constexpr glmp::iarea i = glmp::intersect(a, b);
+	constexpr glmp::iarea u = glmp::unite(a, b);
+	static_assert(i.topleft.x == 5 && i.topleft.y == 0 && i.bottomright.x == 10 && i.bottomright.y == 8, "");
+	static_assert(u.topleft.x == 0 && u.topleft.y == -5 && u.bottomright.x == 15 && u.bottomright.y == 10, "");
+
+	glmp::farea e1 = glmp::expand(glmp::farea(glmp::fpos(1.0f, 2.0f), glmp::fpos(3.0f, 4.0f)), glm::fvec2(-1.0f, 6.0f));
+	glmp::farea e2 = glmp::expand(glmp::farea(glmp::fpos(1.0f, 2.0f), glmp::fpos(3.0f, 4.0f)), 0.5f);
+	ASSERT_AREA_EQ(e1, -1.0f, 2.0f, 3.0f, 6.0f);
+	ASSERT_AREA_EQ(e2, 0.5f, 1.5f, 3.5f, 4.5f);
+
+	glmp::frect r = glmp::intersect(glmp::frect(glmp::fpos(0.0f, 0.0f), glmp::fsize(4.0f, 4.0f)),
+		glmp::frect(glmp::fpos(1.0f, 2.0f), glmp::fsize(4.0f, 4.0f)));
+	ASSERT_RECT_EQ(r, 1.0f, 2.0f, 3.0f, 2.0f);
+	glmp::fbox fb = glmp::unite(glmp::fbox(glmp::fpos(0.0f, 0.0f), glmp::fpos(1.0f, 1.0f)),
+		glmp::fbox(glmp::fpos(2.0f, -1.0f), glmp::fpos(3.0f, 0.0f)));
+	ASSERT_BOX_EQ(fb, 0.0f, -1.0f, 3.0f, 1.0f);
+}
+
+TEST(types, aabb_layout_conversions) {
+	static_assert(sizeof(glmp::faabb) == 16 && alignof(glmp::faabb) == 16, "");
+	static_assert(sizeof(glmp::iaabb) == 16 && alignof(glmp::iaabb) == 16, "");
+	static_assert(std::is_trivially_copyable<glmp::faabb>::value, "");
+
+	constexpr glmp::iaabb b(glmp::ipos(1, 2), glmp::ipos(5, 10));
+	constexpr glmp::iarea a = b;
+	static_assert(a.topleft.x == 1 && a.topleft.y == 2 && a.bottomright.x == 5 && a.bottomright.y == 10, "");
+	constexpr glmp::irect r(b);
+	static_assert(r.size.x == 4 && r.size.y == 8, "");
+	static_assert(glmp::iaabb(r).max.y == 10, "");
+	static_assert(glmp::overlaps(b, glmp::iaabb(glmp::ipos(5, 10), glmp::ipos(6, 11))), "");
+	static_assert(glmp::inside_rect(glm::ivec2(3, 3), b), "");
+
+	glmp::fbox fb(glmp::fpos(1.0f, 2.0f), glmp::fpos(5.0f, 10.0f));
+	glmp::faabb fa(fb);
+	ASSERT_VEC2_EQ(fa.min, 1.0f, 2.0f);
+	ASSERT_VEC2_EQ(fa.max, 5.0f, 10.0f);
+	glmp::fbox back(fa);
+	ASSERT_BOX_EQ(back, 1.0f, 2.0f, 5.0f, 10.0f);
+	glmp::faabb u = glmp::unite(fa, glmp::expand(fa, glm::fvec2(-1.0f, 0.0f)));
+	ASSERT_VEC2_EQ(u.min, -1.0f, 0.0f);
+	ASSERT_VEC2_EQ(u.max, 5.0f, 10.0f);
+}
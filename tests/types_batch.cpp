@@ -0,0 +1,100 @@
+/* SPDX-FileCopyrightText: 2024 Podpečan Rok <podpecanrok111@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "glm_plus/types_batch.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace glmp = glm_plus;
+
+namespace {
+
+glmp::ibox_soa make_areas(std::size_t count, int seed) {
+	glmp::ibox_soa list;
+	for (std::size_t i = 0; i < count; ++i) {
+		int x = static_cast<int>((i * 7 + seed) % 23);
+		int y = static_cast<int>((i * 11 + seed) % 19);
+		int w = static_cast<int>((i + seed) % 6);
+		int h = static_cast<int>((i * 3 + seed) % 5);
+		list.push_back(glmp::iaabb(glmp::ipos(x, y), glmp::ipos(x + w, y + h)));
+	}
+	return list;
+}
+
+}
+
+TEST(types_batch, inside_rect) {
+	glmp::farea area(glmp::fpos(1.0f, 2.0f), glmp::fpos(3.0f, 6.0f));
+	std::vector<float> xs;
+	std::vector<float> ys;
+	for (int i = 0; i < 70; ++i) {
+		xs.push_back(static_cast<float>(i % 5));
+		ys.push_back(static_cast<float>(i % 9));
+	}
+
+	std::vector<std::uint32_t> mask(glmp::mask_words(xs.size()), 0xffffffffu);
+	glmp::inside_rect(xs.data(), ys.data(), xs.size(), area, mask.data());
+	for (std::size_t i = 0; i < xs.size(); ++i)
+		ASSERT_EQ(glmp::mask_test(mask.data(), i), glmp::inside_rect(glm::fvec2(xs[i], ys[i]), area));
+	ASSERT_EQ(mask[2] >> 6, 0u);
+
+	glmp::iarea iarea(glmp::ipos(1, 2), glmp::ipos(3, 6));
+	std::vector<int> ixs(xs.begin(), xs.end());
+	std::vector<int> iys(ys.begin(), ys.end());
+	std::vector<std::uint32_t> imask(mask.size(), 0xffffffffu);
+	glmp::inside_rect(ixs.data(), iys.data(), ixs.size(), iarea, imask.data());
+	ASSERT_EQ(imask, mask);
+}
+
+TEST(types_batch, overlaps_contains) {
+	glmp::iarea area(glmp::ipos(5, 4), glmp::ipos(14, 12));
+	glmp::ibox_soa list = make_areas(100, 3);
+	std::vector<std::uint32_t> overlap_mask(glmp::mask_words(list.size()), 0xffffffffu);
+	std::vector<std::uint32_t> contain_mask(glmp::mask_words(list.size()), 0xffffffffu);
+	glmp::overlaps(list.min_x.data(), list.min_y.data(), list.max_x.data(), list.max_y.data(), list.size(), area, overlap_mask.data());
+	glmp::contains(area, list.min_x.data(), list.min_y.data(), list.max_x.data(), list.max_y.data(), list.size(), contain_mask.data());
+	for (std::size_t i = 0; i < list.size(); ++i) {
+		ASSERT_EQ(glmp::mask_test(overlap_mask.data(), i), glmp::overlaps(glmp::iarea(list[i]), area));
+		ASSERT_EQ(glmp::mask_test(contain_mask.data(), i), glmp::contains(area, glmp::iarea(list[i])));
+	}
+	ASSERT_EQ(overlap_mask[3] >> 4, 0u);
+	ASSERT_EQ(contain_mask[3] >> 4, 0u);
+
+	std::vector<std::uint32_t> soa_mask(overlap_mask.size());
+	glmp::overlaps(list, area, soa_mask.data());
+	ASSERT_EQ(soa_mask, overlap_mask);
+	glmp::contains(area, list, soa_mask.data());
+	ASSERT_EQ(soa_mask, contain_mask);
+
+	std::vector<float> fx1s(list.min_x.begin(), list.min_x.end());
+	std::vector<float> fy1s(list.min_y.begin(), list.min_y.end());
+	std::vector<float> fx2s(list.max_x.begin(), list.max_x.end());
+	std::vector<float> fy2s(list.max_y.begin(), list.max_y.end());
+	glmp::farea farea(glmp::fpos(5.0f, 4.0f), glmp::fpos(14.0f, 12.0f));
+	std::vector<std::uint32_t> fmask(overlap_mask.size());
+	glmp::overlaps(fx1s.data(), fy1s.data(), fx2s.data(), fy2s.data(), list.size(), farea, fmask.data());
+	ASSERT_EQ(fmask, overlap_mask);
+	glmp::contains(farea, fx1s.data(), fy1s.data(), fx2s.data(), fy2s.data(), list.size(), fmask.data());
+	ASSERT_EQ(fmask, contain_mask);
+}
+
+TEST(types_batch, overlaps_pairwise) {
+	glmp::ibox_soa a = make_areas(20, 1);
+	glmp::ibox_soa b = make_areas(45, 8);
+	std::size_t row_words = glmp::mask_words(b.size());
+	std::vector<std::uint32_t> matrix(a.size() * row_words, 0xffffffffu);
+	glmp::overlaps(a.min_x.data(), a.min_y.data(), a.max_x.data(), a.max_y.data(), a.size(),
+		b.min_x.data(), b.min_y.data(), b.max_x.data(), b.max_y.data(), b.size(), matrix.data());
+	for (std::size_t i = 0; i < a.size(); ++i) {
+		for (std::size_t j = 0; j < b.size(); ++j)
+			ASSERT_EQ(glmp::mask_test(matrix.data() + i * row_words, j), glmp::overlaps(a[i], b[j]));
+		ASSERT_EQ(matrix[i * row_words + 1] >> 13, 0u);
+	}
+
+	std::vector<std::uint32_t> from_soa(matrix.size());
+	glmp::overlaps(a, b, from_soa.data());
+	ASSERT_EQ(from_soa, matrix);
+}